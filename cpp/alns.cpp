@@ -0,0 +1,652 @@
+#include "alns.h"
+#include "heuristic.h"
+#include "berth_sequencing.h"
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+enum DestroyOp { DestroyRandom, DestroyWorst, DestroyRelated, DestroyBerthWindow, DestroyYardWindow, NumDestroy };
+enum RepairOp { RepairGreedy, RepairGreedyRandom, RepairRegret, NumRepair };
+
+const char* const kDestroyNames[NumDestroy] = { "random", "worst", "related", "berth-window", "yard-window" };
+const char* const kRepairNames[NumRepair] = { "greedy", "greedy-random", "regret-2" };
+
+// 自适应权重的得分（Ropke & Pisinger）
+const double kScoreGlobalBest = 33, kScoreImproved = 9, kScoreAccepted = 13;
+
+// 各线程共享的只读数据
+struct Problem {
+    const ModelParams* params;
+    int S, K, B, R, V;
+    vector<double> proc;   // [s*B + b] 船舶 s 在泊位 b 的卸载时长
+    double penalty;
+
+    double procTime(int s, int b) const { return proc[s * B + b]; }
+};
+
+// 一艘船在某个泊位的堆场放置：每个货舱的 (行, 起点) 与成本
+struct YardPlan {
+    bool feasible = false;
+    vector<int> row, start;
+    vector<double> cost;
+    double total = 0.0;
+};
+
+// 搜索状态：泊位顺序 + 堆场块，开始时间由顺序推出
+struct State {
+    vector<vector<int>> seq;          // [b] 泊位上的船舶顺序
+    vector<int> berth;                // [s]，-1 表示已移除
+    vector<double> e;                 // [s]
+    vector<int> blockRow, blockStart; // [s*K + k]，-1 表示未放置
+    vector<double> blockCost;         // [s*K + k] 转运 + 存储（未乘 alpha）
+    vector<char> occupied;            // [r*V + v]
+    vector<int> owner;                // [r*V + v] -> s，-1 表示空闲
+    vector<double> berthTime;         // [b] sum (e_s - 到达 + 卸载时长)
+    vector<double> berthOver;         // [b] sum max(0, e_s - 规划期)
+};
+
+double objective(const Problem& pr, const State& st) {
+    double yard = 0.0, time = 0.0, over = 0.0;
+    for (size_t i = 0; i < st.blockCost.size(); ++i) yard += st.blockCost[i];
+    for (int b = 0; b < pr.B; ++b) { time += st.berthTime[b]; over += st.berthOver[b]; }
+    return pr.params->alpha * yard + pr.params->beta * time + pr.penalty * over;
+}
+
+// 船舶 s 对目标值的贡献（worst 破坏算子用）
+double shipContribution(const Problem& pr, const State& st, int s) {
+    const ModelParams& p = *pr.params;
+    double yard = 0.0;
+    for (int k = 0; k < pr.K; ++k) yard += st.blockCost[s * pr.K + k];
+    double c = p.alpha * yard;
+    if (st.berth[s] >= 0) {
+        c += p.beta * (st.e[s] - p.arrivalTime[s] + pr.procTime(s, st.berth[s]));
+        c += pr.penalty * max(0.0, st.e[s] - p.planningHorizon);
+    }
+    return c;
+}
+
+// 按顺序重新推出泊位 b 上各船的开始时间
+void refreshBerth(const Problem& pr, State& st, int b) {
+    const ModelParams& p = *pr.params;
+    double t = 0.0, time = 0.0, over = 0.0;
+    for (size_t i = 0; i < st.seq[b].size(); ++i) {
+        int s = st.seq[b][i];
+        st.e[s] = max(p.arrivalTime[s], t);
+        t = st.e[s] + pr.procTime(s, b);
+        time += t - p.arrivalTime[s];
+        over += max(0.0, st.e[s] - p.planningHorizon);
+    }
+    st.berthTime[b] = time;
+    st.berthOver[b] = over;
+}
+
+// 用单泊位精确排序（berth_sequencing.h）重排各泊位的顺序，只在该泊位的靠泊时间与超期惩罚之和下降时采用
+void sequenceState(const Problem& pr, State& st) {
+    const ModelParams& p = *pr.params;
+    for (int b = 0; b < pr.B; ++b) {
+        const vector<int> current = st.seq[b];
+        if (current.size() < 2) continue;
+        vector<BerthJob> jobs(current.size());
+        vector<int> hint(current.size());
+        for (size_t i = 0; i < current.size(); ++i) {
+            jobs[i].ship = current[i];
+            jobs[i].release = p.arrivalTime[current[i]];
+            jobs[i].processing = pr.procTime(current[i], b);
+            jobs[i].latestStart = p.planningHorizon;
+            hint[i] = static_cast<int>(i);
+        }
+        BerthSequence seq;
+        if (!sequenceBerth(jobs, seq, &hint) || seq.order == current) continue;
+        const double before = p.beta * st.berthTime[b] + pr.penalty * st.berthOver[b];
+        st.seq[b] = seq.order;
+        refreshBerth(pr, st, b);
+        if (p.beta * st.berthTime[b] + pr.penalty * st.berthOver[b] >= before) {
+            st.seq[b] = current;
+            refreshBerth(pr, st, b);
+        }
+    }
+}
+
+// 把 s 插到泊位 b 顺序的 pos 处时，靠泊时间与超期量的增量（不修改状态）
+// 插入只会推迟后续船舶，某艘船开始时间不变时其后都不变
+void insertionTimeDelta(const Problem& pr, const State& st, int s, int b, size_t pos,
+                        double& dTime, double& dOver) {
+    const ModelParams& p = *pr.params;
+    const vector<int>& q = st.seq[b];
+    double t = 0.0;
+    if (pos > 0) t = st.e[q[pos - 1]] + pr.procTime(q[pos - 1], b);
+    double start = max(p.arrivalTime[s], t);
+    t = start + pr.procTime(s, b);
+    dTime = t - p.arrivalTime[s];
+    dOver = max(0.0, start - p.planningHorizon);
+    for (size_t i = pos; i < q.size(); ++i) {
+        int u = q[i];
+        double ns = max(p.arrivalTime[u], t);
+        if (ns <= st.e[u]) break;
+        dTime += ns - st.e[u];
+        dOver += max(0.0, ns - p.planningHorizon) - max(0.0, st.e[u] - p.planningHorizon);
+        t = ns + pr.procTime(u, b);
+    }
+}
+
+// 在当前空闲槽中为船舶 s（停靠泊位 b）的各货舱依次取成本最低的连续段
+YardPlan planYard(const Problem& pr, State& st, int s, int b) {
+    const ModelParams& p = *pr.params;
+    YardPlan plan;
+    plan.row.assign(pr.K, -1);
+    plan.start.assign(pr.K, -1);
+    plan.cost.assign(pr.K, 0.0);
+    plan.feasible = true;
+    for (int k = 0; k < pr.K && plan.feasible; ++k) {
+        const int n = p.requiredSlots[s][k];
+        if (n <= 0) continue;
+        plan.feasible = cheapestFreeBlock(p, st.occupied, s, k, b, plan.row[k], plan.start[k], plan.cost[k]);
+        if (!plan.feasible) break;
+        plan.total += plan.cost[k];
+        // 同一艘船的后续货舱不能再用这些槽
+        for (int v = plan.start[k]; v < plan.start[k] + n; ++v) st.occupied[plan.row[k] * pr.V + v] = 1;
+    }
+    for (int k = 0; k < pr.K; ++k) {
+        if (plan.row[k] < 0) continue;
+        for (int v = plan.start[k]; v < plan.start[k] + p.requiredSlots[s][k]; ++v) st.occupied[plan.row[k] * pr.V + v] = 0;
+    }
+    return plan;
+}
+
+// plan 使用的槽是否与状态中已占用的槽冲突（缓存的放置是否仍然可用）
+bool planStillFree(const Problem& pr, const State& st, int s, const YardPlan& plan) {
+    for (int k = 0; k < pr.K; ++k) {
+        if (plan.row[k] < 0) continue;
+        for (int v = plan.start[k]; v < plan.start[k] + pr.params->requiredSlots[s][k]; ++v) {
+            if (st.occupied[plan.row[k] * pr.V + v]) return false;
+        }
+    }
+    return true;
+}
+
+void removeShip(const Problem& pr, State& st, int s) {
+    int b = st.berth[s];
+    if (b < 0) return;
+    st.seq[b].erase(find(st.seq[b].begin(), st.seq[b].end(), s));
+    st.berth[s] = -1;
+    refreshBerth(pr, st, b);
+    for (int k = 0; k < pr.K; ++k) {
+        const int i = s * pr.K + k;
+        if (st.blockRow[i] < 0) continue;
+        for (int v = st.blockStart[i]; v < st.blockStart[i] + pr.params->requiredSlots[s][k]; ++v) {
+            st.occupied[st.blockRow[i] * pr.V + v] = 0;
+            st.owner[st.blockRow[i] * pr.V + v] = -1;
+        }
+        st.blockRow[i] = st.blockStart[i] = -1;
+        st.blockCost[i] = 0.0;
+    }
+}
+
+void insertShip(const Problem& pr, State& st, int s, int b, size_t pos, const YardPlan& plan) {
+    st.seq[b].insert(st.seq[b].begin() + pos, s);
+    st.berth[s] = b;
+    refreshBerth(pr, st, b);
+    for (int k = 0; k < pr.K; ++k) {
+        const int i = s * pr.K + k;
+        st.blockRow[i] = plan.row[k];
+        st.blockStart[i] = plan.start[k];
+        st.blockCost[i] = plan.cost[k];
+        if (plan.row[k] < 0) continue;
+        for (int v = plan.start[k]; v < plan.start[k] + pr.params->requiredSlots[s][k]; ++v) {
+            st.occupied[plan.row[k] * pr.V + v] = 1;
+            st.owner[plan.row[k] * pr.V + v] = s;
+        }
+    }
+}
+
+// 船舶 s 在泊位 b 上的最优插入位置
+struct Insertion {
+    bool feasible = false;
+    int berth = -1;
+    size_t pos = 0;
+    double cost = numeric_limits<double>::infinity();
+};
+
+Insertion bestPosition(const Problem& pr, const State& st, int s, int b, const YardPlan& plan) {
+    Insertion ins;
+    if (!plan.feasible) return ins;
+    const ModelParams& p = *pr.params;
+    for (size_t pos = 0; pos <= st.seq[b].size(); ++pos) {
+        double dTime, dOver;
+        insertionTimeDelta(pr, st, s, b, pos, dTime, dOver);
+        double c = p.alpha * plan.total + p.beta * dTime + pr.penalty * dOver;
+        if (c < ins.cost) { ins.feasible = true; ins.berth = b; ins.pos = pos; ins.cost = c; }
+    }
+    return ins;
+}
+
+// 逐艘插入：每艘船取所有泊位、所有位置中增量最小的插入
+bool repairGreedy(const Problem& pr, State& st, const vector<int>& ships) {
+    for (size_t i = 0; i < ships.size(); ++i) {
+        int s = ships[i];
+        Insertion best;
+        YardPlan bestPlan;
+        for (int b = 0; b < pr.B; ++b) {
+            YardPlan plan = planYard(pr, st, s, b);
+            Insertion ins = bestPosition(pr, st, s, b, plan);
+            if (ins.feasible && ins.cost < best.cost) { best = ins; bestPlan = plan; }
+        }
+        if (!best.feasible) return false;
+        insertShip(pr, st, s, best.berth, best.pos, bestPlan);
+    }
+    return true;
+}
+
+// regret-2：每轮插入最优与次优泊位代价之差最大的船；各 (船, 泊位) 的堆场放置缓存，
+// 只有与新占用槽冲突时才重新计算
+bool repairRegret(const Problem& pr, State& st, vector<int> ships) {
+    vector<vector<YardPlan>> plans(ships.size(), vector<YardPlan>(pr.B));
+    for (size_t i = 0; i < ships.size(); ++i) {
+        for (int b = 0; b < pr.B; ++b) plans[i][b] = planYard(pr, st, ships[i], b);
+    }
+    while (!ships.empty()) {
+        size_t pick = 0;
+        Insertion pickIns;
+        double pickRegret = -1.0;
+        for (size_t i = 0; i < ships.size(); ++i) {
+            Insertion best, second;
+            for (int b = 0; b < pr.B; ++b) {
+                Insertion ins = bestPosition(pr, st, ships[i], b, plans[i][b]);
+                if (!ins.feasible) continue;
+                if (ins.cost < best.cost) { second = best; best = ins; }
+                else if (ins.cost < second.cost) second = ins;
+            }
+            if (!best.feasible) return false;
+            double regret = second.feasible ? second.cost - best.cost : numeric_limits<double>::max();
+            if (regret > pickRegret || (regret == pickRegret && best.cost < pickIns.cost)) {
+                pick = i; pickIns = best; pickRegret = regret;
+            }
+        }
+        int s = ships[pick];
+        insertShip(pr, st, s, pickIns.berth, pickIns.pos, plans[pick][pickIns.berth]);
+        ships.erase(ships.begin() + pick);
+        plans.erase(plans.begin() + pick);
+        for (size_t i = 0; i < ships.size(); ++i) {
+            for (int b = 0; b < pr.B; ++b) {
+                if (plans[i][b].feasible && !planStillFree(pr, st, ships[i], plans[i][b])) {
+                    plans[i][b] = planYard(pr, st, ships[i], b);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 从排好序的候选中按 u^power 偏向前面地随机抽取（Ropke & Pisinger 的随机化）
+int biasedIndex(mt19937& rng, size_t n, double power) {
+    double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+    return min(static_cast<int>(pow(u, power) * n), static_cast<int>(n) - 1);
+}
+
+vector<int> destroy(const Problem& pr, const State& st, int op, int q, mt19937& rng) {
+    const ModelParams& p = *pr.params;
+    vector<int> removed;
+    vector<char> taken(pr.S, 0);
+    auto take = [&](int s) { if (!taken[s]) { taken[s] = 1; removed.push_back(s); } };
+
+    switch (op) {
+    case DestroyRandom: {
+        vector<int> all(pr.S);
+        for (int s = 0; s < pr.S; ++s) all[s] = s;
+        shuffle(all.begin(), all.end(), rng);
+        for (int i = 0; i < q; ++i) take(all[i]);
+        break;
+    }
+    case DestroyWorst: {
+        vector<pair<double,int>> c(pr.S);
+        for (int s = 0; s < pr.S; ++s) c[s] = make_pair(-shipContribution(pr, st, s), s);
+        sort(c.begin(), c.end());
+        while (static_cast<int>(removed.size()) < q) {
+            int i = biasedIndex(rng, c.size(), 3.0);
+            take(c[i].second);
+            c.erase(c.begin() + i);
+        }
+        break;
+    }
+    case DestroyRelated: {
+        // 与随机种子船的到达时间与开始时间越接近越相关，同泊位更相关
+        int seed = uniform_int_distribution<int>(0, pr.S - 1)(rng);
+        double scale = max(p.planningHorizon, 1.0);
+        vector<pair<double,int>> c;
+        for (int s = 0; s < pr.S; ++s) {
+            if (s == seed) continue;
+            double d = (fabs(p.arrivalTime[s] - p.arrivalTime[seed]) + fabs(st.e[s] - st.e[seed])) / scale;
+            if (st.berth[s] != st.berth[seed]) d += 0.1;
+            c.push_back(make_pair(d, s));
+        }
+        sort(c.begin(), c.end());
+        take(seed);
+        while (static_cast<int>(removed.size()) < q && !c.empty()) {
+            int i = biasedIndex(rng, c.size(), 6.0);
+            take(c[i].second);
+            c.erase(c.begin() + i);
+        }
+        break;
+    }
+    case DestroyBerthWindow: {
+        vector<int> busy;
+        for (int b = 0; b < pr.B; ++b) if (!st.seq[b].empty()) busy.push_back(b);
+        const vector<int>& s0 = st.seq[busy[uniform_int_distribution<int>(0, busy.size() - 1)(rng)]];
+        int len = min(q, static_cast<int>(s0.size()));
+        int first = uniform_int_distribution<int>(0, s0.size() - len)(rng);
+        for (int i = first; i < first + len; ++i) take(s0[i]);
+        break;
+    }
+    case DestroyYardWindow: {
+        // 从随机槽开始沿行扫描，移除遇到的货舱所属的船
+        int total = pr.R * pr.V;
+        int from = uniform_int_distribution<int>(0, total - 1)(rng);
+        for (int i = 0; i < total && static_cast<int>(removed.size()) < q; ++i) {
+            int s = st.owner[(from + i) % total];
+            if (s >= 0) take(s);
+        }
+        break;
+    }
+    }
+    // 堆场很空或泊位窗口较短时用随机船补足
+    while (static_cast<int>(removed.size()) < q) take(uniform_int_distribution<int>(0, pr.S - 1)(rng));
+    return removed;
+}
+
+bool repair(const Problem& pr, State& st, int op, vector<int> ships, mt19937& rng) {
+    switch (op) {
+    case RepairGreedy:
+        sort(ships.begin(), ships.end(), [&](int a, int b) {
+            return pr.params->arrivalTime[a] < pr.params->arrivalTime[b] || (pr.params->arrivalTime[a] == pr.params->arrivalTime[b] && a < b);
+        });
+        return repairGreedy(pr, st, ships);
+    case RepairGreedyRandom:
+        shuffle(ships.begin(), ships.end(), rng);
+        return repairGreedy(pr, st, ships);
+    default:
+        return repairRegret(pr, st, ships);
+    }
+}
+
+int roulette(const vector<double>& w, mt19937& rng) {
+    double total = 0.0;
+    for (size_t i = 0; i < w.size(); ++i) total += w[i];
+    double u = uniform_real_distribution<double>(0.0, total)(rng);
+    for (size_t i = 0; i < w.size(); ++i) {
+        if (u < w[i]) return static_cast<int>(i);
+        u -= w[i];
+    }
+    return static_cast<int>(w.size()) - 1;
+}
+
+State stateFromSolution(const Problem& pr, const PortSolution& sol) {
+    const ModelParams& p = *pr.params;
+    State st;
+    st.seq.assign(pr.B, vector<int>());
+    st.berth = sol.berth;
+    st.e = sol.e;
+    st.blockRow.assign(pr.S * pr.K, -1);
+    st.blockStart.assign(pr.S * pr.K, -1);
+    st.blockCost.assign(pr.S * pr.K, 0.0);
+    st.occupied.assign(pr.R * pr.V, 0);
+    st.owner.assign(pr.R * pr.V, -1);
+    st.berthTime.assign(pr.B, 0.0);
+    st.berthOver.assign(pr.B, 0.0);
+    for (int s = 0; s < pr.S; ++s) st.seq[sol.berth[s]].push_back(s);
+    for (int b = 0; b < pr.B; ++b) {
+        sort(st.seq[b].begin(), st.seq[b].end(), [&](int a, int c) { return sol.e[a] < sol.e[c] || (sol.e[a] == sol.e[c] && a < c); });
+        refreshBerth(pr, st, b);
+    }
+    for (int s = 0; s < pr.S; ++s) {
+        for (int k = 0; k < pr.K; ++k) {
+            const int i = s * pr.K + k, r = sol.row[s][k];
+            const vector<int>& slots = sol.slots[s][k];
+            if (r < 0 || slots.empty()) continue;
+            st.blockRow[i] = r;
+            st.blockStart[i] = slots.front();
+            const int n = static_cast<int>(slots.size());
+            double sumD = 0.0;
+            for (int j = 0; j < n; ++j) {
+                sumD += p.transshipmentCost(sol.berth[s], r, slots[j]);
+                st.occupied[r * pr.V + slots[j]] = 1;
+                st.owner[r * pr.V + slots[j]] = s;
+            }
+            st.blockCost[i] = p.cargoWeight[s] / (static_cast<double>(p.requiredSlots[s][k]) * pr.K) * sumD
+                            + n * p.storageCost(s,k,r);
+        }
+    }
+    return st;
+}
+
+void stateToSolution(const Problem& pr, const State& st, PortSolution& sol) {
+    initSolution(sol, *pr.params);
+    for (int s = 0; s < pr.S; ++s) {
+        sol.berth[s] = st.berth[s];
+        sol.e[s] = st.e[s];
+        setSerialCompartmentTimes(*pr.params, sol, s);
+        for (int k = 0; k < pr.K; ++k) {
+            const int i = s * pr.K + k;
+            if (st.blockRow[i] >= 0) placeBlock(sol, s, k, st.blockRow[i], st.blockStart[i], pr.params->requiredSlots[s][k]);
+        }
+    }
+}
+
+// 线程间共享的全局最优解
+struct SharedBest {
+    mutex lock;
+    State state;
+    double objective;
+    int thread;
+    vector<double> weights;
+    chrono::steady_clock::time_point lastPrint;
+};
+
+} // namespace
+
+bool parseAlnsOption(const string& arg, AlnsOptions& opts) {
+    size_t eq = arg.find('=');
+    string key = arg.substr(0, eq);
+    string val = eq == string::npos ? string() : arg.substr(eq + 1);
+    char* end = 0;
+    if (key == "--threads") {
+        long n = strtol(val.c_str(), &end, 10);
+        if (val.empty() || *end != '\0' || n < 0) { cerr << "无效的线程数: " << val << endl; return false; }
+        opts.threads = static_cast<int>(n);
+        return true;
+    }
+    if (key == "--time-limit") {
+        double t = strtod(val.c_str(), &end);
+        if (val.empty() || *end != '\0' || t <= 0) { cerr << "无效的时间限制: " << val << endl; return false; }
+        opts.timeLimit = t;
+        return true;
+    }
+    if (key == "--iterations") {
+        long n = strtol(val.c_str(), &end, 10);
+        if (val.empty() || *end != '\0' || n < 0) { cerr << "无效的迭代次数: " << val << endl; return false; }
+        opts.maxIterations = n;
+        return true;
+    }
+    if (key == "--seed") {
+        unsigned long n = strtoul(val.c_str(), &end, 10);
+        if (val.empty() || *end != '\0') { cerr << "无效的随机种子: " << val << endl; return false; }
+        opts.seed = static_cast<unsigned>(n);
+        return true;
+    }
+    cerr << "未知参数: " << arg << endl;
+    return false;
+}
+
+bool solveAlns(const ModelParams& params, const AlnsOptions& opts, PortSolution& sol, AlnsReport* report) {
+    auto t0 = chrono::steady_clock::now();
+    auto elapsed = [&]() { return chrono::duration<double>(chrono::steady_clock::now() - t0).count(); };
+
+    PortSolution initial;
+    if (!greedySolution(params, initial)) {
+        cerr << "[ALNS] 贪心启发式未找到初始解" << endl;
+        return false;
+    }
+
+    Problem pr;
+    pr.params = &params;
+    pr.S = params.numShips; pr.K = params.numShipK; pr.B = params.numBerths;
+    pr.R = params.numRows; pr.V = params.numSlotsPerRow;
+    pr.penalty = opts.horizonPenalty;
+    pr.proc.resize(static_cast<size_t>(pr.S) * pr.B);
+    for (int s = 0; s < pr.S; ++s) {
+        for (int b = 0; b < pr.B; ++b) pr.proc[s * pr.B + b] = berthProcessingTime(params, s, b);
+    }
+
+    int threads = opts.threads > 0 ? opts.threads : static_cast<int>(thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    const int maxRemove = min(pr.S, max(opts.minRemove, min(60, static_cast<int>(opts.maxRemoveFraction * pr.S))));
+    const int minRemove = min(opts.minRemove, maxRemove);
+
+    SharedBest shared;
+    shared.state = stateFromSolution(pr, initial);
+    shared.objective = objective(pr, shared.state);
+    shared.thread = -1;
+    shared.weights.assign(NumDestroy + NumRepair, 1.0);
+    shared.lastPrint = chrono::steady_clock::now();
+    const double initialObjective = shared.objective;
+    // 比当前解差 startTemperature 比例的解以 50% 概率被接受
+    const double T0 = max(opts.startTemperature * fabs(initialObjective), 1e-9) / log(2.0);
+    if (opts.verbose) cout << "[ALNS] 初始解(贪心) " << initialObjective << " | 线程 " << threads << endl;
+
+    atomic<long> iterations(0);
+    atomic<bool> stop(false);
+    vector<vector<long>> uses(threads, vector<long>(NumDestroy + NumRepair, 0));
+
+    auto search = [&](int tid) {
+        mt19937 rng(opts.seed + 7919u * tid);
+        State cur, best;
+        {
+            lock_guard<mutex> g(shared.lock);
+            cur = shared.state;
+        }
+        best = cur;
+        double curObj = objective(pr, cur), bestObj = curObj;
+        vector<double> dw(NumDestroy, 1.0), rw(NumRepair, 1.0);
+        vector<double> dScore(NumDestroy, 0.0), rScore(NumRepair, 0.0);
+        vector<long> dUses(NumDestroy, 0), rUses(NumRepair, 0);
+        long local = 0;
+
+        while (!stop) {
+            long it = iterations++;
+            if (opts.maxIterations > 0 && it >= opts.maxIterations) break;
+            double t = elapsed();
+            if (t >= opts.timeLimit) break;
+            double progress = t / opts.timeLimit;
+            if (opts.maxIterations > 0) progress = max(progress, static_cast<double>(it) / opts.maxIterations);
+            const double T = T0 * pow(1e-3, progress);
+
+            int di = roulette(dw, rng), ri = roulette(rw, rng);
+            int q = uniform_int_distribution<int>(minRemove, maxRemove)(rng);
+            State trial = cur;
+            vector<int> removed = destroy(pr, trial, di, q, rng);
+            for (size_t i = 0; i < removed.size(); ++i) removeShip(pr, trial, removed[i]);
+            ++dUses[di]; ++rUses[ri];
+            ++uses[tid][di]; ++uses[tid][NumDestroy + ri];
+
+            double score = 0.0;
+            if (repair(pr, trial, ri, removed, rng)) {
+                double obj = objective(pr, trial);
+                double eps = 1e-9 * max(1.0, fabs(curObj));
+                // 改进当前解的候选再按泊位精确排序
+                if (obj < curObj - eps) {
+                    sequenceState(pr, trial);
+                    obj = objective(pr, trial);
+                }
+                if (obj < bestObj - eps) {
+                    score = kScoreGlobalBest;
+                    best = trial;
+                    bestObj = obj;
+                    cur = std::move(trial);
+                    curObj = obj;
+                    lock_guard<mutex> g(shared.lock);
+                    if (bestObj < shared.objective) {
+                        shared.state = best;
+                        shared.objective = bestObj;
+                        shared.thread = tid;
+                        shared.weights = dw;
+                        shared.weights.insert(shared.weights.end(), rw.begin(), rw.end());
+                        if (opts.verbose && chrono::duration<double>(chrono::steady_clock::now() - shared.lastPrint).count() >= 1.0) {
+                            shared.lastPrint = chrono::steady_clock::now();
+                            cout << "[ALNS] " << t << " s | 迭代 " << it << " | 最优 " << bestObj << endl;
+                        }
+                    }
+                } else if (obj < curObj - eps) {
+                    score = kScoreImproved;
+                    cur = std::move(trial);
+                    curObj = obj;
+                } else if (uniform_real_distribution<double>(0.0, 1.0)(rng) < exp(-(obj - curObj) / T)) {
+                    score = kScoreAccepted;
+                    cur = std::move(trial);
+                    curObj = obj;
+                }
+            }
+            dScore[di] += score;
+            rScore[ri] += score;
+
+            ++local;
+            if (local % opts.segmentLength == 0) {
+                for (int i = 0; i < NumDestroy; ++i) {
+                    if (dUses[i]) dw[i] = max((1 - opts.reaction) * dw[i] + opts.reaction * dScore[i] / dUses[i], 0.05);
+                    dScore[i] = 0; dUses[i] = 0;
+                }
+                for (int i = 0; i < NumRepair; ++i) {
+                    if (rUses[i]) rw[i] = max((1 - opts.reaction) * rw[i] + opts.reaction * rScore[i] / rUses[i], 0.05);
+                    rScore[i] = 0; rUses[i] = 0;
+                }
+            }
+            if (local % opts.syncInterval == 0) {
+                lock_guard<mutex> g(shared.lock);
+                if (shared.objective < bestObj - 1e-9 * max(1.0, fabs(bestObj))) {
+                    cur = shared.state;
+                    best = shared.state;
+                    curObj = bestObj = shared.objective;
+                }
+            }
+        }
+        stop = true;
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < threads; ++t) workers.push_back(thread(search, t));
+    search(0);
+    for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+    stateToSolution(pr, shared.state, sol);
+    AlnsReport rep;
+    rep.threads = threads;
+    rep.iterations = min(iterations.load(), opts.maxIterations > 0 ? opts.maxIterations : iterations.load());
+    rep.initialObjective = initialObjective;
+    rep.bestObjective = weightedObjective(params, evaluateShipCosts(params, sol));
+    for (int s = 0; s < pr.S; ++s) {
+        if (sol.e[s] > params.planningHorizon) ++rep.horizonViolations;
+    }
+    rep.seconds = elapsed();
+    for (int i = 0; i < NumDestroy; ++i) rep.operators.push_back(kDestroyNames[i]);
+    for (int i = 0; i < NumRepair; ++i) rep.operators.push_back(kRepairNames[i]);
+    rep.operatorUses.assign(NumDestroy + NumRepair, 0);
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < NumDestroy + NumRepair; ++i) rep.operatorUses[i] += uses[t][i];
+    }
+    rep.operatorWeights = shared.weights;
+    if (opts.verbose) {
+        cout << "[ALNS] 结束: 迭代 " << rep.iterations << " | 最优 " << rep.bestObjective
+             << " | 耗时 " << rep.seconds << " s" << endl;
+    }
+    if (report) *report = rep;
+    return true;
+}
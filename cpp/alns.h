@@ -0,0 +1,59 @@
+#ifndef ALNS_H
+#define ALNS_H
+
+#include <vector>
+#include <string>
+#include "modelParam.h"
+#include "port_solution.h"
+
+// 自适应大邻域搜索（ALNS），不依赖 CPLEX，用于 MIP 在时限内无法收敛的大算例
+//
+// 解的表示：每个泊位上的船舶顺序 + 每个货舱的堆场块 (行, 起点)。船舶开始时间由顺序推出
+// （e_s = max(到达, 前一艘完工)），货舱串行卸货。目标值与 evaluateShipCosts / weightedObjective
+// 的定义相同；e_s 超过规划期的部分按 horizonPenalty 惩罚（MIP 中是硬约束）。
+// 改进当前解的候选解先按泊位精确排序（berth_sequencing.h），再参与接受判断。
+//
+// 每次迭代按自适应权重各选一个破坏算子与修复算子：
+//   破坏：random（随机船）、worst（目标贡献最大的船）、related（到达时间相近的船）、
+//         berth-window（某泊位顺序中的连续一段）、yard-window（占用某行一段槽的船）
+//   修复：greedy（按到达时间逐艘插入最优泊位/位置，货舱取成本最低的空闲连续段）、
+//         greedy-random（同上，随机顺序）、regret-2（优先插入最优与次优泊位差距最大的船）
+// 接受准则为模拟退火（温度按时间/迭代进度几何下降）；权重每 segmentLength 次迭代按
+// 得分（新全局最优 / 改进当前解 / 接受较差解）更新。
+// 多个搜索线程使用不同随机种子独立搜索，共享全局最优解：每 syncInterval 次迭代，
+// 若全局最优优于本线程最优则从全局最优继续。
+struct AlnsOptions {
+    int threads = 0;                // 搜索线程数，0 表示 hardware_concurrency
+    double timeLimit = 60;          // 秒
+    long maxIterations = 0;         // 所有线程的总迭代数上限，0 表示只受时间限制
+    unsigned seed = 1;
+    int minRemove = 2;              // 每次破坏移除的船舶数下限
+    double maxRemoveFraction = 0.3; // 上限占船舶数的比例（至多 60 艘）
+    int segmentLength = 100;        // 权重更新周期（迭代数）
+    double reaction = 0.1;          // 权重更新的反应系数
+    double startTemperature = 0.02; // 初始温度：比当前解差该比例的解以 50% 概率被接受
+    double horizonPenalty = 1e6;    // e_s 每超出规划期 1 小时的惩罚
+    int syncInterval = 200;         // 与全局最优同步的间隔（迭代数）
+    bool verbose = true;
+};
+
+struct AlnsReport {
+    int threads = 0;
+    long iterations = 0;
+    double initialObjective = 0.0;
+    double bestObjective = 0.0;     // weightedObjective(evaluateShipCosts(best))，不含惩罚
+    int horizonViolations = 0;      // 最优解中开始时间超过规划期的船舶数
+    double seconds = 0.0;
+    std::vector<std::string> operators;   // 破坏算子在前，修复算子在后
+    std::vector<long> operatorUses;       // 所有线程合计
+    std::vector<double> operatorWeights;  // 最优解所在线程结束时的权重
+};
+
+// 从贪心解（heuristic.h）出发搜索，最优解写入 sol
+// 贪心启发式找不到可行的堆场分配时返回 false
+bool solveAlns(const ModelParams& params, const AlnsOptions& opts, PortSolution& sol, AlnsReport* report = 0);
+
+// 解析 alns 的命令行参数（--threads/--time-limit/--iterations/--seed），无法识别时返回 false
+bool parseAlnsOption(const std::string& arg, AlnsOptions& opts);
+
+#endif // ALNS_H
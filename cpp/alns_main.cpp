@@ -0,0 +1,68 @@
+// ALNS 求解器（不依赖 CPLEX，见 alns.h）
+// 用法: ./alns [--threads=N] [--time-limit=秒] [--iterations=N] [--seed=N] baseName [outDir]
+//       baseName 为不带扩展名的算例前缀（如 data/example_L12/params_output），
+//       outDir 默认为 output/alns_<算例目录名>；输出文件与 verify 相同（见 writeSolutionCSV）
+#include <iostream>
+#include <string>
+#include <vector>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "port_solution.h"
+#include "alns.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    AlnsOptions opts;
+    vector<string> positional;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 2, "--") == 0) {
+            if (!parseAlnsOption(arg, opts)) return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.empty() || positional.size() > 2) {
+        cerr << "用法: " << argv[0] << " [--threads=N] [--time-limit=秒] [--iterations=N] [--seed=N] baseName [outDir]" << endl;
+        return 1;
+    }
+    const string base = positional[0];
+    string outDir;
+    if (positional.size() > 1) {
+        outDir = positional[1];
+    } else {
+        // data/example_L12/params_output -> output/alns_example_L12
+        string dir = base.substr(0, base.find_last_of('/'));
+        outDir = "output/alns_" + dir.substr(dir.find_last_of('/') + 1);
+    }
+
+    ModelParams params;
+    if (!loadParamsAuto(base, params)) {
+        cerr << "停止求解: " << base << endl;
+        return 1;
+    }
+
+    PortSolution sol;
+    AlnsReport rep;
+    if (!solveAlns(params, opts, sol, &rep)) return 1;
+
+    cout << "ALNS: 线程 " << rep.threads << ", 迭代 " << rep.iterations << ", 初始 " << rep.initialObjective
+         << ", 最优 " << rep.bestObjective << ", 耗时 " << rep.seconds << " 秒" << endl;
+    cout << "算子（使用次数 / 权重）:";
+    for (size_t i = 0; i < rep.operators.size(); ++i) {
+        cout << " " << rep.operators[i] << " " << rep.operatorUses[i] << "/" << rep.operatorWeights[i];
+    }
+    cout << endl;
+    if (rep.horizonViolations > 0) {
+        cout << "警告: " << rep.horizonViolations << " 艘船的开始时间超过规划期 " << params.planningHorizon << endl;
+    }
+    cout << "目标函数值: " << rep.bestObjective << endl;
+    printSolution(cout, params, sol);
+    if (!writeSolutionCSV(params, sol, outDir)) {
+        cerr << "写输出文件时出错: " << outDir << endl;
+        return 1;
+    }
+    cout << "结果已写入 " << outDir << endl;
+    return rep.horizonViolations > 0 ? 2 : 0;
+}
@@ -0,0 +1,161 @@
+// 批量求解：发现 data/ 下的所有算例目录，在工作窃取线程池（work_pool.h）中并行求解
+// 每个算例的结果写到对应的 output/output_* 目录（example_L12 -> output/output_L12），
+// 日志写到该目录下的 solve.log，最后输出汇总表 output/batch_summary.csv。
+// 每个算例的 CPLEX 线程数 = 核数 / 并行算例数，使总线程数与核数一致（显式 --threads= 时按给定值）。
+//
+// 用法: ./batch_runner [--jobs=N] [--data=目录] [--filter=子串] [verify 的建模/求解选项 ...]
+//       --jobs 为同时求解的算例数（默认 min(核数, 算例数)），--filter 只运行目录名含该子串的算例
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "port_model.h"
+#include "port_solution.h"
+#include "solve_instance.h"
+#include "work_pool.h"
+
+using namespace std;
+
+struct BatchJob {
+    string name;      // 目录名，如 example_L12
+    string base;      // data/example_L12/params_output
+    string outDir;    // output/output_L12
+    double size = 0;  // 规模估计，用于按从大到小提交
+    InstanceResult result;
+    int worker = -1;
+};
+
+static bool fileExists(const string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// 列出 dataDir 下所有含 CSV 或二进制参数文件的 example_* 目录
+static vector<BatchJob> discoverJobs(const string& dataDir, const string& filter) {
+    vector<BatchJob> jobs;
+    DIR* dir = opendir(dataDir.c_str());
+    if (!dir) {
+        cerr << "无法打开数据目录: " << dataDir << endl;
+        return jobs;
+    }
+    while (struct dirent* ent = readdir(dir)) {
+        string name = ent->d_name;
+        if (name.compare(0, 8, "example_") != 0) continue;
+        if (!filter.empty() && name.find(filter) == string::npos) continue;
+        BatchJob job;
+        job.name = name;
+        job.base = dataDir + "/" + name + "/params_output";
+        if (!fileExists(job.base + "_general.csv") && !fileExists(job.base + ".bin")) continue;
+        job.outDir = "output/output_" + name.substr(8);
+        jobs.push_back(job);
+    }
+    closedir(dir);
+    sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.name < b.name; });
+    return jobs;
+}
+
+// 规模估计：先后关系约 S^2 * B，堆场约 S * K * R * V（读入参数很快，二进制算例为 mmap）
+static double estimateSize(const BatchJob& job) {
+    ModelParams params;
+    if (!loadParamsAuto(job.base, params)) return 0;
+    double S = params.numShips;
+    return S * S * params.numBerths + S * params.numShipK * params.numRows * params.numSlotsPerRow;
+}
+
+int main(int argc, char** argv) {
+    ModelOptions opts;
+    string dataDir = "data", filter;
+    int jobsWanted = 0;
+    bool threadsGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 7, "--jobs=") == 0) {
+            jobsWanted = atoi(arg.c_str() + 7);
+            if (jobsWanted <= 0) { cerr << "无效的并行算例数: " << arg << endl; return 1; }
+        } else if (arg.compare(0, 7, "--data=") == 0) {
+            dataDir = arg.substr(7);
+        } else if (arg.compare(0, 9, "--filter=") == 0) {
+            filter = arg.substr(9);
+        } else {
+            if (!parseModelOption(arg, opts)) return 1;
+            if (arg.compare(0, 10, "--threads=") == 0) threadsGiven = true;
+        }
+    }
+
+    vector<BatchJob> jobs = discoverJobs(dataDir, filter);
+    if (jobs.empty()) {
+        cerr << "没有找到算例: " << dataDir << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < jobs.size(); ++i) jobs[i].size = estimateSize(jobs[i]);
+
+    int cores = static_cast<int>(thread::hardware_concurrency());
+    if (cores < 1) cores = 1;
+    int workers = min(jobsWanted > 0 ? jobsWanted : cores, static_cast<int>(jobs.size()));
+    if (!threadsGiven) opts.threads = max(1, cores / workers);
+    cout << "算例 " << jobs.size() << " 个 | 并行 " << workers << " 个 | 每个算例 CPLEX 线程 " << opts.threads
+         << " | 方法 " << solveMethodName(opts.method) << " | 时间限制 " << opts.timeLimit << " 秒" << endl;
+
+    // 从大到小提交：大算例先开始，小算例在末尾被空闲线程窃取
+    vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return jobs[a].size > jobs[b].size; });
+
+    auto wallStart = chrono::steady_clock::now();
+    mutex printLock;
+    WorkStealingPool pool(workers);
+    for (size_t i = 0; i < order.size(); ++i) {
+        BatchJob* job = &jobs[order[i]];
+        pool.submit([job, &opts, &printLock](int worker) {
+            job->worker = worker;
+            job->result.instance = job->base;
+            job->result.status = "LogError";
+            if (!mkdir_p(job->outDir)) return;
+            ofstream log((job->outDir + "/solve.log").c_str());
+            if (!log.is_open()) {
+                cerr << "无法打开日志文件: " << job->outDir << "/solve.log" << endl;
+                return;
+            }
+            solveInstance(job->base, job->outDir, opts, log, &job->result);
+            lock_guard<mutex> g(printLock);
+            cout << "[worker " << worker << "] " << job->name << " | " << job->result.status
+                 << " | 目标 " << job->result.objective << " | " << job->result.seconds << " s" << endl;
+        });
+    }
+    pool.run();
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+
+    // 汇总
+    double serial = 0.0;
+    int failed = 0;
+    cout << endl << left << setw(16) << "instance" << right << setw(7) << "ships" << setw(22) << "status"
+         << setw(16) << "objective" << setw(16) << "bound" << setw(10) << "gap(%)" << setw(10) << "sec" << endl;
+    ofstream csv("output/batch_summary.csv");
+    csv << "instance,ships,method,status,ok,objective,best_bound,gap,seconds,threads,worker\n";
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const BatchJob& j = jobs[i];
+        const InstanceResult& r = j.result;
+        serial += r.seconds;
+        if (!r.ok) ++failed;
+        cout << left << setw(16) << j.name << right << setw(7) << r.ships << setw(22) << r.status
+             << setw(16) << r.objective << setw(16) << r.bound << setw(10) << r.gap * 100.0
+             << setw(10) << r.seconds << endl;
+        csv << j.name << "," << r.ships << "," << solveMethodName(opts.method) << "," << r.status << ","
+            << (r.ok ? 1 : 0) << "," << r.objective << "," << r.bound << "," << r.gap << ","
+            << r.seconds << "," << r.threads << "," << j.worker << "\n";
+    }
+    cout << "总墙钟 " << wall << " s | 各算例耗时之和 " << serial << " s | 窃取 " << pool.steals()
+         << " 次 | 失败 " << failed << " 个" << endl;
+    cout << "结果已写入 output/batch_summary.csv" << endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,344 @@
+// 可复现的基准测试：按配置文件逐个建模求解，记录各阶段耗时并与基线比较
+//
+// 配置文件每行一个基准：名称 算例前缀 [verify 的建模/求解选项 ...] [--det-limit=ticks]
+// （# 开头为注释）。为了结果可复现，CPLEX 使用确定性并行模式与固定随机种子，默认单线程；
+// 给出 --det-limit 时用确定性时间限制（DetTiLim）代替墙钟时间限制。
+//
+// 每个基准记录的指标（键名）：
+//   phase.<阶段>.wall_ms / cpu_ms / ticks   阶段：load、heuristic、build.*（各约束族，见 buildPortModel）、
+//                                           extract（IloCplex 抽取模型）、mipstart、solve、solution、write
+//   rows / cols / nnz、status、objective、best_bound、gap、nodes
+//   lazy_rows / lazy_rejections（--lazy-overlap 时加入的延迟约束行数与被拒绝的候选解数，见 lazy_rows.h）
+// 重复 --repeat 次时耗时取中位数。结果写到 <out>/bench_results.json 与 <out>/bench_results.csv
+// （每行 name,key,value），后者可直接作为基线。
+//
+// 与基线比较（--baseline=文件）：
+//   耗时：当前 > 基线 * (1 + time-tol) + 20 ms 视为退化；ticks：当前 > 基线 * (1 + tick-tol) + 1 视为退化
+//   目标值：比基线差（更大）超过相对 obj-tol 视为退化；gap：比基线大超过 gap-tol（绝对值）视为退化
+//   模型规模（rows/cols/nnz）或求解状态变化只给出提示
+// 有退化时返回 1。
+//
+// 用法: ./bench_harness [--config=bench_harness.cfg] [--out=output/bench] [--repeat=N]
+//                       [--baseline=文件] [--time-tol=0.25] [--tick-tol=0.05] [--obj-tol=1e-6] [--gap-tol=0.01]
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <map>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "port_model.h"
+#include "lazy_rows.h"
+#include "port_solution.h"
+#include "heuristic.h"
+#include "phase_timer.h"
+
+using namespace std;
+
+struct BenchConfig {
+    string name;
+    string base;
+    string options;        // 原始选项文本（写入结果）
+    ModelOptions opts;
+    double detLimit = 0;   // > 0 时使用 DetTiLim
+};
+
+struct BenchRun {
+    string name;
+    string instance;
+    string options;
+    map<string, double> metrics;
+    string status;
+};
+
+static bool parseConfig(const string& path, vector<BenchConfig>& configs) {
+    ifstream in(path.c_str());
+    if (!in.is_open()) {
+        cerr << "无法打开配置文件: " << path << endl;
+        return false;
+    }
+    string line;
+    int lineNo = 0;
+    while (getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line[0] == '#') continue;
+        istringstream ss(line);
+        BenchConfig cfg;
+        if (!(ss >> cfg.name >> cfg.base)) continue;
+        cfg.opts.threads = 1;
+        string arg;
+        while (ss >> arg) {
+            if (!cfg.options.empty()) cfg.options += " ";
+            cfg.options += arg;
+            if (arg.compare(0, 12, "--det-limit=") == 0) {
+                cfg.detLimit = atof(arg.c_str() + 12);
+            } else if (!parseModelOption(arg, cfg.opts)) {
+                cerr << path << ":" << lineNo << ": 选项无效" << endl;
+                return false;
+            }
+        }
+        configs.push_back(cfg);
+    }
+    return true;
+}
+
+// 运行一次，指标写入 run
+static void runOnce(const BenchConfig& cfg, const string& outDir, BenchRun& run) {
+    PhaseProfile profile;
+    PhaseTimer timer(&profile);
+    run.status = "Unknown";
+
+    timer.begin("load");
+    ModelParams params;
+    if (!loadParamsAuto(cfg.base, params)) {
+        run.status = "LoadError";
+        return;
+    }
+    PortSolution start;
+    bool haveStart = false, startInHorizon = false;
+    if (cfg.opts.mipStart) {
+        timer.begin("heuristic");
+        haveStart = greedySolution(params, start, &startInHorizon);
+    }
+    timer.end();
+
+    IloEnv env;
+    try {
+        PortModel pm;
+        buildPortModel(env, params, cfg.opts, pm, 0, &profile);
+
+        timer.begin("extract");
+        IloCplex cplex(pm.model);
+        timer.end();
+        cplex.setOut(env.getNullStream());
+        cplex.setWarning(env.getNullStream());
+        cplex.setParam(IloCplex::Threads, cfg.opts.threads);
+        cplex.setParam(IloCplex::ParallelMode, 1);   // 确定性并行
+        cplex.setParam(IloCplex::RandomSeed, 1);
+        if (cfg.detLimit > 0) cplex.setParam(IloCplex::DetTiLim, cfg.detLimit);
+        else cplex.setParam(IloCplex::TiLim, cfg.opts.timeLimit);
+        run.metrics["rows"] = cplex.getNrows();
+        run.metrics["cols"] = cplex.getNcols();
+        run.metrics["nnz"] = cplex.getNNZs();
+        LazyRowCallback lazy(env, pm.lazyRows, pm.columns);
+        if (pm.lazyRows.numRows() > 0) cplex.use(&lazy, IloCplex::Callback::Context::Id::Candidate);
+
+        if (haveStart) {
+            timer.begin("mipstart");
+            addMIPStartFromSolution(cplex, params, pm, start, "greedy",
+                                    startInHorizon ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair);
+        }
+        timer.begin("solve");
+        double ticks0 = cplex.getDetTime();
+        bool solved = cplex.solve();
+        timer.end(cplex.getDetTime() - ticks0);
+        run.metrics["nodes"] = static_cast<double>(cplex.getNnodes64());
+        if (pm.lazyRows.numRows() > 0) {
+            run.metrics["lazy_rows"] = lazy.rowsAdded();
+            run.metrics["lazy_rejections"] = lazy.rejections();
+        }
+        ostringstream st;
+        st << cplex.getStatus();
+        run.status = st.str();
+        if (solved) {
+            run.metrics["objective"] = cplex.getObjValue();
+            run.metrics["best_bound"] = cplex.getBestObjValue();
+            run.metrics["gap"] = cplex.getMIPRelativeGap();
+            timer.begin("solution");
+            PortSolution sol;
+            extractSolution(cplex, params, pm, sol);
+            timer.begin("write");
+            writeSolutionCSV(params, sol, outDir + "/" + cfg.name);
+            timer.end();
+        }
+        cplex.end();
+    } catch (IloException& ex) {
+        cerr << "CPLEX异常(" << cfg.name << "): " << ex << endl;
+        run.status = "Exception";
+    }
+    env.end();
+
+    for (size_t i = 0; i < profile.phases().size(); ++i) {
+        const PhaseRecord& r = profile.phases()[i];
+        run.metrics["phase." + r.name + ".wall_ms"] = r.wallMs;
+        run.metrics["phase." + r.name + ".cpu_ms"] = r.cpuMs;
+        run.metrics["phase." + r.name + ".ticks"] = r.ticks;
+    }
+}
+
+static bool isTimingKey(const string& key) {
+    return key.compare(0, 6, "phase.") == 0;
+}
+
+static bool endsWith(const string& s, const string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static BenchRun runConfig(const BenchConfig& cfg, int repeat, const string& outDir) {
+    vector<BenchRun> runs(repeat);
+    for (int i = 0; i < repeat; ++i) runOnce(cfg, outDir, runs[i]);
+    // 耗时取中位数，其余指标取最后一次
+    BenchRun result = runs.back();
+    result.name = cfg.name;
+    result.instance = cfg.base;
+    result.options = cfg.options;
+    for (map<string, double>::iterator it = result.metrics.begin(); it != result.metrics.end(); ++it) {
+        if (!isTimingKey(it->first)) continue;
+        vector<double> v;
+        for (int i = 0; i < repeat; ++i) {
+            map<string, double>::const_iterator f = runs[i].metrics.find(it->first);
+            if (f != runs[i].metrics.end()) v.push_back(f->second);
+        }
+        sort(v.begin(), v.end());
+        it->second = v[v.size() / 2];
+    }
+    return result;
+}
+
+static string jsonEscape(const string& s) {
+    string out;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '"' || s[i] == '\\') out.push_back('\\');
+        out.push_back(s[i]);
+    }
+    return out;
+}
+
+static void writeResults(const vector<BenchRun>& runs, const string& outDir) {
+    mkdir_p(outDir);
+    ofstream csv((outDir + "/bench_results.csv").c_str());
+    csv.precision(12);
+    csv << "name,key,value\n";
+    ofstream json((outDir + "/bench_results.json").c_str());
+    json.precision(12);
+    json << "{\n  \"runs\": [\n";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const BenchRun& r = runs[i];
+        csv << r.name << ",instance," << r.instance << "\n";
+        csv << r.name << ",status," << r.status << "\n";
+        json << "    {\n      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+             << "      \"instance\": \"" << jsonEscape(r.instance) << "\",\n"
+             << "      \"options\": \"" << jsonEscape(r.options) << "\",\n"
+             << "      \"status\": \"" << jsonEscape(r.status) << "\",\n"
+             << "      \"metrics\": {";
+        size_t n = 0;
+        for (map<string, double>::const_iterator it = r.metrics.begin(); it != r.metrics.end(); ++it, ++n) {
+            csv << r.name << "," << it->first << "," << it->second << "\n";
+            json << (n ? "," : "") << "\n        \"" << jsonEscape(it->first) << "\": " << it->second;
+        }
+        json << "\n      }\n    }" << (i + 1 < runs.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+}
+
+// 读基线 CSV：name -> key -> value（文本）
+static bool readBaseline(const string& path, map<string, map<string, string>>& baseline) {
+    ifstream in(path.c_str());
+    if (!in.is_open()) {
+        cerr << "无法打开基线文件: " << path << endl;
+        return false;
+    }
+    string line;
+    getline(in, line);   // 表头
+    while (getline(in, line)) {
+        size_t a = line.find(','), b = line.find(',', a + 1);
+        if (a == string::npos || b == string::npos) continue;
+        baseline[line.substr(0, a)][line.substr(a + 1, b - a - 1)] = line.substr(b + 1);
+    }
+    return true;
+}
+
+struct Tolerances {
+    double time = 0.25;
+    double ticks = 0.05;
+    double objective = 1e-6;
+    double gap = 0.01;
+};
+
+// 返回退化项数
+static int compareWithBaseline(const vector<BenchRun>& runs, const map<string, map<string, string>>& baseline,
+                               const Tolerances& tol) {
+    int regressions = 0;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const BenchRun& r = runs[i];
+        map<string, map<string, string>>::const_iterator b = baseline.find(r.name);
+        if (b == baseline.end()) {
+            cout << "[新增] " << r.name << " 不在基线中" << endl;
+            continue;
+        }
+        const map<string, string>& base = b->second;
+        map<string, string>::const_iterator st = base.find("status");
+        if (st != base.end() && st->second != r.status) {
+            cout << "[提示] " << r.name << " 状态 " << st->second << " -> " << r.status << endl;
+        }
+        for (map<string, double>::const_iterator it = r.metrics.begin(); it != r.metrics.end(); ++it) {
+            map<string, string>::const_iterator f = base.find(it->first);
+            if (f == base.end()) continue;
+            const double was = atof(f->second.c_str()), now = it->second;
+            const string& key = it->first;
+            bool regressed = false;
+            if (endsWith(key, ".wall_ms") || endsWith(key, ".cpu_ms")) {
+                regressed = now > was * (1 + tol.time) + 20.0;
+            } else if (endsWith(key, ".ticks")) {
+                regressed = now > was * (1 + tol.ticks) + 1.0;
+            } else if (key == "objective") {
+                regressed = now - was > tol.objective * max(1.0, fabs(was));
+            } else if (key == "gap") {
+                regressed = now - was > tol.gap;
+            } else if (key == "rows" || key == "cols" || key == "nnz") {
+                if (now != was) cout << "[提示] " << r.name << " " << key << " " << was << " -> " << now << endl;
+            }
+            if (regressed) {
+                cout << "[退化] " << r.name << " " << key << ": 基线 " << was << " 当前 " << now << endl;
+                ++regressions;
+            }
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    string configPath = "bench_harness.cfg", outDir = "output/bench", baselinePath;
+    int repeat = 1;
+    Tolerances tol;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        string key = arg.substr(0, eq), val = eq == string::npos ? string() : arg.substr(eq + 1);
+        if (key == "--config") configPath = val;
+        else if (key == "--out") outDir = val;
+        else if (key == "--baseline") baselinePath = val;
+        else if (key == "--repeat") repeat = max(1, atoi(val.c_str()));
+        else if (key == "--time-tol") tol.time = atof(val.c_str());
+        else if (key == "--tick-tol") tol.ticks = atof(val.c_str());
+        else if (key == "--obj-tol") tol.objective = atof(val.c_str());
+        else if (key == "--gap-tol") tol.gap = atof(val.c_str());
+        else { cerr << "未知参数: " << arg << endl; return 1; }
+    }
+
+    vector<BenchConfig> configs;
+    if (!parseConfig(configPath, configs)) return 1;
+    vector<BenchRun> runs;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        BenchRun r = runConfig(configs[i], repeat, outDir);
+        cout << r.name << " | " << r.status << " | 目标 " << r.metrics["objective"] << " gap " << r.metrics["gap"] * 100.0
+             << "% | 建模 " << r.metrics["phase.build.variables.wall_ms"] << " ms(变量) | 求解 "
+             << r.metrics["phase.solve.wall_ms"] << " ms, " << r.metrics["phase.solve.ticks"] << " ticks" << endl;
+        runs.push_back(r);
+    }
+    writeResults(runs, outDir);
+    cout << "结果已写入 " << outDir << "/bench_results.json 与 bench_results.csv" << endl;
+
+    if (baselinePath.empty()) return 0;
+    map<string, map<string, string>> baseline;
+    if (!readBaseline(baselinePath, baseline)) return 1;
+    int regressions = compareWithBaseline(runs, baseline, tol);
+    if (regressions) cout << "发现 " << regressions << " 项退化" << endl;
+    else cout << "没有发现退化" << endl;
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+// 基准：贪心初始解（heuristic.h）对 MIP 求解的影响
+// 对每个算例分别冷启动与带初始解求解同一模型，记录首个可行解的时间与目标值、
+// 10/30/60 秒时的 gap（SolveProgress 回调记录）以及最终目标值与 gap。
+// YardColumns 下两次求解使用同一个列池（含启发式的放置），保证模型相同。
+//
+// 用法: ./bench_mipstart [--trans=...] [--seq=...] [--yard=...] [--threads=N] [--time-limit=秒] [baseName ...]
+//       不给 baseName 时运行 data/example_L10 ... data/example_L12，默认时间限制 120 秒
+// 结果: 控制台表格 + output/bench_mipstart.csv
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "port_model.h"
+#include "heuristic.h"
+#include "yard_colgen.h"
+#include "solve_progress.h"
+#include "lazy_rows.h"
+
+using namespace std;
+
+struct BenchResult {
+    string instance;
+    string mode;   // cold / warm
+    string status;
+    double firstSec = NAN, firstObj = NAN;
+    double gap10 = NAN, gap30 = NAN, gap60 = NAN;
+    double obj = NAN, gap = NAN, solveSec = 0;
+};
+
+static BenchResult runOne(const string& base, const ModelParams& params, const ModelOptions& opts,
+                          const YardColumnPool* pool, const PortSolution* start, bool startInHorizon) {
+    BenchResult res;
+    res.instance = base;
+    res.mode = start ? "warm" : "cold";
+    IloEnv env;
+    try {
+        PortModel pm;
+        buildPortModel(env, params, opts, pm, pool);
+        IloCplex cplex(pm.model);
+        cplex.setOut(env.getNullStream());
+        cplex.setParam(IloCplex::TiLim, opts.timeLimit);
+        if (opts.threads > 0) cplex.setParam(IloCplex::Threads, opts.threads);
+        if (start) {
+            addMIPStartFromSolution(cplex, params, pm, *start, "greedy",
+                                    startInHorizon ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair);
+        }
+        SolveProgress progress;
+        LazyRowCallback lazy(env, pm.lazyRows, pm.columns);
+        CallbackChain callbacks;
+        callbacks.add(&progress, IloCplex::Callback::Context::Id::GlobalProgress);
+        if (pm.lazyRows.numRows() > 0) callbacks.add(&lazy, IloCplex::Callback::Context::Id::Candidate);
+        cplex.use(&callbacks, callbacks.contextMask());
+
+        progress.start();
+        double s0 = cplex.getCplexTime();
+        bool solved = cplex.solve();
+        res.solveSec = cplex.getCplexTime() - s0;
+        ostringstream st;
+        st << cplex.getStatus();
+        res.status = st.str();
+        if (progress.hasIncumbent()) {
+            res.firstSec = progress.firstIncumbentSeconds();
+            res.firstObj = progress.firstIncumbentObjective();
+            res.gap10 = progress.gapAt(10);
+            res.gap30 = progress.gapAt(30);
+            res.gap60 = progress.gapAt(60);
+        }
+        if (solved) {
+            res.obj = cplex.getObjValue();
+            res.gap = cplex.getMIPRelativeGap();
+        }
+        cplex.end();
+    } catch (IloException& ex) {
+        cerr << "CPLEX异常(" << base << ", " << res.mode << "): " << ex << endl;
+        res.status = "Exception";
+    }
+    env.end();
+    return res;
+}
+
+int main(int argc, char** argv) {
+    ModelOptions base;
+    base.timeLimit = 120;
+    vector<string> instances;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 2, "--") == 0) {
+            if (!parseModelOption(arg, base)) return 1;
+        } else {
+            instances.push_back(arg);
+        }
+    }
+    if (instances.empty()) {
+        for (int i = 10; i <= 12; ++i) instances.push_back("data/example_L" + to_string(i) + "/params_output");
+    }
+
+    vector<BenchResult> results;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        ModelParams params;
+        if (!loadParamsAuto(instances[i], params)) continue;
+
+        auto t0 = chrono::steady_clock::now();
+        PortSolution start;
+        bool startInHorizon = false;
+        if (!greedySolution(params, start, &startInHorizon)) {
+            cerr << instances[i] << ": 贪心启发式未找到完整的解，跳过" << endl;
+            continue;
+        }
+        double heurMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << instances[i] << " | 启发式 " << heurMs << " ms, 目标 "
+             << weightedObjective(params, evaluateShipCosts(params, start)) << endl;
+
+        YardColumnPool pool;
+        if (base.yard == YardColumns) {
+            IloEnv env;
+            vector<vector<int>> scenarios = defaultBerthScenarios(params);
+            scenarios.push_back(start.berth);
+            YardColGenOptions cg;
+            cg.threads = base.threads;
+            generateYardColumns(env, params, scenarios, cg, pool);
+            env.end();
+            for (int s = 0; s < params.numShips; ++s) {
+                for (int k = 0; k < params.numShipK; ++k) {
+                    if (!start.slots[s][k].empty()) pool.add(s, k, start.row[s][k], start.slots[s][k].front());
+                }
+            }
+        }
+        const YardColumnPool* poolPtr = base.yard == YardColumns ? &pool : 0;
+
+        for (int warm = 0; warm < 2; ++warm) {
+            BenchResult r = runOne(instances[i], params, base, poolPtr, warm ? &start : 0, startInHorizon);
+            cout << r.instance << " | " << r.mode
+                 << " | 首个可行解 " << r.firstSec << " s, 目标 " << r.firstObj
+                 << " | gap@10s " << r.gap10 * 100.0 << "% @30s " << r.gap30 * 100.0 << "% @60s " << r.gap60 * 100.0
+                 << "% | " << r.status << " 目标 " << r.obj << " gap " << r.gap * 100.0
+                 << "% | 求解 " << r.solveSec << " s" << endl;
+            results.push_back(r);
+        }
+    }
+
+    ofstream csv("output/bench_mipstart.csv");
+    csv << "instance,mode,first_incumbent_s,first_objective,gap_10s,gap_30s,gap_60s,status,objective,gap,solve_s\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        csv << r.instance << "," << r.mode << "," << r.firstSec << "," << r.firstObj << ","
+            << r.gap10 << "," << r.gap30 << "," << r.gap60 << "," << r.status << ","
+            << r.obj << "," << r.gap << "," << r.solveSec << "\n";
+    }
+    cout << "结果已写入 output/bench_mipstart.csv" << endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+// 微基准：比较嵌套 vector 与连续张量在目标函数构建循环 O(S·K·B·R·V) 上的访存开销
+// 循环体与 verify.cpp 中转运成本项的系数计算一致：
+//   transshipmentCost[b][r][v] * cargoWeight[s] / (requiredSlots[s][k] * K)
+// 此处只计算系数（不依赖 CPLEX），从而单独度量参数访问的代价。
+//
+// 编译: g++ -std=c++11 -O2 bench_tensor.cpp -o bench_tensor
+// 运行: ./bench_tensor [numShips numBerths numRows numSlotsPerRow numShipK reps]
+#include "tensor.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+
+using namespace std;
+
+typedef vector<vector<vector<double>>> Nested3;
+
+// 嵌套 vector 版本（原 ModelParams 的存储方式）
+static double objectiveLoopNested(const Nested3& trans, const Nested3& store,
+                                  const vector<double>& weight, const vector<vector<int>>& req,
+                                  int S, int K, int B, int R, int V) {
+    double acc = 0.0;
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            double perSlot = weight[s] / (req[s][k] * K);
+            for (int b = 0; b < B; b++) {
+                for (int r = 0; r < R; r++) {
+                    for (int v = 0; v < V; v++) {
+                        acc += trans[b][r][v] * perSlot;
+                    }
+                }
+            }
+            for (int r = 0; r < R; r++) {
+                for (int v = 0; v < V; v++) {
+                    acc += store[s][k][r];
+                }
+            }
+        }
+    }
+    return acc;
+}
+
+// 连续张量版本（当前 ModelParams 的存储方式）
+static double objectiveLoopTensor(const ParamTensor3& trans, const ParamTensor3& store,
+                                  const vector<double>& weight, const vector<vector<int>>& req,
+                                  int S, int K, int B, int R, int V) {
+    double acc = 0.0;
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            double perSlot = weight[s] / (req[s][k] * K);
+            for (int b = 0; b < B; b++) {
+                for (int r = 0; r < R; r++) {
+                    for (int v = 0; v < V; v++) {
+                        acc += trans(b, r, v) * perSlot;
+                    }
+                }
+            }
+            for (int r = 0; r < R; r++) {
+                for (int v = 0; v < V; v++) {
+                    acc += store(s, k, r);
+                }
+            }
+        }
+    }
+    return acc;
+}
+
+// 运行 reps 次，返回每次迭代的平均毫秒数
+template <typename F>
+static double timeIt(F fn, int reps, double& sink) {
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < reps; i++) sink += fn();
+    auto t1 = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(t1 - t0).count() / reps;
+}
+
+int main(int argc, char** argv) {
+    // 默认规模与 example_L12 一致
+    int S = 50, B = 9, R = 20, V = 24, K = 3, reps = 50;
+    if (argc >= 7) {
+        S = atoi(argv[1]); B = atoi(argv[2]); R = atoi(argv[3]);
+        V = atoi(argv[4]); K = atoi(argv[5]); reps = atoi(argv[6]);
+    }
+
+    mt19937 gen(42);
+    uniform_real_distribution<> cost(15, 30);
+    uniform_int_distribution<> slots(1, 4);
+
+    // 1) 分配开销：嵌套 vector 每个最内层一次堆分配，张量每个参数一次
+    double sinkA = 0.0;
+    double allocN = timeIt([&]{
+        Nested3 a(S, vector<vector<double>>(B, vector<double>(K)));
+        Nested3 b(B, vector<vector<double>>(R, vector<double>(V)));
+        Nested3 c(S, vector<vector<double>>(K, vector<double>(R)));
+        return a[0][0][0] + b[0][0][0] + c[0][0][0];
+    }, reps, sinkA);
+    double allocT = timeIt([&]{
+        ParamTensor3 a(S, B, K), b(B, R, V), c(S, K, R);
+        return static_cast<double>(a(0, 0, 0) + b(0, 0, 0) + c(0, 0, 0));
+    }, reps, sinkA);
+    long long blocksN = 3LL + S + static_cast<long long>(S) * B + B + static_cast<long long>(B) * R + S + static_cast<long long>(S) * K;
+
+    Nested3 transN(B, vector<vector<double>>(R, vector<double>(V)));
+    Nested3 storeN(S, vector<vector<double>>(K, vector<double>(R)));
+    ParamTensor3 transT(B, R, V);
+    ParamTensor3 storeT(S, K, R);
+    for (int b = 0; b < B; b++)
+        for (int r = 0; r < R; r++)
+            for (int v = 0; v < V; v++)
+                transT(b, r, v) = transN[b][r][v] = cost(gen);
+    for (int s = 0; s < S; s++)
+        for (int k = 0; k < K; k++)
+            for (int r = 0; r < R; r++)
+                storeT(s, k, r) = storeN[s][k][r] = 1000 + cost(gen);
+
+    vector<double> weight(S);
+    vector<vector<int>> req(S, vector<int>(K));
+    for (int s = 0; s < S; s++) {
+        weight[s] = 100000 + 1000 * s;
+        for (int k = 0; k < K; k++) req[s][k] = slots(gen);
+    }
+
+    double sinkN = 0.0, sinkT = 0.0;
+    double msN = timeIt([&]{ return objectiveLoopNested(transN, storeN, weight, req, S, K, B, R, V); }, reps, sinkN);
+    double msT = timeIt([&]{ return objectiveLoopTensor(transT, storeT, weight, req, S, K, B, R, V); }, reps, sinkT);
+
+    double terms = static_cast<double>(S) * K * (static_cast<double>(B) * R * V + static_cast<double>(R) * V);
+    cout << "规模: S=" << S << " K=" << K << " B=" << B << " R=" << R << " V=" << V
+         << " 每轮项数=" << static_cast<long long>(terms) << " reps=" << reps << endl;
+    cout << "参数精度: " << (sizeof(param_t) == sizeof(float) ? "float" : "double") << endl;
+    cout << "分配 p_sbk/d_brv/phi_skr: 嵌套 vector " << allocN << " ms (" << blocksN << " 次堆分配), 连续张量 "
+         << allocT << " ms (3 次堆分配)" << endl;
+    cout << "嵌套 vector: " << msN << " ms/轮, " << (msN * 1e6 / terms) << " ns/项" << endl;
+    cout << "连续张量:    " << msT << " ms/轮, " << (msT * 1e6 / terms) << " ns/项" << endl;
+    cout << "加速比: " << (msT > 0 ? msN / msT : 0.0) << "x" << endl;
+    // 防止编译器把循环优化掉
+    cout << "校验和: " << sinkN << " / " << sinkT << " / " << sinkA << endl;
+    return 0;
+}
@@ -0,0 +1,296 @@
+#include "benders.h"
+#include "yard_colgen.h"
+#include "berth_sequencing.h"
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+YardSubResult solveYardSubproblem(const ModelParams& params, const vector<int>& berth,
+                                  double timeLimit, int threads) {
+    const int S = params.numShips, K = params.numShipK, R = params.numRows, V = params.numSlotsPerRow;
+    YardSubResult res;
+    res.place.assign(S, vector<pair<int,int>>(K, make_pair(-1, -1)));
+    IloEnv env;
+    try {
+        IloModel model(env);
+        IloExpr obj(env);
+        IloArray<IloBoolVar> vars(env);
+        vector<int> index;   // vars[i] 对应 (s*K + k, r, j)，按 4 个 int 一组存放
+        vector<IloExpr> cover(static_cast<size_t>(R) * V);
+        vector<bool> coverUsed(static_cast<size_t>(R) * V, false);
+        for (int s = 0; s < S; ++s) {
+            for (int k = 0; k < K; ++k) {
+                const int n = params.requiredSlots[s][k];
+                if (n <= 0) continue;
+                // n > V 时没有可行起点，assign == 1 使子问题不可行
+                IloExpr assign(env);
+                for (int r = 0; r < R; ++r) {
+                    for (int j = 0; j + n <= V; ++j) {
+                        IloBoolVar p(env);
+                        vars.add(p);
+                        index.push_back(s); index.push_back(k); index.push_back(r); index.push_back(j);
+                        obj += yardBlockCost(params, s, k, berth[s], r, j) * p;
+                        assign += p;
+                        for (int v = j; v < j + n; ++v) {
+                            if (!coverUsed[r * V + v]) {
+                                cover[r * V + v] = IloExpr(env);
+                                coverUsed[r * V + v] = true;
+                            }
+                            cover[r * V + v] += p;
+                        }
+                    }
+                }
+                model.add(assign == 1);
+                assign.end();
+            }
+        }
+        for (int i = 0; i < R * V; ++i) {
+            if (!coverUsed[i]) continue;
+            model.add(cover[i] <= 1);
+            cover[i].end();
+        }
+        model.add(IloMinimize(env, obj));
+        obj.end();
+
+        IloCplex cplex(model);
+        cplex.setOut(env.getNullStream());
+        cplex.setWarning(env.getNullStream());
+        cplex.setParam(IloCplex::TiLim, max(timeLimit, 1.0));
+        cplex.setParam(IloCplex::Threads, threads);
+        if (cplex.solve()) {
+            res.solved = true;
+            res.optimal = cplex.getStatus() == IloAlgorithm::Optimal;
+            res.cost = cplex.getObjValue();
+            res.bound = res.optimal ? res.cost : cplex.getBestObjValue();
+            for (IloInt i = 0; i < vars.getSize(); ++i) {
+                if (cplex.getValue(vars[i]) > 0.5) {
+                    res.place[index[4 * i]][index[4 * i + 1]] = make_pair(index[4 * i + 2], index[4 * i + 3]);
+                }
+            }
+        }
+        cplex.end();
+    } catch (IloException& ex) {
+        cerr << "[Benders] 堆场子问题 CPLEX 异常: " << ex << endl;
+        res.solved = false;
+    }
+    env.end();
+    return res;
+}
+
+// 每个 (s,b) 的堆场成本下界 L_sb 与换泊位时的最大降幅 D_s(bbar)（见 benders.h）
+static void yardCostBounds(const ModelParams& params, vector<vector<double>>& L, vector<vector<double>>& D) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const int R = params.numRows, V = params.numSlotsPerRow;
+    L.assign(S, vector<double>(B, 0.0));
+    D.assign(S, vector<double>(B, 0.0));
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < K; ++k) {
+            const int n = params.requiredSlots[s][k];
+            if (n <= 0 || n > V) continue;
+            const int starts = V - n + 1;
+            const double w = params.cargoWeight[s] / (static_cast<double>(n) * params.numShipK);
+            // win[b][r*starts + j] = alpha * w * sum_{v=j}^{j+n-1} d_brv（滑动窗口）
+            vector<vector<double>> win(B, vector<double>(static_cast<size_t>(R) * starts));
+            for (int b = 0; b < B; ++b) {
+                for (int r = 0; r < R; ++r) {
+                    const param_t* d = params.transshipmentCost.row(b, r);
+                    double sum = 0.0;
+                    for (int v = 0; v < n; ++v) sum += d[v];
+                    for (int j = 0; j < starts; ++j) {
+                        win[b][r * starts + j] = params.alpha * w * sum;
+                        if (j + n < V) sum += d[j + n] - d[j];
+                    }
+                }
+            }
+            for (int b = 0; b < B; ++b) {
+                double best = numeric_limits<double>::infinity();
+                for (int r = 0; r < R; ++r) {
+                    double storage = params.alpha * n * params.storageCost(s,k,r);
+                    for (int j = 0; j < starts; ++j) best = min(best, win[b][r * starts + j] + storage);
+                }
+                L[s][b] += best;
+            }
+            // 存储成本与泊位无关，在差值中抵消
+            for (int bb = 0; bb < B; ++bb) {
+                double worst = 0.0;
+                for (int b = 0; b < B; ++b) {
+                    if (b == bb) continue;
+                    for (size_t i = 0; i < win[bb].size(); ++i) worst = max(worst, win[bb][i] - win[b][i]);
+                }
+                D[s][bb] += worst;
+            }
+        }
+    }
+}
+
+// 主问题的一个候选解：泊位分配、时间与不含 theta 的目标值（beta * 靠泊时间）
+struct MasterCandidate {
+    vector<int> berth;
+    vector<double> e;
+    vector<vector<double>> e_sk;
+    double berthPart;
+};
+
+static MasterCandidate readCandidate(const IloCplex& cplex, const ModelParams& params, const PortModel& pm,
+                                     const IloNumVar& theta, int poolIndex) {
+    // poolIndex < 0 表示当前最优解
+    auto value = [&](const IloNumVar& v) { return poolIndex < 0 ? cplex.getValue(v) : cplex.getValue(v, poolIndex); };
+    MasterCandidate c;
+    c.berth.assign(params.numShips, -1);
+    c.e.resize(params.numShips);
+    c.e_sk.assign(params.numShips, vector<double>(params.numShipK));
+    for (int s = 0; s < params.numShips; ++s) {
+        for (int b = 0; b < params.numBerths; ++b) {
+            if (value(pm.z[s][b]) > 0.5) { c.berth[s] = b; break; }
+        }
+        c.e[s] = value(pm.e[s]);
+        for (int k = 0; k < params.numShipK; ++k) c.e_sk[s][k] = value(pm.e_sk[s][k]);
+    }
+    double obj = poolIndex < 0 ? cplex.getObjValue() : cplex.getObjValue(poolIndex);
+    c.berthPart = obj - value(theta);
+    return c;
+}
+
+bool solveBenders(IloEnv env, const ModelParams& params, const ModelOptions& opts,
+                  PortSolution& sol, BendersReport* report) {
+    auto t0 = chrono::steady_clock::now();
+    auto elapsed = [&]() { return chrono::duration<double>(chrono::steady_clock::now() - t0).count(); };
+    const int S = params.numShips, B = params.numBerths;
+    int threads = opts.threads > 0 ? opts.threads : static_cast<int>(thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    const int batch = min(threads, 8);
+
+    // 主问题
+    ModelOptions masterOpts = opts;
+    masterOpts.yard = YardNone;
+    PortModel pm;
+    buildPortModel(env, params, masterOpts, pm);
+    IloNumVar theta(env, 0, IloInfinity, "theta");
+    pm.objective.setLinearCoef(theta, 1.0);
+
+    vector<vector<double>> L, D;
+    yardCostBounds(params, L, D);
+    {
+        IloExpr lb(env);
+        for (int s = 0; s < S; ++s) {
+            for (int b = 0; b < B; ++b) lb += L[s][b] * pm.z[s][b];
+        }
+        pm.model.add(theta - lb >= 0);
+        lb.end();
+    }
+
+    IloCplex cplex(pm.model);
+    cplex.setOut(env.getNullStream());
+    if (opts.threads > 0) cplex.setParam(IloCplex::Threads, opts.threads);
+
+    BendersReport rep;
+    rep.lowerBound = -numeric_limits<double>::infinity();
+    rep.upperBound = numeric_limits<double>::infinity();
+    map<vector<int>, double> evaluated;   // 已求解子问题的泊位分配 -> 割中使用的 Y
+    bool infeasible = false;
+    while (!infeasible) {
+        double remaining = opts.timeLimit - elapsed();
+        if (remaining <= 1.0) break;
+        cplex.setParam(IloCplex::TiLim, remaining);
+        if (!cplex.solve()) {
+            cerr << "[Benders] 主问题无解: " << cplex.getStatus() << endl;
+            break;
+        }
+        ++rep.iterations;
+        rep.lowerBound = max(rep.lowerBound, cplex.getBestObjValue());
+
+        // 候选泊位分配：当前最优解在前，其后是解池中的其它解
+        vector<MasterCandidate> cands;
+        int poolSize = static_cast<int>(cplex.getSolnPoolNsolns());
+        for (int i = -1; i < poolSize && static_cast<int>(cands.size()) < batch; ++i) {
+            MasterCandidate c = readCandidate(cplex, params, pm, theta, i);
+            if (evaluated.count(c.berth)) continue;
+            bool dup = false;
+            for (size_t j = 0; j < cands.size() && !dup; ++j) dup = cands[j].berth == c.berth;
+            if (!dup) cands.push_back(c);
+        }
+        // 当前最优解的泊位已有精确割：主问题目标 >= 靠泊部分 + Y，上下界已经重合
+        if (cands.empty()) break;
+
+        // 子问题并行求解，每个子问题独立 IloEnv、单线程。
+        // 解池中候选解的时间未必是该泊位分配下最优的，同时按泊位精确排序（berth_sequencing.h），只用于上界
+        vector<YardSubResult> results(cands.size());
+        atomic<int> next(0);
+        double subLimit = max(opts.timeLimit - elapsed(), 1.0);
+        auto worker = [&]() {
+            for (int i = next++; i < static_cast<int>(cands.size()); i = next++) {
+                results[i] = solveYardSubproblem(params, cands[i].berth, subLimit, 1);
+                PortSolution timing;
+                initSolution(timing, params);
+                timing.berth = cands[i].berth;
+                timing.e = cands[i].e;
+                BerthSequencingReport seq;
+                if (sequenceBerths(params, timing, 1, 0, &seq) && params.beta * seq.berthTime < cands[i].berthPart) {
+                    cands[i].e = timing.e;
+                    cands[i].e_sk = timing.e_sk;
+                    cands[i].berthPart = params.beta * seq.berthTime;
+                }
+            }
+        };
+        vector<thread> workers;
+        for (size_t t = 1; t < cands.size(); ++t) workers.push_back(thread(worker));
+        worker();
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+        rep.subproblems += static_cast<int>(cands.size());
+
+        for (size_t i = 0; i < cands.size(); ++i) {
+            const YardSubResult& r = results[i];
+            if (!r.solved) {
+                // 堆场对任何泊位都有相同的可行域，子问题无解说明整个问题无解
+                cerr << "[Benders] 堆场子问题无可行解，停止" << endl;
+                infeasible = true;
+                break;
+            }
+            // 最优性割 theta >= Y - sum_s D_s (1 - z_{s,bbar_s})
+            double Y = r.bound;
+            IloExpr cut(env);
+            double rhs = Y;
+            for (int s = 0; s < S; ++s) {
+                int bb = cands[i].berth[s];
+                cut -= D[s][bb] * pm.z[s][bb];
+                rhs -= D[s][bb];
+            }
+            pm.model.add(theta + cut >= rhs);
+            cut.end();
+            evaluated[cands[i].berth] = Y;
+            ++rep.cuts;
+
+            double total = cands[i].berthPart + r.cost;
+            if (total < rep.upperBound) {
+                rep.upperBound = total;
+                initSolution(sol, params);
+                sol.berth = cands[i].berth;
+                sol.e = cands[i].e;
+                sol.e_sk = cands[i].e_sk;
+                for (int s = 0; s < S; ++s) {
+                    for (int k = 0; k < params.numShipK; ++k) {
+                        const pair<int,int>& p = r.place[s][k];
+                        if (p.first >= 0) placeBlock(sol, s, k, p.first, p.second, params.requiredSlots[s][k]);
+                    }
+                }
+            }
+        }
+
+        double gap = (rep.upperBound - rep.lowerBound) / max(1.0, fabs(rep.upperBound));
+        cout << "[Benders] 迭代 " << rep.iterations << " | 下界 " << rep.lowerBound << " | 上界 " << rep.upperBound
+             << " | gap " << gap * 100.0 << "% | 子问题 " << cands.size() << " | 耗时 " << elapsed() << " s" << endl;
+        if (gap <= 1e-4) break;
+    }
+    cplex.end();
+
+    rep.seconds = elapsed();
+    if (report) *report = rep;
+    return !infeasible && rep.upperBound < numeric_limits<double>::infinity();
+}
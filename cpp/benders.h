@@ -0,0 +1,51 @@
+#ifndef BENDERS_H
+#define BENDERS_H
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <utility>
+#include "modelParam.h"
+#include "port_model.h"
+#include "port_solution.h"
+
+// 基于逻辑的 Benders 分解（--method=benders）
+//
+// 泊位/时间与堆场只通过转运成本耦合：泊位固定后，堆场部分是独立的区间放置问题。
+//   主问题：buildPortModel(YardNone) 的泊位分配、先后关系与卸货时间，外加 theta 近似
+//           alpha * (转运 + 存储)，初始下界 theta >= sum_sb L_sb z_sb（L_sb 为忽略槽容量时的最小堆场成本）
+//   子问题：给定泊位 bbar 的堆场 MIP（起点形式，块成本精确），最优值 Y(bbar)
+//   最优性割：theta >= Y(bbar) - sum_s D_s (1 - z_{s,bbar_s})
+// D_s = sum_k max_{b != bbar_s} max_{r,j} (c_{bbar_s}(r,j) - c_b(r,j))：把船 s 从 bbar_s 换到任意泊位时，
+// 沿用同一堆场放置可得 Y(bbar) <= Y(z) + sum_{换泊位的 s} D_s，因此该割对所有 z 有效。
+// 子问题未证明最优时用其最佳界代替 Y，割仍然有效。
+//
+// 每轮从主问题解池中取至多 batch 个不同的泊位分配，子问题各用独立的 IloEnv 并行求解。
+
+// 堆场子问题的结果
+struct YardSubResult {
+    bool solved = false;     // 找到可行解
+    bool optimal = false;
+    double cost = 0.0;       // 可行解的目标值 alpha * (转运 + 存储)
+    double bound = 0.0;      // 最佳界（最优时等于 cost）
+    std::vector<std::vector<std::pair<int,int>>> place;   // [s][k] -> (行, 起点)，未放置为 (-1,-1)
+};
+
+// 固定泊位 berth[s] 的堆场子问题（独立 IloEnv，可在多个线程中同时调用）
+YardSubResult solveYardSubproblem(const ModelParams& params, const std::vector<int>& berth,
+                                  double timeLimit, int threads);
+
+struct BendersReport {
+    int iterations = 0;
+    int cuts = 0;
+    int subproblems = 0;
+    double lowerBound = 0.0;
+    double upperBound = 0.0;
+    double seconds = 0.0;
+};
+
+// 用 Benders 分解求解，结果写入 sol；时间限制与线程数取自 opts
+// 找到可行解时返回 true（未在时间内收敛时为当前最好解）
+bool solveBenders(IloEnv env, const ModelParams& params, const ModelOptions& opts,
+                  PortSolution& sol, BendersReport* report = 0);
+
+#endif // BENDERS_H
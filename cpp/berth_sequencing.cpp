@@ -0,0 +1,374 @@
+#include "berth_sequencing.h"
+#include "heuristic.h"
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+
+const double kEps = 1e-9;
+const double kInf = numeric_limits<double>::infinity();
+
+// 状态表：已排集合 -> 互不支配的 (当前时刻, 已排部分 sum C)
+struct Label {
+    double time;
+    double cost;
+};
+
+struct MaskHash {
+    size_t operator()(const vector<uint64_t>& mask) const {
+        uint64_t h = 1469598103934665603ULL;
+        for (size_t i = 0; i < mask.size(); ++i) {
+            h ^= mask[i];
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+};
+
+class BerthSearch {
+public:
+    BerthSearch(const vector<BerthJob>& jobs, const SequencingOptions& opts)
+        : jobs_(jobs), opts_(opts), n_(static_cast<int>(jobs.size())), mask_((jobs.size() + 63) / 64, 0) {
+        byRelease_.resize(n_);
+        for (int j = 0; j < n_; ++j) byRelease_[j] = j;
+        stable_sort(byRelease_.begin(), byRelease_.end(), [&](int a, int b) { return jobs_[a].release < jobs_[b].release; });
+    }
+
+    // 按 order 依次尽早开始，全部满足开始时间上限时返回 true 并写入 sum C
+    bool evaluate(const vector<int>& order, double& cost) const {
+        double t = -kInf;
+        cost = 0.0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            const BerthJob& j = jobs_[order[i]];
+            const double start = max(t, j.release);
+            if (start > j.latestStart + kEps) return false;
+            t = start + j.processing;
+            cost += t;
+        }
+        return true;
+    }
+
+    // 可行时作为上界候选
+    void offer(const vector<int>& order) {
+        double cost;
+        if (static_cast<int>(order.size()) == n_ && evaluate(order, cost) && cost < ub_ - kEps) {
+            ub_ = cost;
+            best_ = order;
+        }
+    }
+
+    // 构造初始上界：hint、最早完工规则、最晚开始时间优先规则，再对最好者做局部搜索
+    void initialBounds(const vector<int>* hint) {
+        if (hint) offer(*hint);
+        offer(dispatch(false));
+        offer(dispatch(true));
+        if (!best_.empty()) improve();
+    }
+
+    void run() {
+        seq_.clear();
+        fill(mask_.begin(), mask_.end(), 0);
+        branch(-kInf, 0.0, -kInf, -1);
+    }
+
+    bool found() const { return !best_.empty() || n_ == 0; }
+    bool aborted() const { return aborted_; }
+    long nodes() const { return nodes_; }
+    double upperBound() const { return n_ == 0 ? 0.0 : ub_; }
+    const vector<int>& best() const { return best_; }
+
+private:
+    bool scheduled(int j) const { return (mask_[j >> 6] >> (j & 63)) & 1; }
+    void flip(int j) { mask_[j >> 6] ^= uint64_t(1) << (j & 63); }
+
+    // 逐个选择当前可开始的船：byDeadline 为 false 时取完工最早者，true 时取开始时间上限最早者
+    vector<int> dispatch(bool byDeadline) const {
+        vector<int> order;
+        vector<char> used(n_, 0);
+        double t = -kInf;
+        for (int step = 0; step < n_; ++step) {
+            int pick = -1;
+            double key = kInf, tie = kInf;
+            for (int j = 0; j < n_; ++j) {
+                if (used[j]) continue;
+                const double start = max(t, jobs_[j].release);
+                const double k1 = byDeadline ? jobs_[j].latestStart : start + jobs_[j].processing;
+                const double k2 = byDeadline ? start + jobs_[j].processing : jobs_[j].latestStart;
+                if (k1 < key || (k1 == key && k2 < tie)) { pick = j; key = k1; tie = k2; }
+            }
+            used[pick] = 1;
+            order.push_back(pick);
+            t = max(t, jobs_[pick].release) + jobs_[pick].processing;
+        }
+        return order;
+    }
+
+    // 相邻交换与插入的局部搜索，直到没有改进
+    void improve() {
+        vector<int> cur = best_;
+        bool improved = true;
+        for (int pass = 0; improved && pass < 4 * n_; ++pass) {
+            improved = false;
+            for (int i = 0; i + 1 < n_; ++i) {
+                swap(cur[i], cur[i + 1]);
+                double cost;
+                if (evaluate(cur, cost) && cost < ub_ - kEps) {
+                    ub_ = cost;
+                    best_ = cur;
+                    improved = true;
+                } else {
+                    swap(cur[i], cur[i + 1]);
+                }
+            }
+            for (int i = 0; i < n_ && !improved; ++i) {
+                for (int p = 0; p < n_ && !improved; ++p) {
+                    if (p == i) continue;
+                    vector<int> trial = cur;
+                    const int j = trial[i];
+                    trial.erase(trial.begin() + i);
+                    trial.insert(trial.begin() + p, j);
+                    double cost;
+                    if (evaluate(trial, cost) && cost < ub_ - kEps) {
+                        ub_ = cost;
+                        best_ = cur = trial;
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // 剩余船舶从时刻 t 起的 SRPT（可中断）sum C，是不可中断排序的下界
+    double srptBound(double t) {
+        double sum = 0.0;
+        heap_.clear();
+        const greater<double> cmp;
+        size_t i = 0;
+        while (true) {
+            while (i < byRelease_.size() && (scheduled(byRelease_[i]) || jobs_[byRelease_[i]].release <= t)) {
+                if (!scheduled(byRelease_[i])) {
+                    heap_.push_back(jobs_[byRelease_[i]].processing);
+                    push_heap(heap_.begin(), heap_.end(), cmp);
+                }
+                ++i;
+            }
+            if (heap_.empty()) {
+                if (i == byRelease_.size()) break;
+                t = jobs_[byRelease_[i]].release;
+                continue;
+            }
+            const double next = i < byRelease_.size() ? jobs_[byRelease_[i]].release : kInf;
+            if (t + heap_.front() <= next) {
+                t += heap_.front();
+                sum += t;
+                pop_heap(heap_.begin(), heap_.end(), cmp);
+                heap_.pop_back();
+            } else {
+                pop_heap(heap_.begin(), heap_.end(), cmp);
+                heap_.back() -= next - t;
+                push_heap(heap_.begin(), heap_.end(), cmp);
+                t = next;
+            }
+        }
+        return sum;
+    }
+
+    // 已记录的同一已排集合的状态支配 (t, cost) 时返回 true，否则记录它
+    bool dominated(double t, double cost) {
+        auto it = states_.find(mask_);
+        if (it != states_.end()) {
+            vector<Label>& labels = it->second;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (labels[i].time <= t + kEps && labels[i].cost <= cost + kEps) return true;
+            }
+            size_t kept = 0;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (!(t <= labels[i].time && cost <= labels[i].cost)) labels[kept++] = labels[i];
+            }
+            stateCount_ -= labels.size() - kept;
+            labels.resize(kept);
+            if (stateCount_ < opts_.stateLimit) {
+                labels.push_back(Label{t, cost});
+                ++stateCount_;
+            }
+        } else if (stateCount_ < opts_.stateLimit) {
+            states_[mask_].push_back(Label{t, cost});
+            ++stateCount_;
+        }
+        return false;
+    }
+
+    // t 为已排部分的完工时刻，prevT 为上一艘（last）开始前的时刻
+    void branch(double t, double cost, double prevT, int last) {
+        if (++nodes_ > opts_.nodeLimit) {
+            aborted_ = true;
+            return;
+        }
+        const int depth = static_cast<int>(seq_.size());
+        if (depth == n_) {
+            if (cost < ub_ - kEps) {
+                ub_ = cost;
+                best_ = seq_;
+            }
+            return;
+        }
+        // 某艘未排的船已无法在开始时间上限前开始
+        double minEnd = kInf, secondEnd = kInf;
+        int minJob = -1;
+        for (int j = 0; j < n_; ++j) {
+            if (scheduled(j)) continue;
+            const double start = max(t, jobs_[j].release);
+            if (start > jobs_[j].latestStart + kEps) return;
+            const double end = start + jobs_[j].processing;
+            if (end < minEnd) { secondEnd = minEnd; minEnd = end; minJob = j; }
+            else if (end < secondEnd) secondEnd = end;
+        }
+        if (cost + srptBound(t) >= ub_ - kEps) return;
+        if (depth >= 2 && dominated(t, cost)) return;
+
+        // 候选按完工时刻排序（先走最有希望的分支）
+        vector<pair<double,int>> cands;
+        for (int j = 0; j < n_; ++j) {
+            if (scheduled(j)) continue;
+            const double start = max(t, jobs_[j].release);
+            // (1) 另一艘未排的船能在 j 开始前完工：把它插到 j 之前严格更好
+            if ((j == minJob ? secondEnd : minEnd) < start - kEps) continue;
+            const double end = start + jobs_[j].processing;
+            // (2) 与上一艘交换：j 先、last 后时两者完工都不晚且和不大（相同时只保留编号小的在前）
+            if (last >= 0) {
+                const double js = max(prevT, jobs_[j].release), je = js + jobs_[j].processing;
+                const double ls = max(je, jobs_[last].release), le = ls + jobs_[last].processing;
+                if (js <= jobs_[j].latestStart + kEps && ls <= jobs_[last].latestStart + kEps &&
+                    le <= end + kEps && je + le <= t + end + kEps &&
+                    (le < end - kEps || je + le < t + end - kEps || j < last)) {
+                    continue;
+                }
+            }
+            cands.push_back(make_pair(end, j));
+        }
+        sort(cands.begin(), cands.end());
+        for (size_t i = 0; i < cands.size() && !aborted_; ++i) {
+            const int j = cands[i].second;
+            const double end = cands[i].first;
+            if (cost + end >= ub_ - kEps) continue;
+            seq_.push_back(j);
+            flip(j);
+            branch(end, cost + end, t, j);
+            flip(j);
+            seq_.pop_back();
+        }
+    }
+
+    const vector<BerthJob>& jobs_;
+    const SequencingOptions& opts_;
+    const int n_;
+    vector<int> byRelease_;
+    vector<uint64_t> mask_;            // 已排集合的位集
+    vector<int> seq_;
+    vector<int> best_;
+    double ub_ = kInf;
+    long nodes_ = 0;
+    bool aborted_ = false;
+    unordered_map<vector<uint64_t>, vector<Label>, MaskHash> states_;
+    size_t stateCount_ = 0;
+    vector<double> heap_;
+};
+
+} // namespace
+
+bool sequenceBerth(const vector<BerthJob>& jobs, BerthSequence& result, const vector<int>* hint,
+                   const SequencingOptions& opts) {
+    BerthSearch search(jobs, opts);
+    search.initialBounds(hint);
+    search.run();
+    result = BerthSequence();
+    result.nodes = search.nodes();
+    result.optimal = !search.aborted();
+    result.feasible = search.found();
+    if (!result.feasible) return false;
+    result.totalCompletion = search.upperBound();
+    double t = -kInf;
+    for (size_t i = 0; i < search.best().size(); ++i) {
+        const BerthJob& j = jobs[search.best()[i]];
+        const double start = max(t, j.release);
+        result.order.push_back(j.ship);
+        result.start.push_back(start);
+        t = start + j.processing;
+    }
+    return true;
+}
+
+bool sequenceBerths(const ModelParams& params, PortSolution& sol, int threads, const vector<double>* berthFree,
+                    BerthSequencingReport* report, const SequencingOptions& opts) {
+    auto t0 = chrono::steady_clock::now();
+    const int S = params.numShips, B = params.numBerths;
+    // 各泊位的船按当前开始时间排序，该顺序即 hint（恒等排列）
+    vector<vector<BerthJob>> jobs(B);
+    vector<vector<int>> ships(B);
+    for (int s = 0; s < S; ++s) {
+        if (sol.berth[s] >= 0) ships[sol.berth[s]].push_back(s);
+    }
+    vector<int> busy;
+    for (int b = 0; b < B; ++b) {
+        sort(ships[b].begin(), ships[b].end(), [&](int s, int t) { return sol.e[s] < sol.e[t] || (sol.e[s] == sol.e[t] && s < t); });
+        const double free = berthFree ? (*berthFree)[b] : -kInf;
+        for (size_t i = 0; i < ships[b].size(); ++i) {
+            const int s = ships[b][i];
+            BerthJob j;
+            j.ship = s;
+            j.release = max(params.arrivalTime[s], free);
+            j.processing = berthProcessingTime(params, s, b);
+            j.latestStart = params.planningHorizon;
+            jobs[b].push_back(j);
+        }
+        if (!jobs[b].empty()) busy.push_back(b);
+    }
+
+    vector<BerthSequence> results(B);
+    atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next++; i < static_cast<int>(busy.size()); i = next++) {
+            const int b = busy[i];
+            vector<int> hint(jobs[b].size());
+            for (size_t k = 0; k < hint.size(); ++k) hint[k] = static_cast<int>(k);
+            sequenceBerth(jobs[b], results[b], &hint, opts);
+        }
+    };
+    int workers = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    workers = max(1, min(workers, static_cast<int>(busy.size())));
+    vector<thread> pool;
+    for (int t = 1; t < workers; ++t) pool.push_back(thread(worker));
+    worker();
+    for (size_t t = 0; t < pool.size(); ++t) pool[t].join();
+
+    BerthSequencingReport rep;
+    rep.berths = static_cast<int>(busy.size());
+    for (size_t i = 0; i < busy.size(); ++i) {
+        const int b = busy[i];
+        const BerthSequence& r = results[b];
+        rep.nodes += r.nodes;
+        if (!r.feasible) {
+            ++rep.infeasible;
+            continue;
+        }
+        if (r.optimal) ++rep.optimal;
+        for (size_t k = 0; k < r.order.size(); ++k) {
+            sol.e[r.order[k]] = r.start[k];
+            setSerialCompartmentTimes(params, sol, r.order[k]);
+        }
+    }
+    for (int s = 0; s < S; ++s) {
+        if (sol.berth[s] >= 0) rep.berthTime += sol.e[s] - params.arrivalTime[s] + berthProcessingTime(params, s, sol.berth[s]);
+    }
+    rep.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (report) *report = rep;
+    return rep.infeasible == 0;
+}
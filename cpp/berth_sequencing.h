@@ -0,0 +1,65 @@
+#ifndef BERTH_SEQUENCING_H
+#define BERTH_SEQUENCING_H
+
+#include <vector>
+#include <cstddef>
+#include "modelParam.h"
+#include "port_solution.h"
+
+// 固定泊位分配后的单泊位精确排序（不依赖 CPLEX），供启发式、Benders 主问题候选解与 MIP 初始解使用
+//
+// z 确定后各泊位互相独立，每个泊位是带释放时间与开始时间上限的单机排序问题
+//   1 | r_j, e_j <= latestStart_j | sum C_j
+// 目标 sum_s (e_s - tau_s + p_sb) 与 sum C_j 只差常数。求解为深度优先分支定界：
+//   - 初始上界：给定顺序（如当前计划）、最早完工规则、最晚开始时间优先规则，再做相邻交换与插入的局部搜索
+//   - 下界：已排部分 + 剩余船舶从当前时刻起按 SRPT 可中断排序的最优值
+//   - 支配规则：(1) 某未排船能在候选船开始之前完工时不选该候选（活动调度）；
+//              (2) 与上一艘交换后两者的完工时刻都不晚、完工时刻之和不大时剪枝；
+//              (3) 已排集合（位集）相同、当前时刻与已排部分的 sum C 都不优于已记录状态时剪枝（带支配的 DP 状态表）
+// 结点数超过 nodeLimit 时返回当前最好解（optimal = false）。一个泊位上通常只有几艘到十几艘船，
+// 在微秒到毫秒内证明最优。
+
+struct BerthJob {
+    int ship;            // 调用方的编号，原样写入 BerthSequence::order
+    double release;      // 最早开始时间（到达时间，或与泊位可用时刻的较大者）
+    double processing;   // 卸载时长 p_sb
+    double latestStart;  // 开始时间上限（规划期）
+};
+
+struct SequencingOptions {
+    long nodeLimit = 1000000;         // 每个泊位的结点数上限
+    size_t stateLimit = 1 << 20;      // 状态表的记录数上限，超过后不再记录新状态（只减弱剪枝）
+};
+
+struct BerthSequence {
+    bool feasible = false;            // 找到满足全部开始时间上限的顺序
+    bool optimal = false;             // 搜索完成：feasible 时为最优，否则证明了不可行
+    double totalCompletion = 0.0;     // sum C_j
+    std::vector<int> order;           // BerthJob::ship，按开始时间
+    std::vector<double> start;        // 与 order 对应的开始时间（按顺序尽早开始）
+    long nodes = 0;
+};
+
+// 求解单个泊位，找到可行顺序时返回 true
+// hint 非空时为 jobs 下标的一个排列（如当前计划的顺序），作为初始上界：可行时返回的解不比它差
+bool sequenceBerth(const std::vector<BerthJob>& jobs, BerthSequence& result,
+                   const std::vector<int>* hint = 0, const SequencingOptions& opts = SequencingOptions());
+
+struct BerthSequencingReport {
+    int berths = 0;          // 有船的泊位数
+    int optimal = 0;         // 证明最优的泊位数
+    int infeasible = 0;      // 无法在规划期内排完的泊位数（保留原有时间）
+    long nodes = 0;
+    double berthTime = 0.0;  // 排序后的 sum_s (e_s - tau_s + p_sb)
+    double seconds = 0.0;
+};
+
+// 按 sol.berth 逐泊位精确排序，改写 sol.e 与 sol.e_sk（货舱串行卸货），开始时间上限为规划期。
+// 当前时间的先后顺序作为各泊位的初始上界，因此靠泊时间不会变差。
+// 各泊位在 threads 个线程中并行求解（0 表示 hardware_concurrency）；berthFree 非空时泊位 b 在 berthFree[b] 之前不可用。
+// 某泊位无法在规划期内排完时保留它原有的时间；全部泊位可行时返回 true
+bool sequenceBerths(const ModelParams& params, PortSolution& sol, int threads = 1,
+                    const std::vector<double>* berthFree = 0, BerthSequencingReport* report = 0,
+                    const SequencingOptions& opts = SequencingOptions());
+
+#endif // BERTH_SEQUENCING_H
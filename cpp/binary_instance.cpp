@@ -0,0 +1,291 @@
+#include "binary_instance.h"
+#include "csv_loader.h"
+#include "port_solution.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+static_assert(sizeof(BinaryInstanceHeader) == 104, "BinaryInstanceHeader 布局变化时需递增版本号");
+static_assert(sizeof(BinarySection) == 24, "BinarySection 布局变化时需递增版本号");
+
+uint64_t binaryChecksum(const void* data, size_t len, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t h = seed;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * prime;
+        h ^= h >> 29;
+    }
+    for (; i < len; ++i) h = (h ^ p[i]) * prime;
+    return h;
+}
+
+const char* const kInstanceCSVSuffixes[kInstanceCSVCount] = {
+    "_general.csv", "_arrival.csv", "_cargoWeight.csv", "_cargoDensity.csv", "_maxResponseAngle.csv",
+    "_requiredSlots.csv", "_unloadingSpeed.csv", "_transshipmentCost.csv", "_storageCost.csv"
+};
+
+string binaryInstancePath(const string& baseName) {
+    return baseName + ".bin";
+}
+
+// 修改时间精确到纳秒；文件系统的时间戳较粗时，同一时刻写入的 CSV 与 .bin 无法区分先后，按过期处理
+static bool notNewer(const struct stat& a, const struct stat& b) {
+    return a.st_mtim.tv_sec < b.st_mtim.tv_sec || (a.st_mtim.tv_sec == b.st_mtim.tv_sec && a.st_mtim.tv_nsec <= b.st_mtim.tv_nsec);
+}
+
+bool binaryInstanceUpToDate(const string& baseName) {
+    struct stat bin;
+    if (stat(binaryInstancePath(baseName).c_str(), &bin) != 0) return false;
+    for (int i = 0; i < kInstanceCSVCount; ++i) {
+        struct stat csv;
+        if (stat((baseName + kInstanceCSVSuffixes[i]).c_str(), &csv) == 0 && notNewer(bin, csv)) return false;
+    }
+    return true;
+}
+
+namespace {
+
+// 私有可写映射（MAP_PRIVATE 写时复制）：张量视图可以被修改而不影响文件
+struct MappedRegion {
+    void* addr;
+    size_t len;
+    MappedRegion(void* a, size_t l) : addr(a), len(l) {}
+    ~MappedRegion() { munmap(addr, len); }
+};
+
+bool fail(string* error, const string& path, const string& why) {
+    if (error) *error = path + ": " + why;
+    cerr << "[BIN] " << path << ": " << why << endl;
+    return false;
+}
+
+// 张量段：精度一致时零拷贝视图，否则逐元素转换为自有存储
+template <typename Src>
+ParamTensor3 tensorFrom(Src* p, int d0, int d1, int d2, const shared_ptr<const void>& keep) {
+    ParamTensor3 t(d0, d1, d2);
+    for (size_t i = 0; i < t.size(); ++i) t.data()[i] = static_cast<param_t>(p[i]);
+    (void)keep;
+    return t;
+}
+template <>
+ParamTensor3 tensorFrom<param_t>(param_t* p, int d0, int d1, int d2, const shared_ptr<const void>& keep) {
+    return ParamTensor3::view(p, d0, d1, d2, keep);
+}
+
+} // namespace
+
+bool loadParamsFromBinary(const string& path, ModelParams& params, string* error, bool verifyChecksum) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(error, path, "无法打开文件");
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(BinaryInstanceHeader))) {
+        close(fd);
+        return fail(error, path, "文件过小，不是二进制算例");
+    }
+    size_t len = static_cast<size_t>(st.st_size);
+    void* addr = mmap(0, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return fail(error, path, "mmap 失败");
+    shared_ptr<MappedRegion> region(new MappedRegion(addr, len));
+    char* base = static_cast<char*>(addr);
+
+    BinaryInstanceHeader hdr;
+    memcpy(&hdr, base, sizeof(hdr));
+    if (memcmp(hdr.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0) return fail(error, path, "magic 不匹配");
+    if (hdr.byteOrder != kBinaryByteOrder) return fail(error, path, "字节序不匹配");
+    if (hdr.version != kBinaryInstanceVersion) return fail(error, path, "版本不匹配，请重新转换");
+    if (hdr.headerSize != sizeof(BinaryInstanceHeader) || hdr.fileSize != len)
+        return fail(error, path, "文件大小与头部记录不一致");
+    size_t tableEnd = sizeof(hdr) + static_cast<size_t>(hdr.sectionCount) * sizeof(BinarySection);
+    if (hdr.sectionCount != SecCount || tableEnd > len) return fail(error, path, "段表损坏");
+
+    if (verifyChecksum) {
+        BinaryInstanceHeader zeroed = hdr;
+        zeroed.checksum = 0;
+        uint64_t h = binaryChecksum(&zeroed, sizeof(zeroed));
+        h = binaryChecksum(base + sizeof(hdr), len - sizeof(hdr), h);
+        if (h != hdr.checksum) return fail(error, path, "校验和不匹配");
+    }
+
+    const int S = hdr.numShips, B = hdr.numBerths, R = hdr.numRows, V = hdr.numSlotsPerRow, K = hdr.numShipK;
+    if (S < 0 || B < 0 || R < 0 || V < 0 || K < 0) return fail(error, path, "维度非法");
+
+    // 校验每个段的类型、大小与对齐，取出数据地址
+    const uint64_t expected[SecCount + 1] = {
+        0, uint64_t(S), uint64_t(S), uint64_t(S) * K, uint64_t(S) * K, uint64_t(S) * K,
+        uint64_t(S) * B * K, uint64_t(B) * R * V, uint64_t(S) * K * R
+    };
+    char* sec[SecCount + 1] = {0};
+    uint32_t elem[SecCount + 1] = {0};
+    for (uint32_t i = 0; i < hdr.sectionCount; ++i) {
+        BinarySection s;
+        memcpy(&s, base + sizeof(hdr) + i * sizeof(BinarySection), sizeof(s));
+        if (s.id < 1 || s.id > SecCount || sec[s.id]) return fail(error, path, "段编号非法");
+        if (s.count != expected[s.id]) return fail(error, path, "段长度与维度不一致");
+        bool isTensor = s.id >= SecUnloadingSpeed;
+        bool elemOk = isTensor ? (s.elemSize == 8 || s.elemSize == 4)
+                               : (s.elemSize == (s.id == SecRequiredSlots ? 4u : 8u));
+        if (!elemOk) return fail(error, path, "段元素类型非法");
+        if (s.offset % kBinaryAlign != 0 || s.offset < tableEnd || s.offset + s.count * s.elemSize > len)
+            return fail(error, path, "段偏移越界或未对齐");
+        sec[s.id] = base + s.offset;
+        elem[s.id] = s.elemSize;
+    }
+
+    ModelParams p = ModelParams();
+    p.numBerths = B; p.numRows = R; p.numSlotsPerRow = V; p.numShips = S; p.numShipK = K;
+    p.planningHorizon = hdr.planningHorizon;
+    p.width = hdr.width;
+    p.relativeHeight = hdr.relativeHeight;
+    p.alpha = hdr.alpha;
+    p.beta = hdr.beta;
+
+    const double* arrival = reinterpret_cast<const double*>(sec[SecArrivalTime]);
+    const double* weight = reinterpret_cast<const double*>(sec[SecCargoWeight]);
+    const double* density = reinterpret_cast<const double*>(sec[SecCargoDensity]);
+    const double* angle = reinterpret_cast<const double*>(sec[SecMaxResponseAngle]);
+    const int32_t* slots = reinterpret_cast<const int32_t*>(sec[SecRequiredSlots]);
+    p.arrivalTime.assign(arrival, arrival + S);
+    p.cargoWeight.assign(weight, weight + S);
+    p.cargoDensity.resize(S);
+    p.maxResponseAngle.resize(S);
+    p.requiredSlots.resize(S);
+    for (int s = 0; s < S; ++s) {
+        p.cargoDensity[s].assign(density + s * K, density + (s + 1) * K);
+        p.maxResponseAngle[s].assign(angle + s * K, angle + (s + 1) * K);
+        p.requiredSlots[s].assign(slots + s * K, slots + (s + 1) * K);
+    }
+
+    shared_ptr<const void> keep = region;
+    const int shapes[3][3] = { {S, B, K}, {B, R, V}, {S, K, R} };
+    ParamTensor3* targets[3] = { &p.unloadingSpeed, &p.transshipmentCost, &p.storageCost };
+    for (int i = 0; i < 3; ++i) {
+        int id = SecUnloadingSpeed + i;
+        const int* d = shapes[i];
+        if (elem[id] == 8) *targets[i] = tensorFrom(reinterpret_cast<double*>(sec[id]), d[0], d[1], d[2], keep);
+        else *targets[i] = tensorFrom(reinterpret_cast<float*>(sec[id]), d[0], d[1], d[2], keep);
+    }
+
+    params = std::move(p);
+    return true;
+}
+
+bool loadParamsAuto(const string& baseName, ModelParams& params, bool* usedBinary) {
+    bool binary = binaryInstanceUpToDate(baseName)
+                  && loadParamsFromBinary(binaryInstancePath(baseName), params);
+    if (usedBinary) *usedBinary = binary;
+    if (binary) return true;
+    CsvLoadReport report;
+    params = loadParamsFromCSV(baseName, &report);
+    if (!report.ok()) {
+        cerr << "参数文件存在 " << report.badRows << " 处错误: " << baseName << endl;
+        return false;
+    }
+    return true;
+}
+
+// 导出单文件二进制算例（格式见 binary_instance.h）：先写临时文件再 rename，避免批量任务读到半个文件
+bool writeParamsToBinary(const ModelParams& params, const std::string& path) {
+    const size_t slash = path.rfind('/');
+    if (slash != std::string::npos && slash > 0) mkdir_p(path.substr(0, slash));
+    const int S = params.numShips, B = params.numBerths, R = params.numRows;
+    const int V = params.numSlotsPerRow, K = params.numShipK;
+
+    // 各段的元素大小与个数，顺序与 BinarySectionId 一致
+    const uint32_t elemSize[SecCount] = {8, 8, 8, 8, 4, sizeof(param_t), sizeof(param_t), sizeof(param_t)};
+    const uint64_t count[SecCount] = {
+        uint64_t(S), uint64_t(S), uint64_t(S) * K, uint64_t(S) * K, uint64_t(S) * K,
+        params.unloadingSpeed.size(), params.transshipmentCost.size(), params.storageCost.size()
+    };
+    if (count[5] != uint64_t(S) * B * K || count[6] != uint64_t(B) * R * V || count[7] != uint64_t(S) * K * R) {
+        std::cerr << "张量维度与 general 参数不一致，无法写出: " << path << std::endl;
+        return false;
+    }
+
+    BinarySection sections[SecCount];
+    uint64_t offset = sizeof(BinaryInstanceHeader) + sizeof(sections);
+    for (int i = 0; i < SecCount; ++i) {
+        offset = (offset + kBinaryAlign - 1) / kBinaryAlign * kBinaryAlign;
+        sections[i].id = static_cast<uint32_t>(i + 1);
+        sections[i].elemSize = elemSize[i];
+        sections[i].offset = offset;
+        sections[i].count = count[i];
+        offset += count[i] * elemSize[i];
+    }
+    std::vector<char> buf(static_cast<size_t>(offset), 0);
+
+    BinaryInstanceHeader hdr;
+    std::memset(&hdr, 0, sizeof(hdr));
+    std::memcpy(hdr.magic, kBinaryMagic, sizeof(hdr.magic));
+    hdr.version = kBinaryInstanceVersion;
+    hdr.byteOrder = kBinaryByteOrder;
+    hdr.headerSize = sizeof(hdr);
+    hdr.sectionCount = SecCount;
+    hdr.numBerths = B; hdr.numRows = R; hdr.numSlotsPerRow = V; hdr.numShips = S; hdr.numShipK = K;
+    hdr.planningHorizon = params.planningHorizon;
+    hdr.width = params.width;
+    hdr.relativeHeight = params.relativeHeight;
+    hdr.alpha = params.alpha;
+    hdr.beta = params.beta;
+    hdr.fileSize = offset;
+    std::memcpy(&buf[sizeof(hdr)], sections, sizeof(sections));
+
+    // 一维 / 二维数组逐船写入，三维张量整段拷贝
+    double* arrival = reinterpret_cast<double*>(&buf[sections[SecArrivalTime - 1].offset]);
+    double* weight = reinterpret_cast<double*>(&buf[sections[SecCargoWeight - 1].offset]);
+    double* density = reinterpret_cast<double*>(&buf[sections[SecCargoDensity - 1].offset]);
+    double* angle = reinterpret_cast<double*>(&buf[sections[SecMaxResponseAngle - 1].offset]);
+    int32_t* slots = reinterpret_cast<int32_t*>(&buf[sections[SecRequiredSlots - 1].offset]);
+    for (int s = 0; s < S; ++s) {
+        arrival[s] = params.arrivalTime[s];
+        weight[s] = params.cargoWeight[s];
+        for (int k = 0; k < K; ++k) {
+            density[s * K + k] = params.cargoDensity[s][k];
+            angle[s * K + k] = params.maxResponseAngle[s][k];
+            slots[s * K + k] = params.requiredSlots[s][k];
+        }
+    }
+    const ParamTensor3* tensors[3] = { &params.unloadingSpeed, &params.transshipmentCost, &params.storageCost };
+    for (int i = 0; i < 3; ++i) {
+        const BinarySection& sec = sections[SecUnloadingSpeed - 1 + i];
+        if (sec.count) std::memcpy(&buf[sec.offset], tensors[i]->data(), sec.count * sec.elemSize);
+    }
+
+    uint64_t h = binaryChecksum(&hdr, sizeof(hdr));
+    h = binaryChecksum(&buf[sizeof(hdr)], buf.size() - sizeof(hdr), h);
+    hdr.checksum = h;
+    std::memcpy(&buf[0], &hdr, sizeof(hdr));
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream ofs(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            std::cerr << "无法打开文件写入: " << tmp << std::endl;
+            return false;
+        }
+        ofs.write(&buf[0], static_cast<std::streamsize>(buf.size()));
+        if (!ofs) {
+            std::cerr << "写入失败: " << tmp << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cerr << "重命名失败: " << tmp << " -> " << path << ", 错误: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
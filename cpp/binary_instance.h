@@ -0,0 +1,87 @@
+#ifndef BINARY_INSTANCE_H
+#define BINARY_INSTANCE_H
+
+#include "modelParam.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// 单文件二进制算例格式（<baseName>.bin，与 params_output_*.csv 同目录）
+//
+//   [BinaryInstanceHeader][BinarySection x sectionCount][padding][section 0]...[section n-1]
+//
+// - 所有数据段按 kBinaryAlign 字节对齐，mmap 后可直接作为 ModelParams 张量的视图（零拷贝）
+// - checksum 覆盖整个文件（计算时 header.checksum 视为 0）
+// - 格式变化时递增 kBinaryInstanceVersion，旧版本文件会被拒绝（重新运行转换即可）
+const char kBinaryMagic[8] = {'B', 'E', 'R', 'T', 'H', 'B', 'I', 'N'};
+const uint32_t kBinaryInstanceVersion = 1;
+const uint32_t kBinaryByteOrder = 0x01020304u;
+const size_t kBinaryAlign = 64;
+
+enum BinarySectionId {
+    SecArrivalTime = 1,      // double[S]
+    SecCargoWeight,          // double[S]
+    SecCargoDensity,         // double[S*K]
+    SecMaxResponseAngle,     // double[S*K]
+    SecRequiredSlots,        // int32[S*K]
+    SecUnloadingSpeed,       // param[S*B*K]
+    SecTransshipmentCost,    // param[B*R*V]
+    SecStorageCost,          // param[S*K*R]
+    SecCount = SecStorageCost
+};
+
+struct BinaryInstanceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;       // 写入端的 kBinaryByteOrder，读入端不一致即拒绝
+    uint32_t headerSize;      // sizeof(BinaryInstanceHeader)
+    uint32_t sectionCount;
+    int32_t numBerths;
+    int32_t numRows;
+    int32_t numSlotsPerRow;
+    int32_t numShips;
+    int32_t numShipK;
+    int32_t reserved;
+    double planningHorizon;
+    double width;
+    double relativeHeight;
+    double alpha;
+    double beta;
+    uint64_t fileSize;
+    uint64_t checksum;
+};
+
+struct BinarySection {
+    uint32_t id;        // BinarySectionId
+    uint32_t elemSize;  // 元素字节数：double 为 8，float 为 4，int32 为 4
+    uint64_t offset;    // 相对文件开头，kBinaryAlign 对齐
+    uint64_t count;     // 元素个数
+};
+
+// 64 位校验和（逐 8 字节的 FNV-1a 变体），seed 用于分段累计
+uint64_t binaryChecksum(const void* data, size_t len, uint64_t seed = 1469598103934665603ULL);
+
+// 算例的九个 CSV 文件为 <baseName><后缀>
+const int kInstanceCSVCount = 9;
+extern const char* const kInstanceCSVSuffixes[kInstanceCSVCount];
+
+// 二进制文件路径约定：<baseName>.bin
+std::string binaryInstancePath(const std::string& baseName);
+
+// .bin 存在且修改时间（纳秒）晚于全部 9 个 CSV 时返回 true；相同时视为过期（CSV 被修改后需重新转换）
+bool binaryInstanceUpToDate(const std::string& baseName);
+
+// mmap 二进制算例并填充 params：三个张量直接指向映射内存（精度与 param_t 一致时），
+// 其余一维/二维小数组复制到 vector。失败时返回 false 并写入 error（若非空）。
+bool loadParamsFromBinary(const std::string& path, ModelParams& params,
+                          std::string* error = 0, bool verifyChecksum = true);
+
+// 将 ModelParams 写出为单文件二进制算例，可由 loadParamsFromBinary 零拷贝加载。
+// 先写临时文件再 rename，失败时在 cerr 报告并返回 false
+bool writeParamsToBinary(const ModelParams& params, const std::string& path);
+
+// 加载算例：<baseName>.bin 存在且不早于 CSV 时走二进制，否则读 CSV（见 csv_loader.h）
+// CSV 有错误行时返回 false；usedBinary（若非空）返回实际使用的格式
+bool loadParamsAuto(const std::string& baseName, ModelParams& params, bool* usedBinary = 0);
+
+#endif // BINARY_INSTANCE_H
@@ -0,0 +1,344 @@
+#include "csv_loader.h"
+#include <iostream>
+#include <sstream>
+#include <locale>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+const size_t maxErrors = 50; // report 中保留的错误信息上限，计数不受限制
+
+// 只读映射一个文件，析构时自动解除映射
+class MappedFile {
+public:
+    explicit MappedFile(const string& path) : data_(0), size_(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            if (st.st_size > 0) {
+                void* p = mmap(0, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    data_ = static_cast<const char*>(p);
+                    size_ = static_cast<size_t>(st.st_size);
+                    madvise(p, size_, MADV_SEQUENTIAL);
+                }
+            } else {
+                data_ = ""; // 空文件：视为已打开但没有内容
+            }
+        }
+        close(fd);
+    }
+    ~MappedFile() {
+        if (size_ > 0) munmap(const_cast<char*>(data_), size_);
+    }
+    bool isOpen() const { return data_ != 0; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+    const char* data_;
+    size_t size_;
+};
+
+// 10 的整数次幂：在 [0, 22] 内 double 可精确表示（Clinger 快速路径）
+const double kPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// 解析整数，成功时推进 p
+bool parseInt(const char*& p, const char* end, int& out) {
+    const char* q = p;
+    bool neg = false;
+    if (q < end && (*q == '-' || *q == '+')) { neg = (*q == '-'); ++q; }
+    if (q >= end || !isDigit(*q)) return false;
+    long long v = 0;
+    while (q < end && isDigit(*q)) {
+        v = v * 10 + (*q - '0');
+        if (v > 2147483647LL) return false;
+        ++q;
+    }
+    out = static_cast<int>(neg ? -v : v);
+    p = q;
+    return true;
+}
+
+// 慢速路径：数字位数过多或指数过大时，复制到栈缓冲区，用 "C" locale 的流解析
+bool parseDoubleSlow(const char* b, const char* e, double& out) {
+    char buf[64];
+    size_t n = static_cast<size_t>(e - b);
+    if (n == 0 || n >= sizeof(buf)) return false;
+    memcpy(buf, b, n);
+    buf[n] = '\0';
+    istringstream iss(buf);
+    iss.imbue(locale::classic());
+    iss >> out;
+    return !iss.fail() && iss.peek() == char_traits<char>::eof();
+}
+
+// 解析浮点数（[-+]digits[.digits][(e|E)[-+]digits]），成功时推进 p
+// 整数尾数不超过 2^53（可精确表示为 double）且十进制指数在 ±22 内时直接乘/除 10^k，
+// 只做一次舍入，结果与 strtod 一致；其余情况交给 parseDoubleSlow
+bool parseDouble(const char*& p, const char* end, double& out) {
+    const char* start = p;
+    const char* q = p;
+    bool neg = false;
+    if (q < end && (*q == '-' || *q == '+')) { neg = (*q == '-'); ++q; }
+
+    unsigned long long mant = 0;
+    int digits = 0, exp10 = 0;
+    bool any = false;
+    while (q < end && isDigit(*q)) {
+        if (digits < 19) { mant = mant * 10 + static_cast<unsigned>(*q - '0'); if (mant) ++digits; }
+        else ++exp10;
+        any = true; ++q;
+    }
+    if (q < end && *q == '.') {
+        ++q;
+        while (q < end && isDigit(*q)) {
+            if (digits < 19) { mant = mant * 10 + static_cast<unsigned>(*q - '0'); if (mant) ++digits; --exp10; }
+            any = true; ++q;
+        }
+    }
+    if (!any) return false;
+    if (q < end && (*q == 'e' || *q == 'E')) {
+        ++q;
+        int e = 0;
+        if (!parseInt(q, end, e)) return false;
+        exp10 += e;
+    }
+
+    if (digits >= 19 || mant > (1ULL << 53) || exp10 < -22 || exp10 > 22) {
+        if (!parseDoubleSlow(start, q, out)) return false;
+        p = q;
+        return true;
+    }
+    double v = static_cast<double>(mant);
+    v = exp10 < 0 ? v / kPow10[-exp10] : v * kPow10[exp10];
+    out = neg ? -v : v;
+    p = q;
+    return true;
+}
+
+// 逐文件的解析上下文：记录行号并把错误写入 report
+struct CsvFile {
+    string path;
+    MappedFile map;
+    const char* p;
+    int line;
+    CsvLoadReport& report;
+
+    CsvFile(const string& path_, CsvLoadReport& report_)
+        : path(path_), map(path_), p(map.begin()), line(1), report(report_) {
+        if (!map.isOpen()) {
+            error("无法打开文件");
+            return;
+        }
+        ++report.filesRead;
+        skipLine(); // 表头
+    }
+
+    bool isOpen() const { return map.isOpen(); }
+    bool atEnd() const { return p >= map.end(); }
+
+    void skipLine() {
+        const char* e = map.end();
+        const char* nl = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(e - p)));
+        p = nl ? nl + 1 : e;
+        ++line;
+    }
+
+    // 跳过空行（含仅有 '\r' 的行）
+    bool skipBlank() {
+        const char* e = map.end();
+        if (p < e && *p == '\r') {
+            if (p + 1 == e || p[1] == '\n') { p += (p + 1 == e) ? 1 : 2; ++line; return true; }
+        }
+        if (p < e && *p == '\n') { ++p; ++line; return true; }
+        return false;
+    }
+
+    // 行尾：允许 "\r\n"、"\n" 或文件结束
+    bool atEol() const {
+        const char* e = map.end();
+        return p >= e || *p == '\n' || (*p == '\r' && (p + 1 == e || p[1] == '\n'));
+    }
+
+    void error(const string& why) {
+        ++report.badRows;
+        if (report.errors.size() < maxErrors) {
+            ostringstream oss;
+            oss << path << ":" << line << ": " << why;
+            report.errors.push_back(oss.str());
+            cerr << "[CSV] " << report.errors.back() << endl;
+        }
+    }
+};
+
+// 数值为整数且在 int 范围内时写入 out 并返回 true（整数参数不静默截断）
+bool toInt(double value, int& out) {
+    if (value != floor(value) || fabs(value) > INT_MAX) return false;
+    out = static_cast<int>(value);
+    return true;
+}
+
+// 解析 N 个整数下标 + 1 个数值的行（如 "s,b,k,value"），对每一行调用 fn(idx, value)
+// fn 返回 false 表示下标越界或数值无效（如整数参数不是整数），此时记为错误行
+template <int N, typename F>
+void parseIndexedRows(const string& path, CsvLoadReport& report, F fn) {
+    CsvFile f(path, report);
+    if (!f.isOpen()) return;
+    const char* end = f.map.end();
+    while (!f.atEnd()) {
+        if (f.skipBlank()) continue;
+        int idx[N > 0 ? N : 1];
+        double value = 0.0;
+        bool ok = true;
+        int col = 0;
+        for (; col < N && ok; ++col) {
+            ok = parseInt(f.p, end, idx[col]) && f.p < end && *f.p == ',';
+            if (ok) ++f.p;
+        }
+        if (ok) { ok = parseDouble(f.p, end, value) && f.atEol(); ++col; }
+        if (!ok) {
+            ostringstream oss;
+            oss << "第 " << col << " 列格式错误";
+            f.error(oss.str());
+        } else if (!fn(idx, value)) {
+            f.error("下标越界或数值无效");
+        } else {
+            ++report.rowsParsed;
+        }
+        f.skipLine();
+    }
+}
+
+bool keyIs(const char* b, const char* e, const char* key) {
+    size_t n = strlen(key);
+    return static_cast<size_t>(e - b) == n && memcmp(b, key, n) == 0;
+}
+
+// general 文件：key,value
+void parseGeneral(const string& path, ModelParams& params, CsvLoadReport& report) {
+    CsvFile f(path, report);
+    if (!f.isOpen()) return;
+    const char* end = f.map.end();
+    while (!f.atEnd()) {
+        if (f.skipBlank()) continue;
+        const char* keyBegin = f.p;
+        const char* comma = f.p;
+        while (comma < end && *comma != ',' && *comma != '\n') ++comma;
+        if (comma >= end || *comma != ',') { f.error("缺少 ',' 分隔的 value"); f.skipLine(); continue; }
+        f.p = comma + 1;
+        double value = 0.0;
+        if (!parseDouble(f.p, end, value) || !f.atEol()) { f.error("value 格式错误"); f.skipLine(); continue; }
+
+        int* dim = 0;
+        if (keyIs(keyBegin, comma, "numBerths")) dim = &params.numBerths;
+        else if (keyIs(keyBegin, comma, "numRows")) dim = &params.numRows;
+        else if (keyIs(keyBegin, comma, "numSlotsPerRow")) dim = &params.numSlotsPerRow;
+        else if (keyIs(keyBegin, comma, "numShips")) dim = &params.numShips;
+        else if (keyIs(keyBegin, comma, "numShipK")) dim = &params.numShipK;
+        if (dim) {
+            if (!toInt(value, *dim)) {
+                f.error("参数 " + string(keyBegin, comma) + " 必须是整数");
+                f.skipLine();
+                continue;
+            }
+        }
+        else if (keyIs(keyBegin, comma, "planningHorizon")) params.planningHorizon = value;
+        else if (keyIs(keyBegin, comma, "width")) params.width = value;
+        else if (keyIs(keyBegin, comma, "relativeHeight")) params.relativeHeight = value;
+        else if (keyIs(keyBegin, comma, "alpha")) params.alpha = value;
+        else if (keyIs(keyBegin, comma, "beta")) params.beta = value;
+        else { f.error("未知参数名 " + string(keyBegin, comma)); f.skipLine(); continue; }
+        ++report.rowsParsed;
+        f.skipLine();
+    }
+}
+
+} // namespace
+
+ModelParams loadParamsFromCSV(const string& baseName, CsvLoadReport* reportOut) {
+    CsvLoadReport localReport;
+    CsvLoadReport& report = reportOut ? *reportOut : localReport;
+    ModelParams params = ModelParams();
+
+    parseGeneral(baseName + "_general.csv", params, report);
+    if (report.filesRead == 0) {
+        // 没有 general 就无法确定维度，直接返回空参数（调用方根据 report 处理）
+        return params;
+    }
+
+    if (params.numShips <= 0) params.numShips = 0;
+    if (params.numBerths <= 0) params.numBerths = 0;
+    if (params.numRows <= 0) params.numRows = 0;
+    if (params.numSlotsPerRow <= 0) params.numSlotsPerRow = 0;
+    if (params.numShipK <= 0) params.numShipK = 0;
+
+    const int S = params.numShips, K = params.numShipK;
+    params.arrivalTime.assign(S, 0.0);
+    params.cargoWeight.assign(S, 0.0);
+    params.cargoDensity.assign(S, vector<double>(K, 0.0));
+    params.maxResponseAngle.assign(S, vector<double>(K, 0.0));
+    params.requiredSlots.assign(S, vector<int>(K, 0));
+    params.unloadingSpeed.assign(S, params.numBerths, K, 0.0);
+    params.storageCost.assign(S, K, params.numRows, 0.0);
+    params.transshipmentCost.assign(params.numBerths, params.numRows, params.numSlotsPerRow, 0.0);
+
+    parseIndexedRows<1>(baseName + "_arrival.csv", report, [&](const int* i, double v) {
+        if (i[0] < 0 || i[0] >= S) return false;
+        params.arrivalTime[i[0]] = v;
+        return true;
+    });
+    parseIndexedRows<1>(baseName + "_cargoWeight.csv", report, [&](const int* i, double v) {
+        if (i[0] < 0 || i[0] >= S) return false;
+        params.cargoWeight[i[0]] = v;
+        return true;
+    });
+    parseIndexedRows<2>(baseName + "_cargoDensity.csv", report, [&](const int* i, double v) {
+        if (i[0] < 0 || i[0] >= S || i[1] < 0 || i[1] >= K) return false;
+        params.cargoDensity[i[0]][i[1]] = v;
+        return true;
+    });
+    parseIndexedRows<2>(baseName + "_maxResponseAngle.csv", report, [&](const int* i, double v) {
+        if (i[0] < 0 || i[0] >= S || i[1] < 0 || i[1] >= K) return false;
+        params.maxResponseAngle[i[0]][i[1]] = v;
+        return true;
+    });
+    parseIndexedRows<2>(baseName + "_requiredSlots.csv", report, [&](const int* i, double v) {
+        if (i[0] < 0 || i[0] >= S || i[1] < 0 || i[1] >= K) return false;
+        return toInt(v, params.requiredSlots[i[0]][i[1]]);
+    });
+    parseIndexedRows<3>(baseName + "_unloadingSpeed.csv", report, [&](const int* i, double v) {
+        if (!params.unloadingSpeed.inBounds(i[0], i[1], i[2])) return false;
+        params.unloadingSpeed(i[0], i[1], i[2]) = v;
+        return true;
+    });
+    parseIndexedRows<3>(baseName + "_transshipmentCost.csv", report, [&](const int* i, double v) {
+        if (!params.transshipmentCost.inBounds(i[0], i[1], i[2])) return false;
+        params.transshipmentCost(i[0], i[1], i[2]) = v;
+        return true;
+    });
+    parseIndexedRows<3>(baseName + "_storageCost.csv", report, [&](const int* i, double v) {
+        if (!params.storageCost.inBounds(i[0], i[1], i[2])) return false;
+        params.storageCost(i[0], i[1], i[2]) = v;
+        return true;
+    });
+
+    return params;
+}
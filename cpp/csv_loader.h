@@ -0,0 +1,24 @@
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include "modelParam.h"
+#include <string>
+#include <vector>
+
+// 读取 data/example_*/params_output_*.csv 的结果报告
+// 与原 verify.cpp 中静默跳过的做法不同，这里记录每一条无法解析或下标越界的行
+struct CsvLoadReport {
+    int filesRead = 0;                // 成功映射的文件数
+    int rowsParsed = 0;               // 成功写入参数的数据行数
+    int badRows = 0;                  // 格式错误 / 下标越界的行数
+    std::vector<std::string> errors;  // 形如 "<文件>:<行号>: <原因>"，最多保留 maxErrors 条
+
+    bool ok() const { return errors.empty() && badRows == 0; }
+};
+
+// 从 <baseName>_general.csv 等九个文件加载模型参数
+// 每个文件 mmap 后在映射内存上原地解析数字（不构造 std::string，不依赖 locale），
+// 直接写入 ModelParams 的张量/数组。出错的行写入 report（若非空）并输出到 stderr。
+ModelParams loadParamsFromCSV(const std::string& baseName, CsvLoadReport* report = 0);
+
+#endif // CSV_LOADER_H
@@ -1 +1 @@
-clang++ -std=c++17 -stdlib=libc++ -I. data_init.cpp -o data_init_runner
\ No newline at end of file
+clang++ -std=c++17 -stdlib=libc++ -I. data_init.cpp csv_loader.cpp binary_instance.cpp -o data_init_runner
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "data_init.h"
+#include "csv_loader.h"
+#include "binary_instance.h"
 #include <vector>
 #include <string>
 #include <iostream>
@@ -7,10 +9,14 @@
 #include <iomanip>
 #include <cmath>
 #include <random>
+#include <algorithm>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <cerrno>
 #include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <dirent.h>
 
 using namespace std;
 // 简单的 mkdir -p 实现：逐级创建目录
@@ -82,36 +88,30 @@ ModelParams setParams(int numBerths,int numShips) {
     }
 
     // 生成随机卸载速度
-    params.unloadingSpeed.resize(params.numShips);
+    params.unloadingSpeed.assign(params.numShips, params.numBerths, params.numShipK);
     for (int s = 0; s < params.numShips; ++s) {
-        params.unloadingSpeed[s].resize(params.numBerths);
         for (int b = 0; b < params.numBerths; ++b) {
-        params.unloadingSpeed[s][b].resize(params.numShipK);
             for(int k =0;k < params.numShipK;k++){
-                params.unloadingSpeed[s][b][k] = unloadSpeed(gen);  // 为每个船舶-泊位组合生成随机速度
+                params.unloadingSpeed(s,b,k) = unloadSpeed(gen);  // 为每个船舶-泊位组合生成随机速度
             }
         }
     }
     //随机生成 转运成本
-    params.transshipmentCost.resize(params.numBerths);
+    params.transshipmentCost.assign(params.numBerths, params.numRows, params.numSlotsPerRow);
     for(int b = 0; b < params.numBerths ;b++){
-        params.transshipmentCost[b].resize(params.numRows);
         for(int r = 0; r < params.numRows;r++){
-            params.transshipmentCost[b][r].resize(params.numSlotsPerRow);
             for(int v = 0 ; v < params.numSlotsPerRow;v++){
                 //由于程序中 v 是从0开始的 不需要-1
-                params.transshipmentCost[b][r][v] = R(gen) + 0.5*v;
+                params.transshipmentCost(b,r,v) = R(gen) + 0.5*v;
             }
         }
     }
     //同一行对同一艘船存储成本一致
-    params.storageCost.resize(params.numShips);
+    params.storageCost.assign(params.numShips, params.numShipK, params.numRows);
     for(int s = 0; s < params.numShips ; s++){
-        params.storageCost[s].resize(params.numShipK);
         for(int k =0; k<params.numShipK;k++){
-            params.storageCost[s][k].resize(params.numRows);
             for(int r = 0; r < params.numRows;r++){
-                params.storageCost[s][k][r] = saveCos(gen);
+                params.storageCost(s,k,r) = saveCos(gen);
             }   
         }  
     }
@@ -263,10 +263,10 @@ void writeParamsToCSV(const ModelParams& params, const std::string& baseName) {
     {
         std::ofstream ofs(baseName + "_unloadingSpeed.csv");
         ofs << "ship,berth,k,value\n";
-        for (int s = 0; s < (int)params.unloadingSpeed.size(); ++s) {
-            for (int b = 0; b < (int)params.unloadingSpeed[s].size(); ++b) {
-                for (int k = 0; k < (int)params.unloadingSpeed[s][b].size(); ++k) {
-                    ofs << s << "," << b << "," << k << "," << params.unloadingSpeed[s][b][k] << "\n";
+        for (int s = 0; s < params.unloadingSpeed.dim(0); ++s) {
+            for (int b = 0; b < params.unloadingSpeed.dim(1); ++b) {
+                for (int k = 0; k < params.unloadingSpeed.dim(2); ++k) {
+                    ofs << s << "," << b << "," << k << "," << params.unloadingSpeed(s,b,k) << "\n";
                 }
             }
         }
@@ -277,10 +277,10 @@ void writeParamsToCSV(const ModelParams& params, const std::string& baseName) {
     {
         std::ofstream ofs(baseName + "_transshipmentCost.csv");
         ofs << "berth,row,slot,value\n";
-        for (int b = 0; b < (int)params.transshipmentCost.size(); ++b) {
-            for (int r = 0; r < (int)params.transshipmentCost[b].size(); ++r) {
-                for (int v = 0; v < (int)params.transshipmentCost[b][r].size(); ++v) {
-                    ofs << b << "," << r << "," << v << "," << params.transshipmentCost[b][r][v] << "\n";
+        for (int b = 0; b < params.transshipmentCost.dim(0); ++b) {
+            for (int r = 0; r < params.transshipmentCost.dim(1); ++r) {
+                for (int v = 0; v < params.transshipmentCost.dim(2); ++v) {
+                    ofs << b << "," << r << "," << v << "," << params.transshipmentCost(b,r,v) << "\n";
                 }
             }
         }
@@ -291,10 +291,10 @@ void writeParamsToCSV(const ModelParams& params, const std::string& baseName) {
     {
         std::ofstream ofs(baseName + "_storageCost.csv");
         ofs << "ship,k,row,value\n";
-        for (int s = 0; s < (int)params.storageCost.size(); ++s) {
-            for (int k = 0; k < (int)params.storageCost[s].size(); ++k) {
-                for (int r = 0; r < (int)params.storageCost[s][k].size(); ++r) {
-                    ofs << s << "," << k << "," << r << "," << params.storageCost[s][k][r] << "\n";
+        for (int s = 0; s < params.storageCost.dim(0); ++s) {
+            for (int k = 0; k < params.storageCost.dim(1); ++k) {
+                for (int r = 0; r < params.storageCost.dim(2); ++r) {
+                    ofs << s << "," << k << "," << r << "," << params.storageCost(s,k,r) << "\n";
                 }
             }
         }
@@ -302,6 +302,57 @@ void writeParamsToCSV(const ModelParams& params, const std::string& baseName) {
     }
 }
 
+// CSV -> 二进制转换：读入 <baseName>_*.csv，写出 <baseName>.bin，并回读校验
+static bool convertCSVToBinary(const std::string& baseName) {
+    CsvLoadReport report;
+    auto t0 = std::chrono::steady_clock::now();
+    ModelParams params = loadParamsFromCSV(baseName, &report);
+    auto t1 = std::chrono::steady_clock::now();
+    if (!report.ok()) {
+        std::cerr << "CSV 存在错误，跳过: " << baseName << std::endl;
+        return false;
+    }
+    std::string binPath = binaryInstancePath(baseName);
+    if (!writeParamsToBinary(params, binPath)) return false;
+
+    ModelParams check;
+    auto t2 = std::chrono::steady_clock::now();
+    if (!loadParamsFromBinary(binPath, check)) return false;
+    auto t3 = std::chrono::steady_clock::now();
+    bool same = check.numShips == params.numShips && check.arrivalTime == params.arrivalTime
+             && check.requiredSlots == params.requiredSlots
+             && std::memcmp(check.transshipmentCost.data(), params.transshipmentCost.data(),
+                            params.transshipmentCost.size() * sizeof(param_t)) == 0
+             && std::memcmp(check.storageCost.data(), params.storageCost.data(),
+                            params.storageCost.size() * sizeof(param_t)) == 0
+             && std::memcmp(check.unloadingSpeed.data(), params.unloadingSpeed.data(),
+                            params.unloadingSpeed.size() * sizeof(param_t)) == 0;
+    if (!same) {
+        std::cerr << "回读结果与 CSV 不一致: " << binPath << std::endl;
+        return false;
+    }
+    std::cout << binPath << " | CSV 加载 " << std::chrono::duration<double, std::micro>(t1 - t0).count()
+              << " us | 二进制加载 " << std::chrono::duration<double, std::micro>(t3 - t2).count() << " us" << std::endl;
+    return true;
+}
+
+// 列出 dataDir 下所有含 params_output_general.csv 的算例目录
+static std::vector<std::string> discoverCSVInstances(const std::string& dataDir) {
+    std::vector<std::string> bases;
+    DIR* dir = opendir(dataDir.c_str());
+    if (!dir) return bases;
+    while (struct dirent* ent = readdir(dir)) {
+        std::string name = ent->d_name;
+        if (name.compare(0, 8, "example_") != 0) continue;
+        std::string base = dataDir + "/" + name + "/params_output";
+        struct stat st;
+        if (stat((base + "_general.csv").c_str(), &st) == 0) bases.push_back(base);
+    }
+    closedir(dir);
+    std::sort(bases.begin(), bases.end());
+    return bases;
+}
+
 // 合并导出：每行一个 ship，列展开为各个可对应的参数，方便单表分析
 void writeParamsCombinedCSV(const ModelParams& params, const std::string& baseName) {
     // 确保输出目录存在
@@ -394,7 +445,7 @@ void writeParamsCombinedCSV(const ModelParams& params, const std::string& baseNa
         for (int b = 0; b < params.numBerths; ++b) {
             for (int k = 0; k < params.numShipK; ++k) {
                 double v = 0.0;
-                if (s < (int)params.unloadingSpeed.size() && b < (int)params.unloadingSpeed[s].size() && k < (int)params.unloadingSpeed[s][b].size()) v = params.unloadingSpeed[s][b][k];
+                if (params.unloadingSpeed.inBounds(s, b, k)) v = params.unloadingSpeed(s,b,k);
                 put(std::to_string(v));
             }
         }
@@ -403,7 +454,7 @@ void writeParamsCombinedCSV(const ModelParams& params, const std::string& baseNa
         for (int r = 0; r < params.numRows; ++r) {
             for (int k = 0; k < params.numShipK; ++k) {
                 double v = 0.0;
-                if (s < (int)params.storageCost.size() && k < (int)params.storageCost[s].size() && r < (int)params.storageCost[s][k].size()) v = params.storageCost[s][k][r];
+                if (params.storageCost.inBounds(s, k, r)) v = params.storageCost(s,k,r);
                 put(std::to_string(v));
             }
         }
@@ -415,7 +466,21 @@ void writeParamsCombinedCSV(const ModelParams& params, const std::string& baseNa
 }
 
 // 当作独立可执行使用的入口（合并原 data_init_runner 功能）
+// 用法:
+//   data_init_runner [numBerths numShips]          随机生成算例并导出 CSV
+//   data_init_runner --csv2bin [baseName ...]     CSV 转二进制；不给 baseName 时转换 data/ 下全部算例
 int main(int argc, char** argv) {
+    if (argc >= 2 && std::string(argv[1]) == "--csv2bin") {
+        std::vector<std::string> bases(argv + 2, argv + argc);
+        if (bases.empty()) bases = discoverCSVInstances("data");
+        int failed = 0;
+        for (size_t i = 0; i < bases.size(); ++i) {
+            if (!convertCSVToBinary(bases[i])) ++failed;
+        }
+        std::cout << "转换完成: " << (bases.size() - failed) << "/" << bases.size() << std::endl;
+        return failed ? 1 : 0;
+    }
+
     int numBerths = 9;
     int numShips = 50;
     if (argc >= 3) {
@@ -0,0 +1,116 @@
+#include "heuristic.h"
+#include "berth_sequencing.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+vector<int> shipsByArrival(const ModelParams& params) {
+    vector<int> order(params.numShips);
+    for (int s = 0; s < params.numShips; ++s) order[s] = s;
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return params.arrivalTime[a] < params.arrivalTime[b];
+    });
+    return order;
+}
+
+void setSerialCompartmentTimes(const ModelParams& params, PortSolution& sol, int s) {
+    double t = sol.e[s];
+    for (int k = 0; k < params.numShipK; ++k) {
+        sol.e_sk[s][k] = t;
+        t += compartmentDuration(params, s, sol.berth[s], k);
+    }
+}
+
+bool cheapestFreeBlock(const ModelParams& params, const vector<char>& occupied, int s, int k, int b,
+                       int& row, int& start, double& cost) {
+    const int n = params.requiredSlots[s][k];
+    const int V = params.numSlotsPerRow;
+    if (n <= 0 || n > V) return false;
+    const double w = params.cargoWeight[s] / (static_cast<double>(n) * params.numShipK);
+    bool found = false;
+    for (int r = 0; r < params.numRows; ++r) {
+        // 滑动窗口同时维护段内转运成本之和与已占用槽数
+        const param_t* d = params.transshipmentCost.row(b, r);
+        const char* occ = &occupied[static_cast<size_t>(r) * V];
+        double sumD = 0.0;
+        int busy = 0;
+        for (int v = 0; v < n; ++v) { sumD += d[v]; busy += occ[v] ? 1 : 0; }
+        const double storage = n * params.storageCost(s,k,r);
+        for (int j = 0; ; ++j) {
+            if (busy == 0) {
+                double c = w * sumD + storage;
+                if (!found || c < cost) { found = true; cost = c; row = r; start = j; }
+            }
+            if (j + n >= V) break;
+            sumD += d[j + n] - d[j];
+            busy += (occ[j + n] ? 1 : 0) - (occ[j] ? 1 : 0);
+        }
+    }
+    return found;
+}
+
+bool greedySolution(const ModelParams& params, PortSolution& sol, bool* withinHorizon) {
+    return greedySolution(params, sol, vector<double>(params.numBerths, 0.0),
+                          vector<char>(static_cast<size_t>(params.numRows) * params.numSlotsPerRow, 0), withinHorizon);
+}
+
+bool greedySolution(const ModelParams& params, PortSolution& sol,
+                    vector<double> berthFree, vector<char> occupied, bool* withinHorizon) {
+    if (withinHorizon) *withinHorizon = false;
+    const int B = params.numBerths, V = params.numSlotsPerRow;
+    const vector<double> initialFree = berthFree;
+    initSolution(sol, params);
+    vector<int> order = shipsByArrival(params);
+
+    // 1-2. 泊位与时间：最早完工
+    for (size_t i = 0; i < order.size(); ++i) {
+        int s = order[i];
+        int bestB = -1;
+        double bestEnd = 0.0, bestStart = 0.0;
+        for (int b = 0; b < B; ++b) {
+            double start = max(params.arrivalTime[s], berthFree[b]);
+            double end = start + berthProcessingTime(params, s, b);
+            // 优先保证开始时间不超过规划期（e_s 的上界），其次完工最早
+            bool inHorizon = start <= params.planningHorizon;
+            bool bestInHorizon = bestB >= 0 && bestStart <= params.planningHorizon;
+            if (bestB < 0 || (inHorizon && !bestInHorizon) || (inHorizon == bestInHorizon && end < bestEnd)) {
+                bestB = b; bestEnd = end; bestStart = start;
+            }
+        }
+        if (bestB < 0) return false;
+        sol.berth[s] = bestB;
+        sol.e[s] = bestStart;
+        berthFree[bestB] = bestEnd;
+        setSerialCompartmentTimes(params, sol, s);
+    }
+    // 泊位分配不变，各泊位的先后顺序与开始时间改为精确排序的结果（不会变差）；
+    // 排序失败的泊位保留原有时间，其上仍有船超过规划期
+    bool inHorizon = sequenceBerths(params, sol, 0, &initialFree);
+    for (int s = 0; s < params.numShips; ++s) {
+        if (sol.e[s] > params.planningHorizon) {
+            cerr << "[启发式] 船舶 " << s << " 开始时间 " << sol.e[s] << " 超过规划期 " << params.planningHorizon << endl;
+            inHorizon = false;
+        }
+    }
+
+    // 3. 堆场：每个货舱取成本最低的空闲连续段
+    for (size_t i = 0; i < order.size(); ++i) {
+        int s = order[i];
+        for (int k = 0; k < params.numShipK; ++k) {
+            int n = params.requiredSlots[s][k];
+            if (n <= 0) continue;
+            int r = -1, j = -1;
+            double cost = 0.0;
+            if (!cheapestFreeBlock(params, occupied, s, k, sol.berth[s], r, j, cost)) {
+                cerr << "[启发式] 船舶 " << s << " 货舱 " << k << " 找不到 " << n << " 个连续空闲槽" << endl;
+                return false;
+            }
+            placeBlock(sol, s, k, r, j, n);
+            for (int v = j; v < j + n; ++v) occupied[static_cast<size_t>(r) * V + v] = 1;
+        }
+    }
+    if (withinHorizon) *withinHorizon = inHorizon;
+    return true;
+}
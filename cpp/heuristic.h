@@ -0,0 +1,34 @@
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include <vector>
+#include "modelParam.h"
+#include "port_solution.h"
+
+// 贪心构造启发式（不依赖 CPLEX），用于给 MIP 提供初始解（见 addMIPStartFromSolution）
+//   1. 船舶按到达时间排序，依次分配到完工时间 max(到达, 泊位空闲) + 卸载时长 最早的泊位
+//      （优先选择开始时间不超过规划期的泊位）
+//   2. 泊位分配不变，各泊位上的顺序与开始时间由单泊位精确排序重新确定（berth_sequencing.h）；
+//      各货舱按 k 顺序串行卸货（e_sk 连续排列）
+//   3. 按同样的船舶顺序，把每个货舱放到 w_sk * sum d_brv + n_sk * phi_skr 最小的空闲连续槽段
+// 找不到足够的空闲槽段时返回 false（sol 中已放置的部分保留）。
+// 返回 true 只表示 sol 完整（每艘船都有泊位、时间与堆场位置），不表示可行：有泊位无法在规划期内排完时
+// 仍有开始时间 e_s 超过规划期。withinHorizon 非空时写入是否全部 e_s <= 规划期；只有它为 true 时
+// sol 才是可行解（可作为目标值截断或直接采用），否则只能作为需要修复的 MIP 初始解或 ALNS 的起点
+bool greedySolution(const ModelParams& params, PortSolution& sol, bool* withinHorizon = 0);
+// 同上，但泊位 b 在 berthFree[b] 之前不可用、occupied[r*V+v] != 0 的槽已被占用（滚动时域中已冻结的决策）
+bool greedySolution(const ModelParams& params, PortSolution& sol,
+                    std::vector<double> berthFree, std::vector<char> occupied, bool* withinHorizon = 0);
+
+// 货舱按 k 顺序串行卸货：e_sk[s][0] = e_s，之后依次接上一舱的完工时间（需已确定 berth[s]）
+void setSerialCompartmentTimes(const ModelParams& params, PortSolution& sol, int s);
+
+// 船舶 s 停靠泊位 b 时，货舱 k 在空闲槽 occupied[r*V+v] == 0 中成本最低的连续段
+// 找到时写入 row/start/cost 并返回 true
+bool cheapestFreeBlock(const ModelParams& params, const std::vector<char>& occupied, int s, int k, int b,
+                       int& row, int& start, double& cost);
+
+// 船舶按到达时间（相同时按编号）排序
+std::vector<int> shipsByArrival(const ModelParams& params);
+
+#endif // HEURISTIC_H
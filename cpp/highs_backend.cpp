@@ -0,0 +1,107 @@
+#include "highs_backend.h"
+#include <iostream>
+#include <chrono>
+#ifdef PORT_HAVE_HIGHS
+#include "Highs.h"
+#endif
+
+using namespace std;
+
+#ifdef PORT_HAVE_HIGHS
+
+bool highsAvailable() {
+    return true;
+}
+
+// SPARSE_INF 换成 HiGHS 的无穷大
+static double highsBound(double v) {
+    if (v >= SPARSE_INF) return kHighsInf;
+    if (v <= -SPARSE_INF) return -kHighsInf;
+    return v;
+}
+
+bool solveWithHighs(const SparseModel& model, const HighsSolveOptions& opts,
+                    const vector<pair<int,double>>* start, HighsSolveResult& result, ostream& log) {
+    result = HighsSolveResult();
+    if (!model.quad.empty()) {
+        log << "HiGHS 不支持二次目标（乘积形式的转运成本），请使用 --trans=slot 或 --trans=berth" << endl;
+        return false;
+    }
+    auto wallStart = chrono::steady_clock::now();
+
+    const int n = model.numCols();
+    const long m = model.numRows();
+    HighsModel hm;
+    HighsLp& lp = hm.lp_;
+    lp.num_col_ = n;
+    lp.num_row_ = static_cast<HighsInt>(m);
+    lp.sense_ = ObjSense::kMinimize;
+    lp.offset_ = model.objConstant;
+    lp.col_cost_ = model.obj;
+    lp.col_lower_.resize(n);
+    lp.col_upper_.resize(n);
+    lp.integrality_.resize(n);
+    for (int c = 0; c < n; c++) {
+        lp.col_lower_[c] = highsBound(model.colLb[c]);
+        lp.col_upper_[c] = highsBound(model.colUb[c]);
+        lp.integrality_[c] = model.colType[c] == ColBinary ? HighsVarType::kInteger : HighsVarType::kContinuous;
+    }
+    lp.row_lower_.resize(m);
+    lp.row_upper_.resize(m);
+    for (long i = 0; i < m; i++) {
+        lp.row_lower_[i] = highsBound(model.rowLb[i]);
+        lp.row_upper_[i] = highsBound(model.rowUb[i]);
+    }
+    lp.a_matrix_.format_ = MatrixFormat::kRowwise;
+    lp.a_matrix_.num_col_ = n;
+    lp.a_matrix_.num_row_ = static_cast<HighsInt>(m);
+    lp.a_matrix_.start_.assign(model.rowStart.begin(), model.rowStart.end());
+    lp.a_matrix_.index_.assign(model.rowIndex.begin(), model.rowIndex.end());
+    lp.a_matrix_.value_ = model.rowValue;
+
+    Highs highs;
+    highs.setOptionValue("output_flag", opts.log);
+    highs.setOptionValue("time_limit", opts.timeLimit);
+    if (opts.threads > 0) highs.setOptionValue("threads", static_cast<HighsInt>(opts.threads));
+    if (highs.passModel(move(hm)) == HighsStatus::kError) {
+        log << "HiGHS 拒绝了模型" << endl;
+        return false;
+    }
+    if (start) {
+        HighsSolution init;
+        init.col_value.resize(n);
+        for (int c = 0; c < n; c++) init.col_value[c] = model.colLb[c];
+        for (size_t i = 0; i < start->size(); i++) init.col_value[(*start)[i].first] = (*start)[i].second;
+        init.value_valid = true;
+        if (highs.setSolution(init) == HighsStatus::kError) log << "HiGHS 未接受初始解" << endl;
+    }
+
+    if (highs.run() == HighsStatus::kError) {
+        log << "HiGHS 求解出错" << endl;
+        return false;
+    }
+    const HighsInfo& info = highs.getInfo();
+    result.status = highs.modelStatusToString(highs.getModelStatus());
+    result.hasSolution = info.primal_solution_status == kSolutionStatusFeasible;
+    result.objective = info.objective_function_value;
+    result.bound = info.mip_dual_bound;
+    result.gap = info.mip_gap;
+    if (result.hasSolution) result.values = highs.getSolution().col_value;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    return true;
+}
+
+#else
+
+bool highsAvailable() {
+    return false;
+}
+
+bool solveWithHighs(const SparseModel&, const HighsSolveOptions&, const vector<pair<int,double>>*,
+                    HighsSolveResult& result, ostream& log) {
+    result = HighsSolveResult();
+    log << "本程序构建时未找到 HiGHS（CMake find_package(highs)），无法求解" << endl;
+    return false;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef HIGHS_BACKEND_H
+#define HIGHS_BACKEND_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <ostream>
+#include "sparse_model.h"
+
+// 开源 MIP 求解器 HiGHS 的后端：把 SparseModel 整体传给 HiGHS 求解。
+// 只有构建时找到 HiGHS（CMake find_package(highs)，定义 PORT_HAVE_HIGHS）才可用，
+// 否则 solveWithHighs 直接返回 false。HiGHS 不支持二次目标，需使用 --trans=slot 或 --trans=berth。
+struct HighsSolveOptions {
+    double timeLimit = 3600.0;   // 秒
+    int threads = 0;             // 0 表示 HiGHS 默认
+    bool log = true;             // 输出 HiGHS 日志
+};
+
+struct HighsSolveResult {
+    bool hasSolution = false;    // 得到可行解（最优或达到时间限制时的 incumbent）
+    std::string status;          // HiGHS 模型状态
+    double objective = 0.0;
+    double bound = 0.0;          // 最佳界
+    double gap = 0.0;
+    double seconds = 0.0;
+    std::vector<double> values;  // 各列的值（hasSolution 时）
+};
+
+// 本程序是否带有 HiGHS 后端
+bool highsAvailable();
+
+// 求解 model；start 非空时作为初始解（(列, 值)，未给出的列取下界）。
+// 模型无法交给 HiGHS（未启用、含二次目标、HiGHS 报错）时返回 false，原因写到 log
+bool solveWithHighs(const SparseModel& model, const HighsSolveOptions& opts,
+                    const std::vector<std::pair<int,double>>* start, HighsSolveResult& result, std::ostream& log);
+
+#endif // HIGHS_BACKEND_H
@@ -0,0 +1,429 @@
+#include "instance_cache.h"
+#include "binary_instance.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+const char kModelMagic[8] = {'P', 'O', 'R', 'T', 'I', 'R', '0', '1'};
+
+string hex64(uint64_t v) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+    return buf;
+}
+
+bool readFile(const string& path, string& data) {
+    ifstream in(path.c_str(), ios::binary);
+    if (!in) return false;
+    ostringstream os;
+    os << in.rdbuf();
+    data = os.str();
+    return true;
+}
+
+// 先写临时文件再 rename，读者不会看到写了一半的文件
+bool writeFileAtomic(const string& path, const char* data, size_t len) {
+    static atomic<long> counter(0);
+    const string tmp = path + ".tmp" + to_string(getpid()) + "_" + to_string(counter++);
+    {
+        ofstream out(tmp.c_str(), ios::binary | ios::trunc);
+        if (!out) {
+            cerr << "[缓存] 无法写入 " << tmp << endl;
+            return false;
+        }
+        out.write(data, static_cast<streamsize>(len));
+        if (!out) {
+            cerr << "[缓存] 写入失败: " << tmp << endl;
+            return false;
+        }
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        cerr << "[缓存] 重命名失败: " << tmp << " -> " << path << endl;
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool writeFileAtomic(const string& path, const string& data) {
+    return writeFileAtomic(path, data.data(), data.size());
+}
+
+bool exists(const string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// model.ir 的序列化：定长值按原始字节，数组为 uint64 元素个数 + 原始字节
+struct IrWriter {
+    string buf;
+    template <class T> void pod(const T& v) { buf.append(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    template <class T> void vec(const vector<T>& v) {
+        pod(static_cast<uint64_t>(v.size()));
+        if (!v.empty()) buf.append(reinterpret_cast<const char*>(&v[0]), v.size() * sizeof(T));
+    }
+    void str(const string& s) {
+        pod(static_cast<uint64_t>(s.size()));
+        buf.append(s);
+    }
+    void model(const SparseModel& m) {
+        vec(m.colLb); vec(m.colUb); vec(m.colType); vec(m.obj);
+        vec(m.rowStart); vec(m.rowIndex); vec(m.rowValue); vec(m.rowLb); vec(m.rowUb); vec(m.rowFamily);
+        pod(static_cast<uint64_t>(m.rowFamilyNames.size()));
+        for (size_t i = 0; i < m.rowFamilyNames.size(); ++i) str(m.rowFamilyNames[i]);
+        vec(m.quad);
+        pod(m.objConstant);
+    }
+};
+
+struct IrReader {
+    const char* p;
+    const char* end;
+    bool ok = true;
+    IrReader(const char* b, const char* e) : p(b), end(e) {}
+    template <class T> void pod(T& v) {
+        if (!ok || static_cast<size_t>(end - p) < sizeof(T)) { ok = false; return; }
+        memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+    }
+    template <class T> void vec(vector<T>& v) {
+        uint64_t n = 0;
+        pod(n);
+        if (!ok || n > static_cast<uint64_t>(end - p) / sizeof(T)) { ok = false; return; }
+        v.resize(static_cast<size_t>(n));
+        if (n) memcpy(&v[0], p, static_cast<size_t>(n) * sizeof(T));
+        p += n * sizeof(T);
+    }
+    void str(string& s) {
+        uint64_t n = 0;
+        pod(n);
+        if (!ok || n > static_cast<uint64_t>(end - p)) { ok = false; return; }
+        s.assign(p, static_cast<size_t>(n));
+        p += n;
+    }
+    void model(SparseModel& m) {
+        vec(m.colLb); vec(m.colUb); vec(m.colType); vec(m.obj);
+        vec(m.rowStart); vec(m.rowIndex); vec(m.rowValue); vec(m.rowLb); vec(m.rowUb); vec(m.rowFamily);
+        uint64_t families = 0;
+        pod(families);
+        if (!ok || families > 256) { ok = false; return; }
+        m.rowFamilyNames.resize(static_cast<size_t>(families));
+        for (size_t i = 0; i < m.rowFamilyNames.size(); ++i) str(m.rowFamilyNames[i]);
+        vec(m.quad);
+        pod(m.objConstant);
+        // 结构一致性：CSR 与列、行数组的长度
+        ok = ok && m.colUb.size() == m.colLb.size() && m.colType.size() == m.colLb.size() && m.obj.size() == m.colLb.size()
+             && m.rowStart.size() == m.rowLb.size() + 1 && m.rowUb.size() == m.rowLb.size() && m.rowFamily.size() == m.rowLb.size()
+             && m.rowValue.size() == m.rowIndex.size() && m.rowStart.back() == static_cast<long>(m.rowIndex.size());
+    }
+};
+
+// PortIndex 的各列下标数组（顺序即 model.ir 中的顺序）
+template <class Index, class Vec>
+void indexArrays(Index& idx, vector<Vec*>& arrays) {
+    Vec* a[] = {&idx.z, &idx.q, &idx.e, &idx.e_sk, &idx.x, &idx.h, &idx.f, &idx.place, &idx.transSlot,
+                &idx.transBerth, &idx.y, &idx.omega, &idx.lambda, &idx.mu, &idx.order};
+    arrays.assign(a, a + sizeof(a) / sizeof(a[0]));
+}
+
+} // namespace
+
+string formulationKey(const ModelOptions& opts) {
+    ostringstream os;
+    os << "v" << kFormulationVersion << " trans=" << transshipmentFormName(opts.transshipment)
+       << " seq=" << sequencingFormName(opts.sequencing) << " yard=" << yardFormName(opts.yard)
+       << " tighten=" << (opts.tightenBounds ? "on" : "off") << " pair-elim=" << (opts.pairElimination ? "on" : "off")
+       << " lazy-overlap=" << (opts.lazyOverlap ? "on" : "off") << " mipstart=" << (opts.mipStart ? "on" : "off")
+       << " param=" << sizeof(param_t);
+    return os.str();
+}
+
+uint64_t instanceFingerprint(const ModelParams& params, const ModelOptions& opts) {
+    const int32_t dims[5] = {params.numBerths, params.numRows, params.numSlotsPerRow, params.numShips, params.numShipK};
+    const double scalars[5] = {params.planningHorizon, params.width, params.relativeHeight, params.alpha, params.beta};
+    uint64_t h = binaryChecksum(dims, sizeof(dims));
+    h = binaryChecksum(scalars, sizeof(scalars), h);
+    auto vec = [&](const vector<double>& v) {
+        const uint64_t n = v.size();
+        h = binaryChecksum(&n, sizeof(n), h);
+        if (n) h = binaryChecksum(&v[0], n * sizeof(double), h);
+    };
+    vec(params.arrivalTime);
+    vec(params.cargoWeight);
+    for (size_t s = 0; s < params.cargoDensity.size(); ++s) vec(params.cargoDensity[s]);
+    for (size_t s = 0; s < params.maxResponseAngle.size(); ++s) vec(params.maxResponseAngle[s]);
+    for (size_t s = 0; s < params.requiredSlots.size(); ++s) {
+        const vector<int>& v = params.requiredSlots[s];
+        const uint64_t n = v.size();
+        h = binaryChecksum(&n, sizeof(n), h);
+        if (n) h = binaryChecksum(&v[0], n * sizeof(int), h);
+    }
+    const ParamTensor3* tensors[3] = {&params.unloadingSpeed, &params.transshipmentCost, &params.storageCost};
+    for (int i = 0; i < 3; ++i) {
+        const int32_t shape[3] = {tensors[i]->dim(0), tensors[i]->dim(1), tensors[i]->dim(2)};
+        h = binaryChecksum(shape, sizeof(shape), h);
+        if (tensors[i]->size()) h = binaryChecksum(tensors[i]->data(), tensors[i]->size() * sizeof(param_t), h);
+    }
+    const string key = formulationKey(opts);
+    return binaryChecksum(key.data(), key.size(), h);
+}
+
+InstanceCache::InstanceCache(const string& dir) : dir_(dir) {
+    if (dir_.empty()) return;
+    if (!mkdir_p(dir_ + "/sources")) {
+        cerr << "[缓存] 无法创建缓存目录 " << dir_ << "，不使用缓存" << endl;
+        dir_.clear();
+        return;
+    }
+    prune();
+}
+
+string InstanceCache::entryDir(uint64_t fingerprint) const {
+    return dir_ + "/" + hex64(fingerprint);
+}
+
+// 算例文件的原始字节（二进制算例不早于 CSV 时为 .bin，否则为九个 CSV）与 formulationKey 的哈希
+string InstanceCache::sourcePath(const string& base, const ModelOptions& opts) const {
+    vector<string> files;
+    if (binaryInstanceUpToDate(base)) {
+        files.push_back(binaryInstancePath(base));
+    } else {
+        for (int i = 0; i < kInstanceCSVCount; ++i) files.push_back(base + kInstanceCSVSuffixes[i]);
+    }
+    const string key = formulationKey(opts);
+    uint64_t h = binaryChecksum(key.data(), key.size());
+    string data;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!readFile(files[i], data)) return string();
+        const uint64_t n = data.size();
+        h = binaryChecksum(&n, sizeof(n), h);
+        h = binaryChecksum(data.data(), data.size(), h);
+    }
+    return dir_ + "/sources/" + hex64(h);
+}
+
+// 删除建模形式版本不同的条目，以及指向已删除条目的来源记录
+void InstanceCache::prune() const {
+    static const char* files[] = {"meta.txt", "params.bin", "model.ir", "result.txt"};
+    DIR* dir = opendir(dir_.c_str());
+    if (!dir) return;
+    vector<string> stale;
+    while (struct dirent* ent = readdir(dir)) {
+        const string name = ent->d_name;
+        if (name.size() != 16 || name.find_first_not_of("0123456789abcdef") != string::npos) continue;
+        ifstream meta((dir_ + "/" + name + "/meta.txt").c_str());
+        string word;
+        uint32_t version = 0;
+        // 没有 meta 的条目可能正在被另一个进程写入，保留
+        if (meta >> word >> version && word == "version" && version != kFormulationVersion) stale.push_back(name);
+    }
+    closedir(dir);
+    for (size_t i = 0; i < stale.size(); ++i) {
+        const string entry = dir_ + "/" + stale[i];
+        for (size_t f = 0; f < sizeof(files) / sizeof(files[0]); ++f) unlink((entry + "/" + files[f]).c_str());
+        rmdir(entry.c_str());
+    }
+    if (!stale.empty()) cerr << "[缓存] 删除建模形式版本不同的条目 " << stale.size() << " 个" << endl;
+
+    const string sources = dir_ + "/sources";
+    dir = opendir(sources.c_str());
+    if (!dir) return;
+    vector<string> orphans;
+    while (struct dirent* ent = readdir(dir)) {
+        const string name = ent->d_name;
+        if (name.size() != 16) continue;
+        string target;
+        if (readFile(sources + "/" + name, target) && !exists(dir_ + "/" + target.substr(0, 16))) orphans.push_back(name);
+    }
+    closedir(dir);
+    for (size_t i = 0; i < orphans.size(); ++i) unlink((sources + "/" + orphans[i]).c_str());
+}
+
+bool InstanceCache::findParams(const string& base, const ModelOptions& opts, ModelParams& params, uint64_t& fingerprint) const {
+    if (!enabled()) return false;
+    const string source = sourcePath(base, opts);
+    string target;
+    if (source.empty() || !readFile(source, target) || target.size() < 16) return false;
+    fingerprint = strtoull(target.substr(0, 16).c_str(), 0, 16);
+    string error;
+    if (!loadParamsFromBinary(entryDir(fingerprint) + "/params.bin", params, &error)) {
+        cerr << "[缓存] 条目无法读入，重新加载算例: " << error << endl;
+        return false;
+    }
+    return true;
+}
+
+bool InstanceCache::storeParams(const string& base, const ModelOptions& opts, const ModelParams& params,
+                                uint64_t fingerprint) const {
+    if (!enabled()) return false;
+    const string entry = entryDir(fingerprint);
+    if (!mkdir_p(entry)) return false;
+    if (!exists(entry + "/params.bin") && !writeParamsToBinary(params, entry + "/params.bin")) return false;
+    ostringstream meta;
+    meta << "version " << kFormulationVersion << "\nformulation " << formulationKey(opts) << "\nsource " << base
+         << "\nships " << params.numShips << " berths " << params.numBerths << " rows " << params.numRows
+         << " slots " << params.numSlotsPerRow << " holds " << params.numShipK << "\n";
+    if (!writeFileAtomic(entry + "/meta.txt", meta.str())) return false;
+    const string source = sourcePath(base, opts);
+    return !source.empty() && writeFileAtomic(source, hex64(fingerprint) + "\n");
+}
+
+bool InstanceCache::loadModel(uint64_t fingerprint, SparseModel& model, PortIndex& index, SparseModel& lazyRows,
+                              double& objectiveCutoff) const {
+    if (!enabled()) return false;
+    const string path = entryDir(fingerprint) + "/model.ir";
+    string data;
+    if (!readFile(path, data)) return false;
+    if (data.size() < sizeof(kModelMagic) + 2 * sizeof(uint64_t) || memcmp(data.data(), kModelMagic, sizeof(kModelMagic)) != 0) {
+        cerr << "[缓存] 模型文件格式不符: " << path << endl;
+        return false;
+    }
+    uint64_t checksum = 0;
+    memcpy(&checksum, data.data() + data.size() - sizeof(checksum), sizeof(checksum));
+    if (binaryChecksum(data.data(), data.size() - sizeof(checksum)) != checksum) {
+        cerr << "[缓存] 模型文件校验和不符: " << path << endl;
+        return false;
+    }
+    IrReader in(data.data() + sizeof(kModelMagic), data.data() + data.size() - sizeof(checksum));
+    uint32_t version = 0;
+    uint64_t stored = 0;
+    in.pod(version);
+    in.pod(stored);
+    in.pod(objectiveCutoff);
+    if (!in.ok || version != kFormulationVersion || stored != fingerprint) {
+        cerr << "[缓存] 模型文件与条目不符: " << path << endl;
+        return false;
+    }
+    model = SparseModel();
+    lazyRows = SparseModel();
+    index = PortIndex();
+    in.model(model);
+    in.model(lazyRows);
+    in.pod(index.S); in.pod(index.K); in.pod(index.B); in.pod(index.R); in.pod(index.V);
+    vector<vector<int>*> arrays;
+    indexArrays(index, arrays);
+    for (size_t i = 0; i < arrays.size(); ++i) in.vec(*arrays[i]);
+    if (!in.ok || in.p != in.end) {
+        cerr << "[缓存] 模型文件不完整: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+bool InstanceCache::storeModel(uint64_t fingerprint, const SparseModel& model, const PortIndex& index,
+                               const SparseModel& lazyRows, double objectiveCutoff) const {
+    if (!enabled()) return false;
+    IrWriter out;
+    out.buf.append(kModelMagic, sizeof(kModelMagic));
+    out.pod(kFormulationVersion);
+    out.pod(fingerprint);
+    out.pod(objectiveCutoff);
+    out.model(model);
+    out.model(lazyRows);
+    out.pod(index.S); out.pod(index.K); out.pod(index.B); out.pod(index.R); out.pod(index.V);
+    vector<const vector<int>*> arrays;
+    indexArrays(index, arrays);
+    for (size_t i = 0; i < arrays.size(); ++i) out.vec(*arrays[i]);
+    out.pod(binaryChecksum(out.buf.data(), out.buf.size()));
+    return mkdir_p(entryDir(fingerprint)) && writeFileAtomic(entryDir(fingerprint) + "/model.ir", out.buf);
+}
+
+// result.txt：objective / bound 行（没有时为 none），之后每艘船一行 ship s berth e，每个货舱一行 hold s k row e_sk 槽...
+bool InstanceCache::loadResult(uint64_t fingerprint, const ModelParams& params, CachedResult& result) const {
+    result = CachedResult();
+    if (!enabled()) return false;
+    ifstream in((entryDir(fingerprint) + "/result.txt").c_str());
+    if (!in) return false;
+    string key, value;
+    if (!(in >> key >> value) || key != "objective") return false;
+    result.haveSolution = value != "none";
+    if (result.haveSolution) result.objective = atof(value.c_str());
+    if (!(in >> key >> value) || key != "bound") return false;
+    result.haveBound = value != "none";
+    if (result.haveBound) result.bound = atof(value.c_str());
+    if (!result.haveSolution) return true;
+
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths, R = params.numRows, V = params.numSlotsPerRow;
+    PortSolution& sol = result.solution;
+    initSolution(sol, params);
+    string line;
+    getline(in, line);
+    bool ok = true;
+    while (ok && getline(in, line)) {
+        istringstream row(line);
+        string kind;
+        int s = -1;
+        if (!(row >> kind >> s) || s < 0 || s >= S) { ok = false; break; }
+        if (kind == "ship") {
+            ok = static_cast<bool>(row >> sol.berth[s] >> sol.e[s]) && sol.berth[s] >= -1 && sol.berth[s] < B;
+        } else if (kind == "hold") {
+            int k = -1, r = -1, v;
+            double esk = 0;
+            ok = (row >> k >> r >> esk) && k >= 0 && k < K && r >= -1 && r < R;
+            if (!ok) break;
+            sol.row[s][k] = r;
+            sol.e_sk[s][k] = esk;
+            while (row >> v) {
+                if (v < 0 || v >= V) { ok = false; break; }
+                sol.slots[s][k].push_back(v);
+            }
+        } else {
+            ok = false;
+        }
+    }
+    if (!ok) {
+        cerr << "[缓存] 解文件格式不符，忽略: " << entryDir(fingerprint) << "/result.txt" << endl;
+        result.haveSolution = false;
+    }
+    return true;
+}
+
+bool InstanceCache::storeResult(uint64_t fingerprint, const ModelParams& params, const CachedResult& result) const {
+    if (!enabled()) return false;
+    CachedResult merged;
+    loadResult(fingerprint, params, merged);
+    bool changed = false;
+    if (result.haveSolution && (!merged.haveSolution || result.objective < merged.objective)) {
+        merged.haveSolution = true;
+        merged.solution = result.solution;
+        merged.objective = result.objective;
+        changed = true;
+    }
+    if (result.haveBound && (!merged.haveBound || result.bound > merged.bound)) {
+        merged.haveBound = true;
+        merged.bound = result.bound;
+        changed = true;
+    }
+    if (!changed) return true;
+
+    ostringstream out;
+    out.precision(17);
+    out << "objective ";
+    if (merged.haveSolution) out << merged.objective; else out << "none";
+    out << "\nbound ";
+    if (merged.haveBound) out << merged.bound; else out << "none";
+    out << "\n";
+    if (merged.haveSolution) {
+        const PortSolution& sol = merged.solution;
+        for (int s = 0; s < params.numShips; ++s) {
+            out << "ship " << s << " " << sol.berth[s] << " " << sol.e[s] << "\n";
+            for (int k = 0; k < params.numShipK; ++k) {
+                out << "hold " << s << " " << k << " " << sol.row[s][k] << " " << sol.e_sk[s][k];
+                for (size_t i = 0; i < sol.slots[s][k].size(); ++i) out << " " << sol.slots[s][k][i];
+                out << "\n";
+            }
+        }
+    }
+    return mkdir_p(entryDir(fingerprint)) && writeFileAtomic(entryDir(fingerprint) + "/result.txt", out.str());
+}
@@ -0,0 +1,70 @@
+#ifndef INSTANCE_CACHE_H
+#define INSTANCE_CACHE_H
+
+#include <string>
+#include <cstdint>
+#include "modelParam.h"
+#include "model_options.h"
+#include "port_solution.h"
+#include "sparse_model.h"
+#include "port_ir.h"
+
+// 按算例指纹的磁盘缓存（--cache=目录）：相同或重复运行的算例跳过 CSV 解析与建模，并从已知最好的解开始求解。
+//
+// 指纹为 ModelParams 的全部内容与影响模型的选项（formulationKey）的 64 位哈希，每个指纹一个条目目录：
+//   <dir>/<指纹>/meta.txt     建模形式版本、formulationKey、算例来源（便于人工查看）
+//   <dir>/<指纹>/params.bin   参数（二进制算例格式，mmap 加载，见 binary_instance.h）
+//   <dir>/<指纹>/model.ir     buildPortIR 生成的稀疏模型、列下标、延迟约束与建模时的目标值截断
+//   <dir>/<指纹>/result.txt   已知最好的解及其目标值、最佳界
+//   <dir>/sources/<键>        算例文件（.bin 或九个 CSV）原始字节与选项的哈希 -> 指纹，命中时不必解析 CSV
+// 各文件先写临时文件再 rename；并发运行同一算例时 result.txt 以最后写入者为准（各自都只写更好的解）。
+//
+// 建模形式版本 kFormulationVersion 计入指纹：port_ir / model_bounds 生成的模型变化时递增，
+// 旧条目不再命中，并在下一次打开缓存时删除。
+
+const uint32_t kFormulationVersion = 1;
+
+// 影响所建模型的选项（转运成本 / 先后关系 / 堆场形式、tighten、pair-elim、lazy-overlap、mipstart）与版本组成的文本
+std::string formulationKey(const ModelOptions& opts);
+// ModelParams 全部内容与 formulationKey 的 64 位指纹
+uint64_t instanceFingerprint(const ModelParams& params, const ModelOptions& opts);
+
+// 条目中记录的最好解与最佳界
+struct CachedResult {
+    bool haveSolution = false;
+    PortSolution solution;
+    double objective = 0.0;   // weightedObjective(evaluateShipCosts(solution))
+    bool haveBound = false;
+    double bound = 0.0;
+};
+
+class InstanceCache {
+public:
+    // dir 为空时不启用（各函数返回 false）；启用时删除建模形式版本不同的条目
+    explicit InstanceCache(const std::string& dir);
+
+    bool enabled() const { return !dir_.empty(); }
+
+    // 按 base 的算例文件内容与 opts 查找条目，命中时从条目读入参数并返回其指纹
+    bool findParams(const std::string& base, const ModelOptions& opts, ModelParams& params, uint64_t& fingerprint) const;
+    // 写入条目的参数与 meta，并把 base 当前的文件内容（与 opts）登记为该条目
+    bool storeParams(const std::string& base, const ModelOptions& opts, const ModelParams& params, uint64_t fingerprint) const;
+
+    bool loadModel(uint64_t fingerprint, SparseModel& model, PortIndex& index, SparseModel& lazyRows, double& objectiveCutoff) const;
+    bool storeModel(uint64_t fingerprint, const SparseModel& model, const PortIndex& index, const SparseModel& lazyRows,
+                    double objectiveCutoff) const;
+
+    // 没有记录时返回 false；记录的解与 params 的维度不一致时只读入界
+    bool loadResult(uint64_t fingerprint, const ModelParams& params, CachedResult& result) const;
+    // 与已有记录合并：解只在目标值更好时替换，界取较大者
+    bool storeResult(uint64_t fingerprint, const ModelParams& params, const CachedResult& result) const;
+
+private:
+    std::string entryDir(uint64_t fingerprint) const;
+    std::string sourcePath(const std::string& base, const ModelOptions& opts) const;
+    void prune() const;
+
+    std::string dir_;
+};
+
+#endif // INSTANCE_CACHE_H
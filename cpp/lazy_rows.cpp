@@ -0,0 +1,92 @@
+#include "lazy_rows.h"
+
+using namespace std;
+
+LazyRowCallback::LazyRowCallback(IloEnv env, const SparseModel& rows, const IloNumVarArray& cols)
+    : env_(env), rows_(rows), cols_(cols), used_(env), ranges_(rows.numRows()) {
+    // 只取 rows 涉及的列（e、z 与先后关系变量），候选解的读取量与模型总列数无关
+    vector<int> pos(cols.getSize(), -1);
+    for (long p = 0; p < rows.numNonzeros(); p++) pos[rows.rowIndex[p]] = 0;
+    for (size_t c = 0; c < pos.size(); c++) {
+        if (pos[c] < 0) continue;
+        pos[c] = static_cast<int>(used_.getSize());
+        used_.add(cols[static_cast<IloInt>(c)]);
+    }
+    local_.resize(rows.numNonzeros());
+    for (long p = 0; p < rows.numNonzeros(); p++) local_[p] = pos[rows.rowIndex[p]];
+}
+
+LazyRowCallback::~LazyRowCallback() {
+    used_.end();
+}
+
+void LazyRowCallback::invoke(const IloCplex::Callback::Context& context) {
+    if (!context.inCandidate() || !context.isCandidatePoint()) return;
+    // Concert 对象的创建与释放不是线程安全的，统一在锁内进行；候选值的读取与行的检查在锁外
+    IloNumArray vals;
+    {
+        lock_guard<mutex> lock(mutex_);
+        vals = IloNumArray(env_);
+    }
+    context.getCandidatePoint(used_, vals);
+    vector<long> violated;
+    for (long i = 0; i < rows_.numRows(); i++) {
+        double act = 0;
+        for (long p = rows_.rowStart[i]; p < rows_.rowStart[i + 1]; p++) act += rows_.rowValue[p] * vals[local_[p]];
+        if (act > rows_.rowUb[i] + 1e-6 || act < rows_.rowLb[i] - 1e-6) violated.push_back(i);
+    }
+
+    unique_lock<mutex> lock(mutex_);
+    vals.end();
+    if (violated.empty()) return;
+    IloRangeArray cuts(env_);
+    for (size_t k = 0; k < violated.size(); k++) {
+        const long i = violated[k];
+        if (!ranges_[i].getImpl()) {
+            IloNumVarArray vars(env_);
+            IloNumArray coefs(env_);
+            for (long p = rows_.rowStart[i]; p < rows_.rowStart[i + 1]; p++) {
+                vars.add(cols_[rows_.rowIndex[p]]);
+                coefs.add(rows_.rowValue[p]);
+            }
+            ranges_[i] = IloRange(env_, rows_.rowLb[i], rows_.rowUb[i]);
+            ranges_[i].setLinearCoefs(vars, coefs);
+            vars.end();
+            coefs.end();
+            ++added_;
+        }
+        cuts.add(ranges_[i]);
+    }
+    ++rejections_;
+    lock.unlock();
+    context.rejectCandidate(cuts);
+    lock.lock();
+    cuts.end();
+}
+
+long LazyRowCallback::rowsAdded() const {
+    lock_guard<mutex> lock(mutex_);
+    return added_;
+}
+
+long LazyRowCallback::rejections() const {
+    lock_guard<mutex> lock(mutex_);
+    return rejections_;
+}
+
+void CallbackChain::add(IloCplex::Callback::Function* fn, CPXLONG contextMask) {
+    fns_.push_back(fn);
+    masks_.push_back(contextMask);
+}
+
+CPXLONG CallbackChain::contextMask() const {
+    CPXLONG mask = 0;
+    for (size_t i = 0; i < masks_.size(); i++) mask |= masks_[i];
+    return mask;
+}
+
+void CallbackChain::invoke(const IloCplex::Callback::Context& context) {
+    for (size_t i = 0; i < fns_.size(); i++) {
+        if (masks_[i] & context.getId()) fns_[i]->invoke(context);
+    }
+}
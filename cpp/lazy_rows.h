@@ -0,0 +1,56 @@
+#ifndef LAZY_ROWS_H
+#define LAZY_ROWS_H
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <mutex>
+#include "sparse_model.h"
+
+// 延迟约束（Candidate 回调）：rows 中的行不在初始模型里，CPLEX 每得到一个整数候选解时
+// 计算各行的值，违反的行（超出上下界 1e-6）随 rejectCandidate 加入，候选解被拒绝。
+// 港口模型用于同泊位不重叠约束（--lazy-overlap，见 ModelOptions::lazyOverlap 与 buildPortIR 的 lazyRows）：
+// 它们有 O(S^2 B) 行，但只有同一泊位上时间相邻的船对才会起作用。
+//
+// 只读取 rows 涉及的列的候选值；各行的 IloRange 在第一次违反时创建，之后各线程共用（加锁）。
+// 用法：cplex.use(&lazy, IloCplex::Callback::Context::Id::Candidate)（与其它回调同时使用见 CallbackChain）
+class LazyRowCallback : public IloCplex::Callback::Function {
+public:
+    // cols 为模型的全部列（下标同 rows 中的列下标）；rows 与 cols 须在回调使用期间保持有效
+    LazyRowCallback(IloEnv env, const SparseModel& rows, const IloNumVarArray& cols);
+    ~LazyRowCallback();
+
+    void invoke(const IloCplex::Callback::Context& context);
+
+    long poolRows() const { return rows_.numRows(); }
+    // 至少被加入过一次的不同行数，以及被拒绝的候选解个数
+    long rowsAdded() const;
+    long rejections() const;
+
+private:
+    IloEnv env_;
+    const SparseModel& rows_;
+    IloNumVarArray cols_;
+    IloNumVarArray used_;             // rows 涉及的列（按列下标升序）
+    std::vector<int> local_;          // rows 的每个非零元在 used_ 中的位置
+
+    mutable std::mutex mutex_;
+    std::vector<IloRange> ranges_;    // 已创建的行，未创建为空句柄
+    long added_ = 0;
+    long rejections_ = 0;
+};
+
+// 把多个通用回调组合为一个（同一个 IloCplex 只能使用一个通用回调）：
+// 按登记顺序调用所登记的 context 包含当前 context 的回调
+class CallbackChain : public IloCplex::Callback::Function {
+public:
+    void add(IloCplex::Callback::Function* fn, CPXLONG contextMask);
+    // 全部回调的 context 之并，用于 cplex.use(&chain, chain.contextMask())
+    CPXLONG contextMask() const;
+    void invoke(const IloCplex::Callback::Context& context);
+
+private:
+    std::vector<IloCplex::Callback::Function*> fns_;
+    std::vector<CPXLONG> masks_;
+};
+
+#endif // LAZY_ROWS_H
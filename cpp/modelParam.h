@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include "tensor.h"
 using namespace std;
 // 模型参数结构体
 struct ModelParams {
@@ -16,10 +17,10 @@ struct ModelParams {
     //船的船舱个数
     int numShipK;
     
-    // 模型参数
-    vector<vector<vector<double>>> unloadingSpeed;  // 卸载速度 p_sbk
-    vector<vector<vector<double>>> transshipmentCost; // 转运成本 d_brv
-    vector<vector<vector<double>>> storageCost;       // 存储成本 phi_skrv. //
+    // 模型参数（三维参数使用连续存储的张量，按 (i,j,k) 访问）
+    ParamTensor3 unloadingSpeed;    // 卸载速度 p_sbk，形状 [S][B][K]
+    ParamTensor3 transshipmentCost; // 转运成本 d_brv，形状 [B][R][V]
+    ParamTensor3 storageCost;       // 存储成本 phi_skr，形状 [S][K][R]
     vector<double> arrivalTime;        // 到达时间 tau_s
     vector<double> cargoWeight;        // 货物重量 gamma_s
     vector<vector<double>> cargoDensity;       // 货物密度 rho_s_k
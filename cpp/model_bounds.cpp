@@ -0,0 +1,175 @@
+#include "model_bounds.h"
+#include <algorithm>
+#include "sparse_model.h"
+#include "port_solution.h"
+
+using namespace std;
+
+// 原始模型的常数
+static const double LEGACY_HOLD_M = 10000.0;
+static const double LEGACY_OVERLAP_EXTRA = 150000.0;
+
+static double slotWeight(const ModelParams& params, int s, int k) {
+    return params.cargoWeight[s] / (params.requiredSlots[s][k] * params.numShipK);
+}
+
+double shipCostLowerBound(const ModelParams& params, int s) {
+    const int K = params.numShipK, B = params.numBerths, R = params.numRows, V = params.numSlotsPerRow;
+    double best = -1;
+    for (int b = 0; b < B; b++) {
+        double cost = params.beta * berthProcessingTime(params, s, b);
+        for (int k = 0; k < K; k++) {
+            const int n = params.requiredSlots[s][k];
+            if (n <= 0 || n > V) continue;
+            const double w = slotWeight(params, s, k);
+            // 各行最便宜的连续 n 槽（滑动窗口）加该行的存储成本
+            double block = -1;
+            for (int r = 0; r < R; r++) {
+                const param_t* d = params.transshipmentCost.row(b, r);
+                double sum = 0, low = 0;
+                for (int v = 0; v < V; v++) {
+                    sum += d[v];
+                    if (v >= n) sum -= d[v - n];
+                    if (v == n - 1 || (v >= n && sum < low)) low = sum;
+                }
+                const double c = w * low + n * params.storageCost(s, k, r);
+                if (block < 0 || c < block) block = c;
+            }
+            if (block >= 0) cost += params.alpha * block;
+        }
+        if (best < 0 || cost < best) best = cost;
+    }
+    return max(best, 0.0);
+}
+
+PortBounds::PortBounds(const ModelParams& params, const ModelOptions& opts)
+    : tighten_(opts.tightenBounds), pairElim_(opts.pairElimination), K_(params.numShipK), B_(params.numBerths),
+      horizon_(params.planningHorizon), tau_(params.arrivalTime) {
+    const int S = params.numShips;
+    // 目标值截断：任一目标值不超过 cutoff 的解都满足 beta (e_s - tau_s) <= cutoff - sum_t LB_t
+    latest_.assign(S, horizon_);
+    if (tighten_ && opts.objectiveCutoff > 0 && opts.yard != YardNone && params.beta > 0) {
+        double lb = 0;
+        for (int s = 0; s < S; s++) lb += shipCostLowerBound(params, s);
+        // 相对与绝对容差，保证给出 cutoff 的解本身（如 MIP 初始解）不被截掉
+        const double slack = max(0.0, (opts.objectiveCutoff * (1 + 1e-9) + 1e-6 - lb) / params.beta);
+        for (int s = 0; s < S; s++) latest_[s] = max(tau_[s], min(horizon_, tau_[s] + slack));
+    }
+    duration_.resize(static_cast<size_t>(S) * B_ * K_);
+    proc_.assign(static_cast<size_t>(S) * B_, 0.0);
+    eskUb_.assign(static_cast<size_t>(S) * K_, -SPARSE_INF);
+    for (int s = 0; s < S; s++) {
+        for (int b = 0; b < B_; b++) {
+            for (int k = 0; k < K_; k++) {
+                duration_[(s * B_ + b) * K_ + k] = compartmentDuration(params, s, b, k);
+                proc_[s * B_ + b] += duration(s, b, k);
+            }
+        }
+        for (int k = 0; k < K_; k++) {
+            double& ub = eskUb_[s * K_ + k];
+            for (int b = 0; b < B_; b++) ub = max(ub, latest_[s] + processing(s, b) - duration(s, b, k));
+            if (B_ == 0) ub = latest_[s];
+        }
+    }
+}
+
+double PortBounds::eskUb(int s, int k) const {
+    return tighten_ ? eskUb_[s * K_ + k] : SPARSE_INF;
+}
+
+double PortBounds::holdOrderM(int s, int k, int b) const {
+    if (!tighten_) return LEGACY_HOLD_M;
+    // e_sk - e_st 最大为 ub(e_sk) - tau_s，未激活时需要 M - d_skb 不小于它
+    return eskUb_[s * K_ + k] - tau_[s] + duration(s, b, k);
+}
+
+double PortBounds::overlapM(int s, int t, int b) const {
+    if (!tighten_) return horizon_ + LEGACY_OVERLAP_EXTRA;
+    // e_s + p_sb - e_t 最大为 latestStart(s) + p_sb - tau_t；不大于 0 时该行恒成立
+    return max(0.0, latest_[s] + processing(s, b) - tau_[t]);
+}
+
+PairRelation PortBounds::pairRelation(int s, int t, int b) const {
+    if (!pairElim_) return PairConflict;
+    const double ps = processing(s, b), pt = processing(t, b);
+    // 一方最晚结束不晚于另一方到达：先后已定
+    if (latest_[s] + ps <= tau_[t] || latest_[t] + pt <= tau_[s]) return PairOrdered;
+    // s 在 t 之前时 t 最早在 tau_s + p_sb 开始，须不晚于 latestStart(t)；反之亦然
+    const bool st = tau_[s] + ps <= latest_[t], ts = tau_[t] + pt <= latest_[s];
+    if (st && ts) return PairConflict;
+    if (st) return PairFirstBefore;
+    if (ts) return PairSecondBefore;
+    return PairExcluded;
+}
+
+bool PortBounds::pairNeedsOrder(int s, int t) const {
+    if (s > t) std::swap(s, t);
+    for (int b = 0; b < B_; b++) {
+        if (pairRelation(s, t, b) == PairConflict) return true;
+    }
+    return false;
+}
+
+// 平均值与最大值
+struct MStats {
+    long n = 0;
+    double sum = 0, max = 0;
+    void add(double v) {
+        n++;
+        sum += v;
+        if (v > max) max = v;
+    }
+    double mean() const { return n ? sum / n : 0.0; }
+};
+
+void printBoundReport(ostream& os, const ModelParams& params, const ModelOptions& opts) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    ModelOptions legacyOpts = opts;
+    legacyOpts.tightenBounds = false;
+    PortBounds legacy(params, legacyOpts), bounds(params, opts);
+    MStats hold, overlap, esk, es;
+    long redundant = 0;
+    for (int s = 0; s < S; s++) {
+        es.add(bounds.latestStart(s));
+        for (int k = 0; k < K; k++) {
+            esk.add(bounds.eskUb(s, k));
+            for (int b = 0; b < B; b++) hold.add(bounds.holdOrderM(s, k, b));
+        }
+        for (int t = 0; t < S; t++) {
+            if (s == t) continue;
+            for (int b = 0; b < B; b++) {
+                const double M = bounds.overlapM(s, t, b);
+                overlap.add(M);
+                if (M == 0) redundant++;
+            }
+        }
+    }
+    os << "big-M 与变量上界（--tighten=" << (opts.tightenBounds ? "on" : "off") << "）:" << endl;
+    os << "  货舱顺序 M: 平均 " << hold.mean() << ", 最大 " << hold.max
+       << "（原始 " << legacy.holdOrderM(0, 0, 0) << "）" << endl;
+    os << "  不重叠 M: 平均 " << overlap.mean() << ", 最大 " << overlap.max
+       << "（原始 " << legacy.overlapM(0, 0, 0) << "）, 恒成立的 (s,t,b) " << redundant << " / " << overlap.n << endl;
+    if (opts.tightenBounds) {
+        os << "  e_s 上界: 平均 " << es.mean() << ", 最大 " << es.max << "（规划期 " << params.planningHorizon;
+        if (opts.objectiveCutoff > 0) os << "，目标值截断 " << opts.objectiveCutoff;
+        os << "）" << endl;
+        os << "  e_sk 上界: 平均 " << esk.mean() << ", 最大 " << esk.max << "（原始无上界）" << endl;
+    } else {
+        os << "  e_sk 上界: 无" << endl;
+    }
+
+    // 船对关系（--pair-elim）：(s < t, b) 按关系计数，以及仍需要先后变量的船对
+    long counts[PairConflict + 1] = {0, 0, 0, 0, 0};
+    long ordered = 0, pairs = 0;
+    for (int s = 0; s < S; s++) {
+        for (int t = s + 1; t < S; t++) {
+            pairs++;
+            if (bounds.pairNeedsOrder(s, t)) ordered++;
+            for (int b = 0; b < B; b++) counts[bounds.pairRelation(s, t, b)]++;
+        }
+    }
+    os << "船对消去（--pair-elim=" << (opts.pairElimination ? "on" : "off") << "）: (s,t,b) 先后已定 "
+       << counts[PairOrdered] << ", 互斥 " << counts[PairExcluded] << ", 单向 "
+       << counts[PairFirstBefore] + counts[PairSecondBefore] << ", 冲突 " << counts[PairConflict]
+       << "；需要先后变量的船对 " << ordered << " / " << pairs << endl;
+}
@@ -0,0 +1,71 @@
+#ifndef MODEL_BOUNDS_H
+#define MODEL_BOUNDS_H
+
+#include <vector>
+#include <ostream>
+#include "modelParam.h"
+#include "model_options.h"
+
+// 同泊位船对 (s,t)（s < t）在泊位 b 上的关系，由开始时间窗 [tau, latestStart] 与处理时长推出
+enum PairRelation {
+    PairOrdered,        // 时间窗已决定先后（一个最晚结束不晚于另一个到达），同泊位也不需要任何约束
+    PairExcluded,       // 两种先后都放不进时间窗：不能同在泊位 b（z_sb + z_tb <= 1）
+    PairFirstBefore,    // 只可能 s 在 t 之前：一条不重叠约束，不需要先后变量
+    PairSecondBefore,   // 只可能 t 在 s 之前
+    PairConflict        // 两种先后都可能：需要先后变量与两条不重叠约束
+};
+
+// 模型中的 big-M、变量上界与船对关系（buildPortIR 使用）。
+//
+// 每艘船的最晚开始时间 latestStart(s) 默认为规划期 H。opts.objectiveCutoff > 0（已知可行解的目标值，
+// 如贪心初始解）且 tightenBounds 时，由 beta (e_s - tau_s) <= cutoff - sum_t LB_t 进一步收紧，
+// LB_t 为船 t 的靠泊时长与堆场成本（忽略槽位冲突）的下界：只去掉比该可行解差的解（Benders 主问题不使用）。
+//
+// tightenBounds = true（默认）时 big-M 与 e_sk 上界由到达时间 tau_s、各泊位的货舱卸货时长 d_skb /
+// 总处理时长 p_sb 与 latestStart 逐行推出：
+//   e_s <= latestStart(s)，e_sk <= latestStart(s) + max_b (p_sb - d_skb)（按货舱顺序依次卸货时的最晚开始）
+//   货舱顺序行 e_sk - e_st + M q_skt + M z_sb <= 2M - d_skb：M = ub(e_sk) - tau_s + d_skb
+//   不重叠行 e_s + p_sb <= e_t（未激活时放松 M）：M = max(0, latestStart(s) + p_sb - tau_t)
+// 这些值保证未激活的行不起作用；e_sk 不出现在目标中，上界只去掉与 (z, e) 相同的等价解。
+// tightenBounds = false 时使用原始常数：货舱顺序 M = 10000，不重叠 M = H + 150000，e_sk 无上界。
+//
+// pairElimination = true（默认）时 pairRelation 按时间窗给出船对关系，否则总是 PairConflict。
+class PortBounds {
+public:
+    PortBounds(const ModelParams& params, const ModelOptions& opts);
+
+    bool tightened() const { return tighten_; }
+    // 货舱 k 在泊位 b 的卸货时长（同 compartmentDuration）与船舶在泊位 b 的总处理时长（同 berthProcessingTime）
+    double duration(int s, int b, int k) const { return duration_[(s * B_ + b) * K_ + k]; }
+    double processing(int s, int b) const { return proc_[s * B_ + b]; }
+
+    double latestStart(int s) const { return latest_[s]; }
+    double eskUb(int s, int k) const;
+    // 货舱顺序行 (s,k,t,b) 的 M（与 t 无关）
+    double holdOrderM(int s, int k, int b) const;
+    // 行 e_s + p_sb <= e_t 的 M（SeqFull 的 lambda/mu 行与 SeqPairs 的 o_st 行相同）
+    double overlapM(int s, int t, int b) const;
+    // s < t
+    PairRelation pairRelation(int s, int t, int b) const;
+    // 是否存在 pairRelation 为 PairConflict 的泊位（需要先后变量）
+    bool pairNeedsOrder(int s, int t) const;
+
+private:
+    bool tighten_;
+    bool pairElim_;
+    int K_, B_;
+    double horizon_;
+    std::vector<double> tau_;
+    std::vector<double> latest_;     // [s]
+    std::vector<double> duration_;   // [(s*B + b)*K + k]
+    std::vector<double> proc_;       // [s*B + b]
+    std::vector<double> eskUb_;      // [s*K + k]
+};
+
+// 船舶 s 对目标函数贡献中与开始时间无关部分的下界：min_b (beta p_sb + alpha sum_k 最便宜的块成本)
+double shipCostLowerBound(const ModelParams& params, int s);
+
+// 输出当前选项下各族 big-M、e_s / e_sk 上界的统计（平均值、最大值，与原始常数对比）与船对关系的统计
+void printBoundReport(std::ostream& os, const ModelParams& params, const ModelOptions& opts);
+
+#endif // MODEL_BOUNDS_H
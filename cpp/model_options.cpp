@@ -0,0 +1,194 @@
+#include "model_options.h"
+#include <iostream>
+#include <cstdlib>
+
+const char* transshipmentFormName(TransshipmentForm form) {
+    switch (form) {
+        case TransProduct: return "product";
+        case TransSlot: return "slot";
+        case TransBerth: return "berth";
+    }
+    return "unknown";
+}
+
+const char* sequencingFormName(SequencingForm form) {
+    switch (form) {
+        case SeqFull: return "full";
+        case SeqPairs: return "pairs";
+    }
+    return "unknown";
+}
+
+const char* yardFormName(YardForm form) {
+    switch (form) {
+        case YardSlots: return "slots";
+        case YardBlocks: return "blocks";
+        case YardColumns: return "colgen";
+        case YardNone: return "none";
+    }
+    return "unknown";
+}
+
+const char* solveMethodName(SolveMethod method) {
+    switch (method) {
+        case MethodMonolithic: return "mip";
+        case MethodBenders: return "benders";
+        case MethodRolling: return "rolling";
+    }
+    return "unknown";
+}
+
+const char* memoryGuardName(MemoryGuard guard) {
+    switch (guard) {
+        case GuardRefuse: return "refuse";
+        case GuardSwitch: return "switch";
+    }
+    return "unknown";
+}
+
+bool parseModelOption(const std::string& arg, ModelOptions& opts) {
+    size_t eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    std::string val = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+    if (key == "--trans") {
+        if (val == "product") opts.transshipment = TransProduct;
+        else if (val == "slot") opts.transshipment = TransSlot;
+        else if (val == "berth") opts.transshipment = TransBerth;
+        else { std::cerr << "未知的转运成本形式: " << val << "（可选 product|slot|berth）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--seq") {
+        if (val == "full") opts.sequencing = SeqFull;
+        else if (val == "pairs") opts.sequencing = SeqPairs;
+        else { std::cerr << "未知的先后关系形式: " << val << "（可选 full|pairs）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--yard") {
+        if (val == "slots") opts.yard = YardSlots;
+        else if (val == "blocks") opts.yard = YardBlocks;
+        else if (val == "colgen") opts.yard = YardColumns;
+        else { std::cerr << "未知的堆场建模形式: " << val << "（可选 slots|blocks|colgen）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--method") {
+        if (val == "mip") opts.method = MethodMonolithic;
+        else if (val == "benders") opts.method = MethodBenders;
+        else if (val == "rolling") opts.method = MethodRolling;
+        else { std::cerr << "未知的求解方式: " << val << "（可选 mip|benders|rolling）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--threads") {
+        char* end = 0;
+        long n = std::strtol(val.c_str(), &end, 10);
+        if (val.empty() || *end != '\0' || n < 0) { std::cerr << "无效的线程数: " << val << std::endl; return false; }
+        opts.threads = static_cast<int>(n);
+        return true;
+    }
+    if (key == "--time-limit") {
+        char* end = 0;
+        double t = std::strtod(val.c_str(), &end);
+        if (val.empty() || *end != '\0' || t <= 0) { std::cerr << "无效的时间限制: " << val << std::endl; return false; }
+        opts.timeLimit = t;
+        return true;
+    }
+    if (key == "--window" || key == "--step") {
+        char* end = 0;
+        double h = std::strtod(val.c_str(), &end);
+        if (val.empty() || *end != '\0' || h <= 0) { std::cerr << "无效的 " << key << ": " << val << std::endl; return false; }
+        (key == "--window" ? opts.rollingWindow : opts.rollingStep) = h;
+        return true;
+    }
+    if (key == "--mem-limit") {
+        char* end = 0;
+        double mb = std::strtod(val.c_str(), &end);
+        if (val.empty() || *end != '\0' || mb < 0) { std::cerr << "无效的内存上限: " << val << std::endl; return false; }
+        opts.memoryLimitMB = mb;
+        return true;
+    }
+    if (key == "--mem-guard") {
+        if (val == "refuse") opts.memoryGuard = GuardRefuse;
+        else if (val == "switch") opts.memoryGuard = GuardSwitch;
+        else { std::cerr << "无效的 --mem-guard: " << val << "（可选 refuse|switch）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--mipstart") {
+        if (val == "on") opts.mipStart = true;
+        else if (val == "off") opts.mipStart = false;
+        else { std::cerr << "无效的 --mipstart: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--tighten") {
+        if (val == "on") opts.tightenBounds = true;
+        else if (val == "off") opts.tightenBounds = false;
+        else { std::cerr << "无效的 --tighten: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--pair-elim") {
+        if (val == "on") opts.pairElimination = true;
+        else if (val == "off") opts.pairElimination = false;
+        else { std::cerr << "无效的 --pair-elim: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--lazy-overlap") {
+        if (val == "on") opts.lazyOverlap = true;
+        else if (val == "off") opts.lazyOverlap = false;
+        else { std::cerr << "无效的 --lazy-overlap: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--names") {
+        if (val == "on") opts.names = true;
+        else if (val == "off") opts.names = false;
+        else { std::cerr << "无效的 --names: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--progress") {
+        char* end = 0;
+        double t = std::strtod(val.c_str(), &end);
+        if (val.empty() || *end != '\0' || t < 0) { std::cerr << "无效的 --progress: " << val << "（秒，0 表示关闭）" << std::endl; return false; }
+        opts.progressInterval = t;
+        return true;
+    }
+    if (key == "--snapshots") {
+        if (val == "on") opts.snapshots = true;
+        else if (val == "off") opts.snapshots = false;
+        else { std::cerr << "无效的 --snapshots: " << val << "（可选 on|off）" << std::endl; return false; }
+        return true;
+    }
+    if (key == "--export") {
+        if (val.empty()) { std::cerr << "--export 需要文件名（.lp / .mps，可加 .gz）" << std::endl; return false; }
+        opts.exportFile = val;
+        return true;
+    }
+    if (key == "--cache") {
+        if (val.empty()) { std::cerr << "--cache 需要目录名" << std::endl; return false; }
+        opts.cacheDir = val;
+        return true;
+    }
+    std::cerr << "未知参数: " << arg << std::endl;
+    return false;
+}
+
+SequencingSize sequencingSize(const ModelParams& params, SequencingForm form, bool legacy) {
+    const long S = params.numShips, B = params.numBerths;
+    SequencingSize sz;
+    if (form == SeqPairs && !legacy) {
+        sz.binaries = S * (S - 1) / 2;
+        sz.rows = S * (S - 1) * B;          // 每个无序对、每个泊位 2 行
+        return sz;
+    }
+    // y[S][S] 与 omega/lambda/mu[S][S][B]（含 s == t），约束(24)-(33) 10 行 + 不重叠 2 行，仅 s != t
+    sz.binaries = S * S + 3 * S * S * B;
+    sz.rows = 12 * S * (S - 1) * B;
+    if (legacy) sz.continuous = 2 * S * S * B;   // zeta/eta
+    return sz;
+}
+
+void printSequencingSizeReport(std::ostream& os, const ModelParams& params, SequencingForm form) {
+    SequencingSize before = sequencingSize(params, SeqFull, true);
+    SequencingSize after = sequencingSize(params, form);
+    os << "先后关系规模（" << params.numShips << " 艘船, " << params.numBerths << " 个泊位）:" << std::endl;
+    os << "  原始模型: 二元变量 " << before.binaries << ", 连续变量 " << before.continuous
+       << ", 约束 " << before.rows << std::endl;
+    os << "  " << sequencingFormName(form) << ": 二元变量 " << after.binaries << ", 连续变量 " << after.continuous
+       << ", 约束 " << after.rows << std::endl;
+}
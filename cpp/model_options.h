@@ -0,0 +1,88 @@
+#ifndef MODEL_OPTIONS_H
+#define MODEL_OPTIONS_H
+
+#include <string>
+#include <ostream>
+#include "modelParam.h"
+
+// 建模与求解选项（与求解器无关，port_model.h 的 Concert 模型与 port_ir.h 的稀疏模型共用）
+
+// 转运成本项 sum transshipmentCost[b][r][v] * w_sk * x[s][k][r][v] * z[s][b] 的建模方式
+enum TransshipmentForm {
+    TransProduct,   // 原始形式：x·z 二次乘积，由 CPLEX 内部线性化
+    TransSlot,      // 每个 (s,k,r,v) 一个连续成本变量 u >= w_sk(sum_b d_brv z_sb - dmax_rv (1 - x))
+    TransBerth      // 每个 (s,b) 一个连续成本变量 T >= sum_k w_sk sum_rv d_brv x - M_sb (1 - z_sb)
+};
+
+// 同泊位船舶先后关系的建模方式
+enum SequencingForm {
+    SeqFull,    // 原始形式：有序对 (s,t) 的 y_st，以及每个 (s,t,b) 的 omega/lambda/mu
+    SeqPairs    // 对称约简：每个无序对 s < t 一个先后变量 o_st，直接由 z 激活不重叠约束
+};
+
+// 堆场分配的建模方式
+enum YardForm {
+    YardSlots,   // 原始形式：每槽 x_skrv / h_skrv 与每行 f_skr，连续性由约束(3.13)-(14)保证
+    YardBlocks,  // 起点形式：每个可行 (s,k,r,起点 j) 一个二元变量，表示占用行 r 的 [j, j+n_sk) 整段
+    YardColumns, // 起点形式，但只包含列生成得到的放置（列池见 yard_colgen.h），模型规模不随 R*V 增长
+    YardNone     // 不建堆场部分（Benders 主问题用，见 benders.h），不能从命令行选择
+};
+
+// 求解方式
+enum SolveMethod {
+    MethodMonolithic,   // 单一 MIP（默认）
+    MethodBenders,      // 基于逻辑的 Benders 分解：泊位/时间主问题 + 堆场子问题（见 benders.h）
+    MethodRolling       // 滚动时域：按到达时间窗口依次求解，已提交的决策冻结（见 rolling_horizon.h）
+};
+
+// 模型预计内存超过 ModelOptions::memoryLimitMB 时的处理方式（见 model_size.h）
+enum MemoryGuard {
+    GuardRefuse,   // 拒绝求解
+    GuardSwitch    // 依次改用更省内存的建模形式 / 滚动时域，直到预计内存不超过上限
+};
+
+// 建模与求解选项（命令行 --key=value 解析见 parseModelOption）
+struct ModelOptions {
+    TransshipmentForm transshipment = TransProduct;
+    SequencingForm sequencing = SeqPairs;
+    YardForm yard = YardBlocks;
+    SolveMethod method = MethodMonolithic;
+    int threads = 0;           // 并行线程数（列生成定价、Benders 子问题等），0 表示 hardware_concurrency
+    double timeLimit = 3600;   // 秒
+    bool mipStart = true;      // 用贪心启发式（heuristic.h）的解作为 MIP 初始解
+    double rollingWindow = 48; // 滚动时域：每个窗口包含的到达时间跨度（小时）
+    double rollingStep = 24;   // 滚动时域：每个窗口提交的到达时间跨度（小时）
+    double memoryLimitMB = 0;  // 预计峰值内存上限（MB），0 表示不检查
+    MemoryGuard memoryGuard = GuardRefuse;
+    bool tightenBounds = true; // 由到达时间、处理时长与规划期推出逐行 big-M 与 e_sk 上界（见 model_bounds.h），off 为原始常数
+    bool pairElimination = true; // 按到达时间窗消去不可能冲突的同泊位船对（先后已定 / 互斥 / 单向，见 PortBounds::pairRelation）
+    double objectiveCutoff = 0; // 已知可行解的目标值（如贪心初始解），>0 且 tightenBounds 时收紧最晚开始时间，不能从命令行设置
+    bool lazyOverlap = false;  // 同泊位不重叠约束不放入初始模型，在整数候选解上按需加入（单一 MIP，见 lazy_rows.h）
+    bool names = false;        // 建模时给变量命名（默认匿名，导出 LP / 调试时再用 nameModelVariables 命名）
+    double progressInterval = 10; // 单一 MIP 求解时每隔多少秒向输出目录的 progress.csv 追加一行，0 表示不写（见 solve_telemetry.h）
+    bool snapshots = true;     // 单一 MIP 求解时把每个改进的 incumbent 写到输出目录的 incumbents/NNNN/
+    std::string exportFile;    // 非空时建模后把模型写到输出目录下的该文件（.lp / .mps，可加 .gz，见 model_writer.h）
+    std::string cacheDir;      // 非空时按算例指纹缓存参数、模型与最好解（单一 MIP，见 instance_cache.h）
+};
+
+// 解析单个命令行参数，成功返回 true；无法识别时返回 false 并输出错误
+bool parseModelOption(const std::string& arg, ModelOptions& opts);
+const char* transshipmentFormName(TransshipmentForm form);
+const char* sequencingFormName(SequencingForm form);
+const char* yardFormName(YardForm form);
+const char* solveMethodName(SolveMethod method);
+const char* memoryGuardName(MemoryGuard guard);
+
+// 先后关系部分的规模（解析计算，不建模）
+struct SequencingSize {
+    long binaries = 0;     // 二元变量
+    long continuous = 0;   // 连续变量
+    long rows = 0;         // 约束行数
+};
+// 先后关系部分在给定形式下的规模；legacy = true 时按重构前的原始模型计算
+// （含 s == t 的冗余变量以及未使用的 zeta/eta）
+SequencingSize sequencingSize(const ModelParams& params, SequencingForm form, bool legacy = false);
+// 输出原始模型与当前形式的先后关系规模对比
+void printSequencingSizeReport(std::ostream& os, const ModelParams& params, SequencingForm form);
+
+#endif // MODEL_OPTIONS_H
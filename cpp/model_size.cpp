@@ -0,0 +1,374 @@
+#include "model_size.h"
+#include "phase_timer.h"
+#include "rolling_horizon.h"
+#include "heuristic.h"
+#include "model_bounds.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+// 每个对象的典型内存占用（字节），见 model_size.h
+static const double CONCERT_VAR = 150;     // 变量对象 + 名称
+static const double CONCERT_ROW = 160;     // IloRange 对象
+static const double CONCERT_TERM = 32;     // 表达式中的一个线性项
+static const double CONCERT_QUAD = 48;     // 一个二次项
+static const double CPLEX_COL = 100;       // 界、目标系数、类型、名称
+static const double CPLEX_ROW = 80;
+static const double CPLEX_NZ = 24;         // 按行与按列各存一份（系数 + 下标）
+static const double CPLEX_QUAD = 24;
+static const double CPLEX_COPIES = 2;      // 原模型 + 预处理后的模型
+
+static double slotWeight(const ModelParams& params, int s, int k) {
+    return params.cargoWeight[s] / (params.requiredSlots[s][k] * params.numShipK);
+}
+
+// 逐槽堆场：x/h/f 与约束(3.11)-(14)，及按 opts.transshipment 的转运成本项
+static void slotYardBlocks(const ModelParams& params, const ModelOptions& opts, vector<BlockSize>& blocks) {
+    const long S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const long R = params.numRows, V = params.numSlotsPerRow;
+    BlockSize yard;
+    yard.name = "x/h/f (3.11)-(14)";
+    yard.binaries = 2 * S * K * R * V + S * K * R;
+    yard.rows = S * K + R * V + S * K + 3 * S * K * R + S * K * R * (V - 1);
+    yard.nonzeros = S * K * R * V          // (3.11)
+                  + R * V * S * K          // (3.12)
+                  + S * K * R              // (3.13)
+                  + 2 * S * K * R * (V + 1) // (3.14) 与 (12)
+                  + 2 * S * K * R          // (13)
+                  + 3 * S * K * R * (V - 1); // (14)
+    blocks.push_back(yard);
+
+    BlockSize trans;
+    if (opts.transshipment == TransProduct) {
+        trans.name = "trans x*z";
+        if (params.alpha != 0) {
+            for (int s = 0; s < S; ++s) {
+                for (int k = 0; k < K; ++k) {
+                    const double w = slotWeight(params, s, k);
+                    for (int b = 0; b < B; ++b) {
+                        const param_t* d = params.transshipmentCost.row(b, 0);
+                        for (long i = 0; i < R * V; ++i) trans.quadTerms += (d[i] * w != 0) ? 1 : 0;
+                    }
+                }
+            }
+        }
+    } else if (opts.transshipment == TransSlot) {
+        trans.name = "trans u_skrv";
+        trans.continuous = S * K * R * V;
+        trans.rows = 2 * S * K * R * V;
+        for (int s = 0; s < S; ++s) {
+            for (int k = 0; k < K; ++k) {
+                const double w = slotWeight(params, s, k);
+                for (int r = 0; r < R; ++r) {
+                    for (int v = 0; v < V; ++v) {
+                        double lo = 0.0, hi = 0.0;
+                        for (int b = 0; b < B; ++b) {
+                            const double d = params.transshipmentCost(b, r, v);
+                            if (b == 0 || d < lo) lo = d;
+                            if (b == 0 || d > hi) hi = d;
+                            trans.nonzeros += (w * d != 0) ? 1 : 0;
+                        }
+                        trans.nonzeros += 2 + (w * hi != 0 ? 1 : 0) + (w * lo != 0 ? 1 : 0);
+                    }
+                }
+            }
+        }
+    } else {
+        trans.name = "trans T_sb";
+        trans.continuous = S * B;
+        trans.rows = S * B;
+        // topSum[b][n] 同 addBerthTransshipmentCost
+        vector<vector<double>> topSum(B, vector<double>(R * V + 1, 0.0));
+        for (int b = 0; b < B; ++b) {
+            vector<double> d(params.transshipmentCost.row(b, 0), params.transshipmentCost.row(b, 0) + R * V);
+            sort(d.begin(), d.end(), greater<double>());
+            for (long n = 0; n < R * V; ++n) topSum[b][n + 1] = topSum[b][n] + d[n];
+        }
+        for (int s = 0; s < S; ++s) {
+            for (int b = 0; b < B; ++b) {
+                double M = 0.0;
+                for (int k = 0; k < K; ++k) {
+                    const double w = slotWeight(params, s, k);
+                    const long n = min(max<long>(params.requiredSlots[s][k], 0), R * V);
+                    M += w * topSum[b][n];
+                    const param_t* d = params.transshipmentCost.row(b, 0);
+                    for (long i = 0; i < R * V; ++i) trans.nonzeros += (w * d[i] != 0) ? 1 : 0;
+                }
+                trans.nonzeros += 1 + (M != 0 ? 1 : 0);
+            }
+        }
+    }
+    blocks.push_back(trans);
+}
+
+// 起点形式堆场（addBlockYard）：每个可行 (s,k,r,j) 一个 place 变量
+static void blockYardBlocks(const ModelParams& params, const ModelOptions& opts, vector<BlockSize>& blocks) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const int R = params.numRows, V = params.numSlotsPerRow;
+    vector<double> prefix(static_cast<size_t>(B) * R * (V + 1), 0.0);
+    for (int b = 0; b < B; ++b) {
+        for (int r = 0; r < R; ++r) {
+            double* p = &prefix[(static_cast<size_t>(b) * R + r) * (V + 1)];
+            const param_t* d = params.transshipmentCost.row(b, r);
+            for (int v = 0; v < V; ++v) p[v + 1] = p[v] + d[v];
+        }
+    }
+
+    BlockSize yard;
+    yard.name = "place + cover";
+    BlockSize trans;
+    trans.name = opts.transshipment == TransProduct ? "trans place*z"
+               : opts.transshipment == TransSlot ? "trans u_skrj" : "trans T_sb";
+    bool covered = false;
+    vector<double> c(B);
+    for (int s = 0; s < S; ++s) {
+        vector<double> M(B, 0.0);
+        vector<long> berthTerms(B, 0);
+        for (int k = 0; k < K; ++k) {
+            const int n = params.requiredSlots[s][k];
+            const int starts = n > 0 ? max(V - n + 1, 0) : 0;
+            const double w = n > 0 ? slotWeight(params, s, k) : 0.0;
+            if (n > 0) {
+                yard.rows += 1;   // 每个货舱恰好一个位置（没有可行起点时为空行）
+                yard.nonzeros += static_cast<long>(R) * starts;
+            }
+            if (starts > 0) covered = true;
+            yard.binaries += static_cast<long>(R) * starts;
+            yard.nonzeros += static_cast<long>(R) * starts * n;   // 每个放置出现在它覆盖的 n 个槽的行中
+            vector<double> blockMax(B, 0.0);
+            for (int r = 0; r < R; ++r) {
+                for (int j = 0; j < starts; ++j) {
+                    double cmin = 0.0, cmax = 0.0;
+                    long nz = 0;
+                    for (int b = 0; b < B; ++b) {
+                        const double* pre = &prefix[(static_cast<size_t>(b) * R + r) * (V + 1)];
+                        c[b] = w * (pre[j + n] - pre[j]);
+                        if (b == 0 || c[b] < cmin) cmin = c[b];
+                        if (b == 0 || c[b] > cmax) cmax = c[b];
+                        blockMax[b] = max(blockMax[b], c[b]);
+                        if (c[b] != 0) {
+                            ++nz;
+                            ++berthTerms[b];
+                        }
+                    }
+                    if (opts.transshipment == TransProduct) {
+                        if (params.alpha != 0) trans.quadTerms += nz;
+                    } else if (opts.transshipment == TransSlot) {
+                        trans.continuous += 1;
+                        trans.rows += 2;
+                        trans.nonzeros += 2 + nz + (cmax != 0 ? 1 : 0) + (cmin != 0 ? 1 : 0);
+                    }
+                }
+            }
+            for (int b = 0; b < B; ++b) M[b] += blockMax[b];
+        }
+        if (opts.transshipment == TransBerth) {
+            for (int b = 0; b < B; ++b) {
+                trans.continuous += 1;
+                trans.rows += 1;
+                trans.nonzeros += 1 + berthTerms[b] + (M[b] != 0 ? 1 : 0);
+            }
+        }
+    }
+    if (covered) yard.rows += static_cast<long>(R) * V;
+    blocks.push_back(yard);
+    blocks.push_back(trans);
+}
+
+ModelSize estimateModelSize(const ModelParams& params, const ModelOptions& opts) {
+    const long S = params.numShips, K = params.numShipK, B = params.numBerths;
+    ModelSize size;
+
+    BlockSize assign;
+    assign.name = "z (3.8)";
+    assign.binaries = S * B;
+    assign.rows = S;
+    assign.nonzeros = S * B;
+    size.blocks.push_back(assign);
+
+    BlockSize times;
+    times.name = "e/e_sk";
+    times.continuous = S + S * K;
+    times.rows = S * K;          // e_s <= e_sk
+    times.nonzeros = 2 * S * K;
+    size.blocks.push_back(times);
+
+    if (opts.yard == YardSlots) {
+        slotYardBlocks(params, opts, size.blocks);
+    } else if (opts.yard != YardNone) {
+        blockYardBlocks(params, opts, size.blocks);
+        if (opts.yard == YardColumns) size.exact = false;
+    }
+
+    BlockSize compartment;
+    compartment.name = "q compartment big-M";
+    compartment.binaries = S * K * K;   // 含不出现在任何行中的 q_skk
+    compartment.rows = S * K * (K - 1) * (1 + B);
+    compartment.nonzeros = S * K * (K - 1) * (2 + 4 * B);
+    size.blocks.push_back(compartment);
+
+    // 先后关系按时间窗的船对关系逐对计数（见 PortBounds::pairRelation），与 buildPortIR 一致
+    const PortBounds bounds(params, opts);
+    BlockSize linking, overlap;
+    overlap.name = "berth no-overlap";
+    linking.name = "y/omega/lambda/mu";
+    for (int s = 0; s < S; ++s) {
+        for (int t = s + 1; t < S; ++t) {
+            if (bounds.pairNeedsOrder(s, t)) {
+                if (opts.sequencing == SeqFull) linking.binaries += 2;   // y_st 与 y_ts
+                else overlap.binaries += 1;                              // o_st
+            }
+            for (int b = 0; b < B; ++b) {
+                switch (bounds.pairRelation(s, t, b)) {
+                case PairOrdered:
+                    break;
+                case PairExcluded:        // z_sb + z_tb <= 1
+                    overlap.rows += 1;
+                    overlap.nonzeros += 2;
+                    break;
+                case PairFirstBefore:
+                case PairSecondBefore:    // 一条 e_s - e_t + M z_sb + M z_tb 行
+                    overlap.rows += 1;
+                    overlap.nonzeros += 4;
+                    break;
+                case PairConflict:
+                    if (opts.sequencing == SeqFull) {
+                        // 两个有序对各有 omega/lambda/mu 与约束(24)-(33) 10 行，不重叠各 1 行
+                        linking.binaries += 6;
+                        linking.rows += 20;
+                        linking.nonzeros += 48;
+                        overlap.rows += 4;
+                        overlap.nonzeros += 12;
+                    } else {
+                        overlap.rows += 2;
+                        overlap.nonzeros += 10;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    if (opts.sequencing == SeqFull) size.blocks.push_back(linking);
+    size.blocks.push_back(overlap);
+
+    size.total.name = "total";
+    for (size_t i = 0; i < size.blocks.size(); ++i) {
+        const BlockSize& b = size.blocks[i];
+        size.total.binaries += b.binaries;
+        size.total.continuous += b.continuous;
+        size.total.rows += b.rows;
+        size.total.nonzeros += b.nonzeros;
+        size.total.quadTerms += b.quadTerms;
+    }
+    const BlockSize& t = size.total;
+    const double cols = static_cast<double>(t.binaries + t.continuous);
+    // 目标函数的线性项约每列一个
+    size.concertMB = (cols * (CONCERT_VAR + CONCERT_TERM) + t.rows * CONCERT_ROW + t.nonzeros * CONCERT_TERM
+                      + t.quadTerms * CONCERT_QUAD) / (1024.0 * 1024.0);
+    size.cplexMB = CPLEX_COPIES * (cols * CPLEX_COL + t.rows * CPLEX_ROW + t.nonzeros * CPLEX_NZ
+                                   + t.quadTerms * CPLEX_QUAD) / (1024.0 * 1024.0);
+    size.peakMB = size.concertMB + size.cplexMB;
+    return size;
+}
+
+// 滚动时域中包含船舶最多的窗口（按到达时间，每个窗口从某艘船的到达时间开始）
+static vector<int> largestWindow(const ModelParams& params, double window) {
+    vector<int> order = shipsByArrival(params);
+    size_t bestFrom = 0, bestCount = 0, to = 0;
+    for (size_t from = 0; from < order.size(); ++from) {
+        to = max(to, from);
+        while (to < order.size() && params.arrivalTime[order[to]] < params.arrivalTime[order[from]] + window) ++to;
+        if (to - from > bestCount) {
+            bestCount = to - from;
+            bestFrom = from;
+        }
+    }
+    return vector<int>(order.begin() + bestFrom, order.begin() + bestFrom + bestCount);
+}
+
+ModelSize estimateSolveSize(const ModelParams& params, const ModelOptions& opts) {
+    if (opts.method == MethodBenders) {
+        ModelOptions masterOpts = opts;
+        masterOpts.yard = YardNone;
+        return estimateModelSize(params, masterOpts);
+    }
+    if (opts.method == MethodRolling) {
+        return estimateModelSize(selectShips(params, largestWindow(params, opts.rollingWindow)), opts);
+    }
+    return estimateModelSize(params, opts);
+}
+
+void printModelSizeReport(ostream& os, const ModelSize& size, const PhaseProfile* profile) {
+    os << "模型规模估计" << (size.exact ? "" : "（列生成形式，按全部放置给出上界）") << ":" << endl;
+    os << "  " << left << setw(24) << "block" << right << setw(12) << "binaries" << setw(12) << "continuous"
+       << setw(12) << "rows" << setw(14) << "nonzeros" << setw(12) << "quad" << endl;
+    for (size_t i = 0; i <= size.blocks.size(); ++i) {
+        const BlockSize& b = i < size.blocks.size() ? size.blocks[i] : size.total;
+        os << "  " << left << setw(24) << b.name << right << setw(12) << b.binaries << setw(12) << b.continuous
+           << setw(12) << b.rows << setw(14) << b.nonzeros << setw(12) << b.quadTerms << endl;
+    }
+    os << "  预计内存: Concert " << fixed << setprecision(1) << size.concertMB << " MB + CPLEX " << size.cplexMB
+       << " MB = " << size.peakMB << " MB（不含分支定界树）" << defaultfloat << setprecision(6) << endl;
+    if (!profile) return;
+    os << "建模各阶段实际开销:" << endl;
+    os << "  " << left << setw(28) << "phase" << right << setw(12) << "wall_ms" << setw(12) << "cpu_ms"
+       << setw(12) << "mem_MB" << setw(12) << "peak_MB" << endl;
+    for (size_t i = 0; i < profile->phases().size(); ++i) {
+        const PhaseRecord& r = profile->phases()[i];
+        os << "  " << left << setw(28) << r.name << right << fixed << setprecision(1) << setw(12) << r.wallMs
+           << setw(12) << r.cpuMs << setw(12) << r.memMB << setw(12) << r.peakMB << defaultfloat << setprecision(6) << endl;
+    }
+}
+
+static void describe(ostream& log, const ModelOptions& opts, const ModelSize& size) {
+    log << "  method=" << solveMethodName(opts.method) << " seq=" << sequencingFormName(opts.sequencing)
+        << " yard=" << yardFormName(opts.yard) << " trans=" << transshipmentFormName(opts.transshipment);
+    if (opts.method == MethodRolling) log << " window=" << opts.rollingWindow << " step=" << opts.rollingStep;
+    log << ": 预计 " << size.peakMB << " MB（行 " << size.total.rows << ", 非零元 " << size.total.nonzeros << "）" << endl;
+}
+
+bool applyMemoryGuard(const ModelParams& params, ModelOptions& opts, ostream& log) {
+    if (opts.memoryLimitMB <= 0) return true;
+    ModelSize size = estimateSolveSize(params, opts);
+    log << "内存保护: 上限 " << opts.memoryLimitMB << " MB" << endl;
+    describe(log, opts, size);
+    if (size.peakMB <= opts.memoryLimitMB) return true;
+    if (opts.memoryGuard == GuardRefuse) {
+        log << "预计内存超过上限，拒绝求解（--mem-guard=switch 可自动改用更省内存的形式）" << endl;
+        return false;
+    }
+
+    // 依次收紧，保留此前的改动
+    ModelOptions cand = opts;
+    for (int step = 0; step < 4; ++step) {
+        if (step == 0 && cand.sequencing == SeqFull) cand.sequencing = SeqPairs;
+        else if (step == 1 && cand.yard == YardSlots) cand.yard = YardBlocks;
+        else if (step == 2 && cand.transshipment != TransBerth) cand.transshipment = TransBerth;
+        else if (step == 3 && cand.method == MethodMonolithic) cand.method = MethodRolling;
+        else continue;
+        size = estimateSolveSize(params, cand);
+        describe(log, cand, size);
+        if (size.peakMB <= opts.memoryLimitMB) {
+            opts = cand;
+            return true;
+        }
+    }
+    // 滚动时域：窗口与步长减半，直到最大窗口只剩一艘船（同时到达的船舶无法再分开，最多减半 16 次）
+    if (cand.method == MethodRolling) {
+        for (int i = 0; i < 16 && largestWindow(params, cand.rollingWindow).size() > 1; ++i) {
+            cand.rollingWindow /= 2;
+            cand.rollingStep = min(cand.rollingStep, cand.rollingWindow / 2);
+            size = estimateSolveSize(params, cand);
+            describe(log, cand, size);
+            if (size.peakMB <= opts.memoryLimitMB) {
+                opts = cand;
+                return true;
+            }
+        }
+    }
+    log << "没有预计内存不超过上限的求解方式，拒绝求解" << endl;
+    return false;
+}
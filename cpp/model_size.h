@@ -0,0 +1,55 @@
+#ifndef MODEL_SIZE_H
+#define MODEL_SIZE_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "modelParam.h"
+#include "port_model.h"
+
+class PhaseProfile;
+
+// 模型规模估计：只读 ModelParams，不建模
+//
+// 按 buildPortModel 的建模方式逐块计算 CPLEX 抽取后的列数、行数与非零元数：
+//   列为稀疏模型的全部列（loadSparseModel 把每一列都加入模型，包括不出现在任何行中的 q_skk）；
+//   非零元只计入系数不为 0 的约束项（与 getNNZs 一致），product 形式目标中的二次项单独计数。
+// YardColumns 的规模取决于列池，按 YardBlocks（全部放置）给出上界，此时 exact 为 false。
+//
+// 峰值内存按每个对象的典型占用估算：Concert 模型（变量、约束行、表达式项）+ CPLEX 抽取的
+// 矩阵及其预处理副本（按 2 份计）。系数是经验值，只用于数量级判断和内存保护；
+// 不含分支定界树与割平面，搜索过程中的增长需在上限中另留余量。
+struct BlockSize {
+    std::string name;
+    long binaries = 0;
+    long continuous = 0;
+    long rows = 0;
+    long nonzeros = 0;
+    long quadTerms = 0;   // 目标函数中的二次项
+};
+
+struct ModelSize {
+    std::vector<BlockSize> blocks;
+    BlockSize total;
+    bool exact = true;
+    double concertMB = 0.0;
+    double cplexMB = 0.0;
+    double peakMB = 0.0;   // concertMB + cplexMB
+};
+
+// 按 opts 建出的完整模型的规模
+ModelSize estimateModelSize(const ModelParams& params, const ModelOptions& opts);
+
+// 按 opts.method 求解时最大的单个模型：mip 为完整模型，benders 为主问题（不含堆场），
+// rolling 为按到达时间包含船舶最多的窗口的子模型
+ModelSize estimateSolveSize(const ModelParams& params, const ModelOptions& opts);
+
+// 逐块输出规模与预计内存；profile 非空时再输出建模各阶段（约束族）实际的耗时与内存
+void printModelSizeReport(std::ostream& os, const ModelSize& size, const PhaseProfile* profile = 0);
+
+// 内存保护：opts.memoryLimitMB > 0 且 estimateSolveSize 的预计峰值内存超过上限时，
+// GuardRefuse 直接返回 false；GuardSwitch 依次改用 seq=pairs、yard=blocks、trans=berth、
+// 滚动时域（窗口与步长逐次减半），把 opts 改为第一个不超过上限的组合，都超过时返回 false
+bool applyMemoryGuard(const ModelParams& params, ModelOptions& opts, std::ostream& log);
+
+#endif // MODEL_SIZE_H
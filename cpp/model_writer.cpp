@@ -0,0 +1,449 @@
+#include "model_writer.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#ifdef PORT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace std;
+
+// 顺序写出的大缓冲区输出：缓冲区满时整块交给 fwrite / gzwrite
+class BufferedOutput {
+public:
+    static const size_t BUFFER_BYTES = 1 << 22;
+
+    BufferedOutput() : buf_(BUFFER_BYTES) {}
+    ~BufferedOutput() { close(); }
+
+    bool open(const string& path) {
+        const bool gzip = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+        if (gzip) {
+#ifdef PORT_HAVE_ZLIB
+            gz_ = gzopen(path.c_str(), "wb1");   // 压缩级别 1：速度优先
+            if (gz_) gzbuffer(gz_, 1 << 20);
+            return gz_ != 0;
+#else
+            cerr << "构建时未找到 zlib，不能写 gzip 文件: " << path << endl;
+            return false;
+#endif
+        }
+        file_ = fopen(path.c_str(), "wb");
+        return file_ != 0;
+    }
+    // 写完并关闭，返回整个过程是否没有出错
+    bool close() {
+        flush();
+        if (file_) {
+            if (fclose(file_) != 0) ok_ = false;
+            file_ = 0;
+        }
+#ifdef PORT_HAVE_ZLIB
+        if (gz_) {
+            if (gzclose(gz_) != Z_OK) ok_ = false;
+            gz_ = 0;
+        }
+#endif
+        return ok_;
+    }
+
+    void write(const char* s, size_t n) {
+        if (used_ + n > buf_.size()) flush();
+        if (n > buf_.size()) {
+            buf_.resize(n);
+        }
+        memcpy(&buf_[used_], s, n);
+        used_ += n;
+    }
+    void put(char c) {
+        if (used_ == buf_.size()) flush();
+        buf_[used_++] = c;
+    }
+    void put(const char* s) { write(s, strlen(s)); }
+    void put(const string& s) { write(s.data(), s.size()); }
+    // 整数直接写出，其余用能精确读回的最短格式（先 %.15g，读回不等时 %.17g）
+    void number(double v) {
+        char tmp[32];
+        int n;
+        if (v == floor(v) && fabs(v) < 1e15) {
+            n = snprintf(tmp, sizeof(tmp), "%lld", static_cast<long long>(v));
+        } else {
+            n = snprintf(tmp, sizeof(tmp), "%.15g", v);
+            if (strtod(tmp, 0) != v) n = snprintf(tmp, sizeof(tmp), "%.17g", v);
+        }
+        write(tmp, n);
+    }
+
+private:
+    void flush() {
+        if (used_ == 0) return;
+        if (file_ && fwrite(&buf_[0], 1, used_, file_) != used_) ok_ = false;
+#ifdef PORT_HAVE_ZLIB
+        if (gz_ && gzwrite(gz_, &buf_[0], static_cast<unsigned>(used_)) != static_cast<int>(used_)) ok_ = false;
+#endif
+        used_ = 0;
+    }
+
+    vector<char> buf_;
+    size_t used_ = 0;
+    bool ok_ = true;
+    FILE* file_ = 0;
+#ifdef PORT_HAVE_ZLIB
+    gzFile gz_ = 0;
+#endif
+};
+
+// 行名 <约束族>_<族内序号>：ordinal 按行预先计算，名称在写出时临时拼出
+class RowNames {
+public:
+    explicit RowNames(const SparseModel& model) : model_(model), ordinal_(model.numRows()) {
+        vector<int> count(model.rowFamilyNames.size(), 0);
+        for (long i = 0; i < model.numRows(); i++) ordinal_[i] = count[model.rowFamily[i]]++;
+    }
+    // 返回的指针在下一次调用前有效
+    const char* operator()(long i, const char* suffix = "") {
+        snprintf(buf_, sizeof(buf_), "%s_%d%s", model_.rowFamilyNames[model_.rowFamily[i]].c_str(), ordinal_[i], suffix);
+        return buf_;
+    }
+
+private:
+    const SparseModel& model_;
+    vector<int> ordinal_;
+    char buf_[96];
+};
+
+// 二次项按 (i, j) 合并同类项
+static vector<QuadTerm> mergedQuad(const SparseModel& model) {
+    vector<QuadTerm> q(model.quad);
+    sort(q.begin(), q.end(), [](const QuadTerm& a, const QuadTerm& b) { return a.i < b.i || (a.i == b.i && a.j < b.j); });
+    size_t n = 0;
+    for (size_t t = 0; t < q.size(); t++) {
+        if (n > 0 && q[n - 1].i == q[t].i && q[n - 1].j == q[t].j) q[n - 1].coef += q[t].coef;
+        else q[n++] = q[t];
+    }
+    q.resize(n);
+    return q;
+}
+
+static bool isInf(double v) { return v >= SPARSE_INF; }
+static bool isNegInf(double v) { return v <= -SPARSE_INF; }
+
+// LP 表达式中的一项；每行最多 TERMS_PER_LINE 项（CPLEX 要求每行不超过 510 个字符，续行以空格开头）
+static const int TERMS_PER_LINE = 8;
+
+static void lpTerm(BufferedOutput& out, double coef, const string& name, int& onLine) {
+    if (onLine == TERMS_PER_LINE) {
+        out.put("\n ");
+        onLine = 0;
+    }
+    out.put(coef < 0 ? " - " : " + ");
+    if (fabs(coef) != 1) {
+        out.number(fabs(coef));
+        out.put(' ');
+    }
+    out.put(name);
+    ++onLine;
+}
+
+static void writeLP(BufferedOutput& out, const SparseModel& model, const vector<string>& names) {
+    const int n = model.numCols();
+    out.put("\\ ");
+    out.number(n);
+    out.put(" columns, ");
+    out.number(model.numRows());
+    out.put(" rows, ");
+    out.number(model.numNonzeros());
+    out.put(" nonzeros\nMinimize\n obj:");
+    int onLine = 0;
+    bool any = false;
+    for (int c = 0; c < n; c++) {
+        if (model.obj[c] == 0) continue;
+        lpTerm(out, model.obj[c], names[c], onLine);
+        any = true;
+    }
+    // 二次项：[ 2c x * y ] / 2，对角项为 [ 2c x ^ 2 ] / 2
+    vector<QuadTerm> quad = mergedQuad(model);
+    if (!quad.empty()) {
+        out.put(" + [");
+        onLine = 0;
+        for (size_t t = 0; t < quad.size(); t++) {
+            if (onLine == TERMS_PER_LINE) {
+                out.put("\n ");
+                onLine = 0;
+            }
+            const double c2 = 2 * quad[t].coef;
+            out.put(c2 < 0 ? " - " : " + ");
+            out.number(fabs(c2));
+            out.put(' ');
+            out.put(names[quad[t].i]);
+            if (quad[t].i == quad[t].j) {
+                out.put(" ^ 2");
+            } else {
+                out.put(" * ");
+                out.put(names[quad[t].j]);
+            }
+            ++onLine;
+        }
+        out.put(" ] / 2");
+        any = true;
+    }
+    if (model.objConstant != 0 || !any) {
+        out.put(model.objConstant < 0 ? " - " : " + ");
+        out.number(fabs(model.objConstant));
+    }
+
+    // 约束：两端都有限且不等的行拆成 _lo / _hi 两行，两端都无穷的行省略
+    out.put("\nSubject To\n");
+    RowNames rowName(model);
+    for (long i = 0; i < model.numRows(); i++) {
+        const double lb = model.rowLb[i], ub = model.rowUb[i];
+        if (isNegInf(lb) && isInf(ub)) continue;
+        const bool ranged = !isNegInf(lb) && !isInf(ub) && lb != ub;
+        for (int side = 0; side < (ranged ? 2 : 1); side++) {
+            out.put(' ');
+            out.put(rowName(i, ranged ? (side == 0 ? "_lo" : "_hi") : ""));
+            out.put(':');
+            onLine = 0;
+            if (model.rowStart[i] == model.rowStart[i + 1]) {
+                out.put(" 0 ");
+                out.put(names[0]);
+            }
+            for (long p = model.rowStart[i]; p < model.rowStart[i + 1]; p++) {
+                lpTerm(out, model.rowValue[p], names[model.rowIndex[p]], onLine);
+            }
+            if (lb == ub) {
+                out.put(" = ");
+                out.number(lb);
+            } else if (ranged ? side == 0 : !isNegInf(lb)) {
+                out.put(" >= ");
+                out.number(lb);
+            } else {
+                out.put(" <= ");
+                out.number(ub);
+            }
+            out.put('\n');
+        }
+    }
+
+    // 上下界：LP 默认 [0, +inf)，二元变量默认 [0, 1]
+    out.put("Bounds\n");
+    for (int c = 0; c < n; c++) {
+        const double lb = model.colLb[c], ub = model.colUb[c];
+        const bool binary = model.colType[c] == ColBinary;
+        if (binary ? (lb == 0 && ub == 1) : (lb == 0 && isInf(ub))) continue;
+        out.put(' ');
+        if (lb == ub) {
+            out.put(names[c]);
+            out.put(" = ");
+            out.number(lb);
+        } else if (isNegInf(lb) && isInf(ub)) {
+            out.put(names[c]);
+            out.put(" free");
+        } else if (isInf(ub)) {
+            out.put(names[c]);
+            out.put(" >= ");
+            out.number(lb);
+        } else {
+            if (isNegInf(lb)) out.put("-inf");
+            else out.number(lb);
+            out.put(" <= ");
+            out.put(names[c]);
+            out.put(" <= ");
+            out.number(ub);
+        }
+        out.put('\n');
+    }
+    out.put("Binaries\n");
+    onLine = 0;
+    for (int c = 0; c < n; c++) {
+        if (model.colType[c] != ColBinary) continue;
+        out.put(' ');
+        out.put(names[c]);
+        if (++onLine == TERMS_PER_LINE) {
+            out.put('\n');
+            onLine = 0;
+        }
+    }
+    if (onLine > 0) out.put('\n');
+    out.put("End\n");
+}
+
+// MPS 数据行：a b [c] v（c 为空时省略）
+static void mpsEntry(BufferedOutput& out, const char* a, const char* b, const char* c, double v) {
+    out.put(' ');
+    out.put(a);
+    out.put(' ');
+    out.put(b);
+    out.put(' ');
+    if (*c) {
+        out.put(c);
+        out.put(' ');
+    }
+    out.number(v);
+    out.put('\n');
+}
+
+static void writeMPS(BufferedOutput& out, const SparseModel& model, const vector<string>& names) {
+    const int n = model.numCols();
+    const long m = model.numRows();
+    // 两端都无穷的行省略
+    vector<char> keep(m);
+    for (long i = 0; i < m; i++) keep[i] = !(isNegInf(model.rowLb[i]) && isInf(model.rowUb[i]));
+
+    out.put("* ");
+    out.number(n);
+    out.put(" columns, ");
+    out.number(m);
+    out.put(" rows, ");
+    out.number(model.numNonzeros());
+    out.put(" nonzeros\nNAME port_model\nROWS\n N obj\n");
+    RowNames rowName(model);
+    for (long i = 0; i < m; i++) {
+        if (!keep[i]) continue;
+        const double lb = model.rowLb[i], ub = model.rowUb[i];
+        out.put(lb == ub ? " E " : isNegInf(lb) ? " L " : " G ");
+        out.put(rowName(i));
+        out.put('\n');
+    }
+
+    // 按列转置（CSC），二元变量的连续段用 MARKER 标为整数
+    vector<long> colStart(n + 1, 0);
+    for (long p = 0; p < model.numNonzeros(); p++) colStart[model.rowIndex[p] + 1]++;
+    for (int c = 0; c < n; c++) colStart[c + 1] += colStart[c];
+    vector<long> fill(colStart.begin(), colStart.end() - 1);
+    vector<int> colRow(model.numNonzeros());
+    vector<double> colValue(model.numNonzeros());
+    for (long i = 0; i < m; i++) {
+        for (long p = model.rowStart[i]; p < model.rowStart[i + 1]; p++) {
+            const long q = fill[model.rowIndex[p]]++;
+            colRow[q] = static_cast<int>(i);
+            colValue[q] = model.rowValue[p];
+        }
+    }
+    out.put("COLUMNS\n");
+    bool inInt = false;
+    int marker = 0;
+    char markerName[32];
+    for (int c = 0; c < n; c++) {
+        const bool binary = model.colType[c] == ColBinary;
+        if (binary != inInt) {
+            snprintf(markerName, sizeof(markerName), "M%d", marker++);
+            out.put("    ");
+            out.put(markerName);
+            out.put(binary ? " 'MARKER' 'INTORG'\n" : " 'MARKER' 'INTEND'\n");
+            inInt = binary;
+        }
+        const char* name = names[c].c_str();
+        bool wrote = false;
+        if (model.obj[c] != 0) {
+            mpsEntry(out, name, "obj", "", model.obj[c]);
+            wrote = true;
+        }
+        for (long p = colStart[c]; p < colStart[c + 1]; p++) {
+            if (!keep[colRow[p]]) continue;
+            mpsEntry(out, name, rowName(colRow[p]), "", colValue[p]);
+            wrote = true;
+        }
+        if (!wrote) mpsEntry(out, name, "obj", "", 0);
+    }
+    if (inInt) {
+        snprintf(markerName, sizeof(markerName), "M%d", marker++);
+        out.put("    ");
+        out.put(markerName);
+        out.put(" 'MARKER' 'INTEND'\n");
+    }
+
+    // 右端项（目标行的 RHS 为常数项的相反数）与区间行
+    out.put("RHS\n");
+    if (model.objConstant != 0) mpsEntry(out, "RHS", "obj", "", -model.objConstant);
+    bool anyRange = false;
+    for (long i = 0; i < m; i++) {
+        if (!keep[i]) continue;
+        const double lb = model.rowLb[i], ub = model.rowUb[i];
+        const double rhs = isNegInf(lb) ? ub : lb;
+        if (rhs != 0) mpsEntry(out, "RHS", rowName(i), "", rhs);
+        if (!isNegInf(lb) && !isInf(ub) && lb != ub) anyRange = true;
+    }
+    if (anyRange) {
+        out.put("RANGES\n");
+        for (long i = 0; i < m; i++) {
+            const double lb = model.rowLb[i], ub = model.rowUb[i];
+            if (keep[i] && !isNegInf(lb) && !isInf(ub) && lb != ub) mpsEntry(out, "RNG", rowName(i), "", ub - lb);
+        }
+    }
+
+    out.put("BOUNDS\n");
+    for (int c = 0; c < n; c++) {
+        const double lb = model.colLb[c], ub = model.colUb[c];
+        const char* name = names[c].c_str();
+        if (model.colType[c] == ColBinary && lb == 0 && ub == 1) {
+            out.put(" BV BND ");
+            out.put(name);
+            out.put('\n');
+            continue;
+        }
+        if (lb == ub) {
+            mpsEntry(out, "FX", "BND", name, lb);
+            continue;
+        }
+        if (isNegInf(lb) && isInf(ub)) {
+            out.put(" FR BND ");
+            out.put(name);
+            out.put('\n');
+            continue;
+        }
+        if (isNegInf(lb)) {
+            out.put(" MI BND ");
+            out.put(name);
+            out.put('\n');
+        } else if (lb != 0) {
+            mpsEntry(out, "LO", "BND", name, lb);
+        }
+        if (!isInf(ub)) mpsEntry(out, "UP", "BND", name, ub);
+    }
+
+    // 目标 0.5 x'Qx：对角元为 2c，非对角元 (i < j) 为 c，只写上三角
+    vector<QuadTerm> quad = mergedQuad(model);
+    if (!quad.empty()) {
+        out.put("QUADOBJ\n");
+        for (size_t t = 0; t < quad.size(); t++) {
+            const double v = quad[t].i == quad[t].j ? 2 * quad[t].coef : quad[t].coef;
+            mpsEntry(out, names[quad[t].i].c_str(), names[quad[t].j].c_str(), "", v);
+        }
+    }
+    out.put("ENDATA\n");
+}
+
+ModelFileFormat modelFileFormat(const string& path) {
+    string p = path;
+    if (p.size() > 3 && p.compare(p.size() - 3, 3, ".gz") == 0) p.resize(p.size() - 3);
+    if (p.size() > 4 && p.compare(p.size() - 4, 4, ".mps") == 0) return FormatMPS;
+    return FormatLP;
+}
+
+bool writeModelFile(const SparseModel& model, const vector<string>& colNames, const string& path) {
+    return writeModelFile(model, colNames, path, modelFileFormat(path));
+}
+
+bool writeModelFile(const SparseModel& model, const vector<string>& colNames, const string& path,
+                    ModelFileFormat format) {
+    if (static_cast<int>(colNames.size()) != model.numCols()) {
+        cerr << "列名数 " << colNames.size() << " 与列数 " << model.numCols() << " 不一致" << endl;
+        return false;
+    }
+    BufferedOutput out;
+    if (!out.open(path)) {
+        cerr << "无法写入模型文件: " << path << endl;
+        return false;
+    }
+    if (format == FormatMPS) writeMPS(out, model, colNames);
+    else writeLP(out, model, colNames);
+    if (!out.close()) {
+        cerr << "写模型文件时出错: " << path << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,24 @@
+#ifndef MODEL_WRITER_H
+#define MODEL_WRITER_H
+
+#include <string>
+#include <vector>
+#include "sparse_model.h"
+
+// 把 SparseModel 直接写成 CPLEX LP 或自由格式 MPS 文件（不经过 CPLEX）。
+// 列名由调用方给出（港口模型见 portColumnNames），行名为 <约束族>_<族内序号>（见 sparse_model.h）。
+// 输出经过大缓冲区顺序写出；文件名以 .gz 结尾时用 gzip 压缩（需要构建时找到 zlib，定义 PORT_HAVE_ZLIB）。
+enum ModelFileFormat {
+    FormatLP,
+    FormatMPS
+};
+
+// 按文件名判断格式：.mps / .mps.gz 为 MPS，其余（.lp / .lp.gz）为 LP
+ModelFileFormat modelFileFormat(const std::string& path);
+
+// 写出模型，失败时（无法打开文件、不支持 gzip、写入出错）在 cerr 报告并返回 false
+bool writeModelFile(const SparseModel& model, const std::vector<std::string>& colNames, const std::string& path);
+bool writeModelFile(const SparseModel& model, const std::vector<std::string>& colNames, const std::string& path,
+                    ModelFileFormat format);
+
+#endif // MODEL_WRITER_H
@@ -0,0 +1,90 @@
+#include "phase_timer.h"
+#include <cstdio>
+#include <algorithm>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+using namespace std;
+
+double currentRssMB() {
+#ifdef __APPLE__
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) return 0.0;
+    return info.resident_size / (1024.0 * 1024.0);
+#else
+    // /proc/self/statm 第二项为常驻页数
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) return 0.0;
+    long size = 0, resident = 0;
+    int n = fscanf(f, "%ld %ld", &size, &resident);
+    fclose(f);
+    if (n != 2) return 0.0;
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#endif
+}
+
+double peakRssMB() {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+#ifdef __APPLE__
+    return ru.ru_maxrss / (1024.0 * 1024.0);   // 字节
+#else
+    return ru.ru_maxrss / 1024.0;              // KB
+#endif
+}
+
+void PhaseProfile::add(const string& name, double wallMs, double cpuMs, double ticks, double memMB, double peakMB) {
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        if (phases_[i].name == name) {
+            phases_[i].wallMs += wallMs;
+            phases_[i].cpuMs += cpuMs;
+            phases_[i].ticks += ticks;
+            phases_[i].memMB += memMB;
+            phases_[i].peakMB = max(phases_[i].peakMB, peakMB);
+            return;
+        }
+    }
+    PhaseRecord r;
+    r.name = name;
+    r.wallMs = wallMs;
+    r.cpuMs = cpuMs;
+    r.ticks = ticks;
+    r.memMB = memMB;
+    r.peakMB = peakMB;
+    phases_.push_back(r);
+}
+
+const PhaseRecord* PhaseProfile::find(const string& name) const {
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        if (phases_[i].name == name) return &phases_[i];
+    }
+    return 0;
+}
+
+PhaseTimer::PhaseTimer(PhaseProfile* profile, const string& prefix) : profile_(profile), prefix_(prefix) {}
+
+PhaseTimer::~PhaseTimer() {
+    end();
+}
+
+void PhaseTimer::begin(const string& name) {
+    if (!profile_) return;
+    end();
+    name_ = name;
+    running_ = true;
+    wall0_ = chrono::steady_clock::now();
+    cpu0_ = clock();
+    rss0_ = currentRssMB();
+}
+
+void PhaseTimer::end(double ticks) {
+    if (!profile_ || !running_) return;
+    double wallMs = chrono::duration<double, milli>(chrono::steady_clock::now() - wall0_).count();
+    double cpuMs = 1000.0 * static_cast<double>(clock() - cpu0_) / CLOCKS_PER_SEC;
+    profile_->add(prefix_ + name_, wallMs, cpuMs, ticks, currentRssMB() - rss0_, peakRssMB());
+    running_ = false;
+}
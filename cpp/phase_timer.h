@@ -0,0 +1,57 @@
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+
+// 分阶段计时记录：墙钟时间、进程 CPU 时间（所有线程合计）、CPLEX 确定性时间（ticks，
+// 只有调用 CPLEX 的阶段才有，由调用方填写）与内存（常驻内存 RSS 的增量及阶段结束时的进程峰值）
+struct PhaseRecord {
+    std::string name;
+    double wallMs = 0.0;
+    double cpuMs = 0.0;
+    double ticks = 0.0;
+    double memMB = 0.0;    // 阶段内 RSS 增量（释放内存的阶段可为负）
+    double peakMB = 0.0;   // 阶段结束时的进程峰值 RSS
+};
+
+// 当前进程的常驻内存与峰值常驻内存（MB），无法读取时返回 0
+double currentRssMB();
+double peakRssMB();
+
+class PhaseProfile {
+public:
+    // 同名阶段多次出现时累加
+    void add(const std::string& name, double wallMs, double cpuMs, double ticks = 0.0,
+             double memMB = 0.0, double peakMB = 0.0);
+    const std::vector<PhaseRecord>& phases() const { return phases_; }
+    const PhaseRecord* find(const std::string& name) const;
+    void clear() { phases_.clear(); }
+
+private:
+    std::vector<PhaseRecord> phases_;
+};
+
+// 顺序阶段计时：begin(name) 结束上一个阶段并开始新阶段，end() 或析构时结束当前阶段
+// profile 为空指针时什么也不做，便于在 buildPortModel 等函数中无条件使用
+class PhaseTimer {
+public:
+    explicit PhaseTimer(PhaseProfile* profile, const std::string& prefix = std::string());
+    ~PhaseTimer();
+
+    void begin(const std::string& name);
+    void end(double ticks = 0.0);
+
+private:
+    PhaseProfile* profile_;
+    std::string prefix_;
+    std::string name_;
+    bool running_ = false;
+    std::chrono::steady_clock::time_point wall0_;
+    std::clock_t cpu0_ = 0;
+    double rss0_ = 0.0;
+};
+
+#endif // PHASE_TIMER_H
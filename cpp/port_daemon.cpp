@@ -0,0 +1,549 @@
+// 常驻求解服务：在 Unix 域套接字上接受求解 / 重排请求，算例参数与已建好的模型（Rescheduler，见 reschedule.h）
+// 留在内存中，后续请求不再付出进程启动、读入 CSV 与完整建模的开销。
+//
+// 协议：每行一个请求（参数以空白分隔，格式同命令行），每行一个响应记录，第一个字段为记录类型、第二个为请求编号：
+//   solve --input=算例前缀 [--session=名] [--output=目录] [--time-limit=秒] [--threads=N] [verify 的建模选项]
+//         读入算例（同一前缀只读一次）、新建会话（默认以算例前缀为名，已有的同名会话被替换）并求解
+//   resolve --session=名 [--event=事件]... [--time-limit=秒] [--threads=N] [--output=目录]
+//         在会话的常驻模型上依次应用事件（格式见 reschedule.h，如 --event=arrival,3,40 --event=now,12），
+//         以上一次的计划为初始解重新求解
+//   status | drop --session=名 | shutdown（排队中的请求被取消，正在执行的请求完成后退出）
+// 响应：accepted <编号> queued=<排队数> | started <编号> threads=<N> waited=<秒> | log <编号> <文本> |
+//       event <编号> <事件> ok|rejected | sync <编号> ms=.. rows_added=.. rows_removed=.. cols_added=.. cols_removed=.. bounds_changed=.. |
+//       progress <编号> seconds=.. nodes=.. incumbent=.. bound=.. gap=.. |
+//       ship <编号> id=<稳定编号> berth=<泊位> start=<开始时间> holds=<行:首槽-末槽,...> |
+//       done <编号> status=.. objective=.. bound=.. gap=.. solve_s=.. seconds=.. | error <编号> <说明>
+// 一个连接可以依次发送多个请求，各请求的记录按产生的先后写回同一连接（按编号区分）。
+//
+// 调度：请求按到达顺序排队，共用 --threads=T 个 CPLEX 线程（默认核数）；每个请求占用 --threads=N 个
+// （默认 --job-threads，不超过 T）。队首可运行的请求线程不够时等待，不被后面的请求越过；
+// 同一会话的请求依次执行（Rescheduler 不是线程安全的），其它会话的请求可以越过它。
+// 内存中最多保留 --max-sessions 个会话与算例参数，超过时释放最久未用、没有正在执行或排队请求的会话。
+//
+// 用法: ./port_daemon [--socket=路径] [--threads=T] [--job-threads=N] [--max-sessions=N] [--progress=秒] [verify 的建模选项（会话默认值）]
+// 例: echo "solve --input=data/example_5/params_output --time-limit=30" | socat - UNIX-CONNECT:/tmp/port_daemon.sock
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "model_options.h"
+#include "port_solution.h"
+#include "reschedule.h"
+
+using namespace std;
+
+// 一个客户端连接：多个工作线程可能同时写回记录
+struct Connection {
+    int fd;
+    mutex lock;
+    atomic<bool> closed{false};   // 读取线程已退出（客户端关闭或服务退出）
+    explicit Connection(int f) : fd(f) {}
+    ~Connection() { close(fd); }
+    // 写一行记录；客户端已断开时丢弃（求解照常完成，结果仍留在会话中）
+    void send(const string& line) {
+        const string text = line + "\n";
+        lock_guard<mutex> g(lock);
+        size_t done = 0;
+        while (done < text.size()) {
+            const ssize_t n = ::send(fd, text.data() + done, text.size() - done, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            done += static_cast<size_t>(n);
+        }
+    }
+};
+
+// 常驻的会话：一个 Rescheduler（自带 IloEnv 与模型）及其日志缓冲
+struct Session {
+    ostringstream log;
+    unique_ptr<Rescheduler> rescheduler;
+    long lastUsed = 0;
+};
+
+enum JobKind {
+    JobSolve,
+    JobResolve
+};
+
+struct Job {
+    long id = 0;
+    JobKind kind = JobSolve;
+    string session, input, output;
+    ModelOptions opts;               // JobSolve：会话的建模选项；两者都用其 timeLimit
+    vector<ScheduleEvent> events;    // JobResolve
+    int threads = 1;
+    chrono::steady_clock::time_point queued;
+    shared_ptr<Connection> conn;
+};
+
+// 求解过程中按 --progress 的间隔与每次 incumbent 改进向客户端写 progress 记录
+class ProgressStream : public IloCplex::Callback::Function {
+public:
+    ProgressStream(Connection& conn, long id, double interval) : conn_(conn), id_(id), interval_(interval) {}
+    void invoke(const IloCplex::Callback::Context& context) {
+        if (!context.inGlobalProgress()) return;
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0_).count();
+        const bool feasible = context.getIntInfo(IloCplex::Callback::Context::Info::Feasible) != 0;
+        const double incumbent = feasible ? context.getDoubleInfo(IloCplex::Callback::Context::Info::BestSolution) : 0.0;
+        const double bound = context.getDoubleInfo(IloCplex::Callback::Context::Info::BestBound);
+        const long long nodes = context.getLongInfo(IloCplex::Callback::Context::Info::NodeCount);
+        lock_guard<mutex> g(lock_);
+        const bool improved = feasible && (!haveIncumbent_ || incumbent < best_ - 1e-9 * max(1.0, fabs(best_)));
+        if (!improved && (interval_ <= 0 || seconds - last_ < interval_)) return;
+        if (improved) {
+            haveIncumbent_ = true;
+            best_ = incumbent;
+        }
+        last_ = seconds;
+        char buf[256];
+        if (feasible) {
+            snprintf(buf, sizeof(buf), "progress %ld seconds=%.3f nodes=%lld incumbent=%.10g bound=%.10g gap=%.6g", id_, seconds,
+                     nodes, incumbent, bound, fabs(incumbent - bound) / (1e-10 + fabs(incumbent)));
+        } else {
+            snprintf(buf, sizeof(buf), "progress %ld seconds=%.3f nodes=%lld incumbent= bound=%.10g gap=", id_, seconds, nodes, bound);
+        }
+        conn_.send(buf);
+    }
+
+private:
+    Connection& conn_;
+    long id_;
+    double interval_;
+    mutex lock_;
+    chrono::steady_clock::time_point t0_ = chrono::steady_clock::now();
+    double last_ = 0.0;
+    bool haveIncumbent_ = false;
+    double best_ = 0.0;
+};
+
+class SolverDaemon {
+public:
+    SolverDaemon(const ModelOptions& defaults, int threads, int jobThreads, int maxSessions)
+        : defaults_(defaults), budget_(threads), free_(threads), jobThreads_(jobThreads), maxSessions_(maxSessions) {}
+
+    // 处理一行请求：status / drop / shutdown 立即回复，solve / resolve 排队
+    void handle(const string& line, const shared_ptr<Connection>& conn);
+    // 工作线程：按调度规则取出请求并执行，shutdown 后返回
+    void work();
+    bool stopping() const { return stop_; }
+    void stop();
+
+private:
+    bool parseJob(const vector<string>& args, Job& job, string& error) const;
+    void run(Job& job);
+    // 算例参数（按前缀缓存）与会话；调用时不持有 lock_
+    bool loadParams(const string& input, ModelParams& params);
+    shared_ptr<Session> session(const string& name);
+    void evict();
+    void flushLog(Session& s, const Job& job);
+
+    ModelOptions defaults_;
+    const int budget_;
+    int free_;
+    const int jobThreads_;
+    const size_t maxSessions_;
+    atomic<bool> stop_{false};
+    atomic<long> nextId_{1};
+
+    mutex lock_;                       // 保护以下成员
+    condition_variable changed_;
+    deque<Job> queue_;
+    set<string> running_;              // 正在执行请求的会话名
+    map<string, shared_ptr<Session>> sessions_;
+    map<string, ModelParams> instances_;
+    deque<string> instanceOrder_;
+    long clock_ = 0;
+};
+
+bool SolverDaemon::parseJob(const vector<string>& args, Job& job, string& error) const {
+    job.kind = args[0] == "solve" ? JobSolve : JobResolve;
+    job.opts = defaults_;
+    int threads = 0;
+    for (size_t i = 1; i < args.size(); ++i) {
+        const string& arg = args[i];
+        if (arg.compare(0, 8, "--input=") == 0 && job.kind == JobSolve) {
+            job.input = arg.substr(8);
+        } else if (arg.compare(0, 10, "--session=") == 0) {
+            job.session = arg.substr(10);
+        } else if (arg.compare(0, 9, "--output=") == 0) {
+            job.output = arg.substr(9);
+        } else if (arg.compare(0, 8, "--event=") == 0 && job.kind == JobResolve) {
+            ScheduleEvent event;
+            if (!parseScheduleEvent(arg.substr(8), event)) {
+                error = "无效的事件 " + arg.substr(8);
+                return false;
+            }
+            job.events.push_back(event);
+        } else if (job.kind == JobSolve || arg.compare(0, 13, "--time-limit=") == 0 || arg.compare(0, 10, "--threads=") == 0) {
+            // 会话建好后建模形式不能再改，resolve 只接受时间与线程
+            if (!parseModelOption(arg, job.opts)) {
+                error = "无法识别的参数 " + arg;
+                return false;
+            }
+            if (arg.compare(0, 10, "--threads=") == 0) threads = job.opts.threads;
+        } else {
+            error = "无法识别的参数 " + arg;
+            return false;
+        }
+    }
+    if (job.kind == JobSolve && job.input.empty()) {
+        error = "solve 需要 --input=算例前缀";
+        return false;
+    }
+    if (job.session.empty()) {
+        if (job.kind == JobResolve) {
+            error = "resolve 需要 --session=名";
+            return false;
+        }
+        job.session = job.input;
+    }
+    job.threads = min(threads > 0 ? threads : jobThreads_, budget_);
+    job.opts.threads = job.threads;
+    return true;
+}
+
+void SolverDaemon::handle(const string& line, const shared_ptr<Connection>& conn) {
+    istringstream in(line);
+    vector<string> args;
+    string w;
+    while (in >> w) args.push_back(w);
+    if (args.empty()) return;
+    const long id = nextId_++;
+    ostringstream reply;
+
+    if (args[0] == "status") {
+        lock_guard<mutex> g(lock_);
+        reply << "status " << id << " queued=" << queue_.size() << " running=" << running_.size() << " free_threads=" << free_
+              << " threads=" << budget_ << " sessions=";
+        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) reply << (it == sessions_.begin() ? "" : ",") << it->first;
+    } else if (args[0] == "drop") {
+        const string name = args.size() == 2 && args[1].compare(0, 10, "--session=") == 0 ? args[1].substr(10) : "";
+        lock_guard<mutex> g(lock_);
+        bool queued = false;
+        for (size_t i = 0; i < queue_.size(); ++i) queued = queued || queue_[i].session == name;
+        if (!sessions_.count(name)) reply << "error " << id << " 没有会话 " << name;
+        else if (running_.count(name) || queued) reply << "error " << id << " 会话 " << name << " 还有未完成的请求";
+        else {
+            sessions_.erase(name);
+            reply << "done " << id << " dropped=" << name;
+        }
+    } else if (args[0] == "shutdown") {
+        stop();
+        reply << "done " << id << " shutdown";
+    } else if (args[0] == "solve" || args[0] == "resolve") {
+        Job job;
+        string error;
+        if (stop_) {
+            reply << "error " << id << " 服务正在退出";
+        } else if (!parseJob(args, job, error)) {
+            reply << "error " << id << " " << error;
+        } else {
+            job.id = id;
+            job.conn = conn;
+            job.queued = chrono::steady_clock::now();
+            // accepted 须先于工作线程的 started 写出，因此在入队前回复
+            lock_guard<mutex> g(lock_);
+            conn->send("accepted " + to_string(id) + " queued=" + to_string(queue_.size() + 1));
+            queue_.push_back(job);
+            changed_.notify_all();
+            return;
+        }
+    } else {
+        reply << "error " << id << " 未知的请求 " << args[0] << "（可选 solve / resolve / status / drop / shutdown）";
+    }
+    conn->send(reply.str());
+}
+
+void SolverDaemon::stop() {
+    lock_guard<mutex> g(lock_);
+    stop_ = true;
+    // 排队中的请求不再执行
+    for (size_t i = 0; i < queue_.size(); ++i) queue_[i].conn->send("error " + to_string(queue_[i].id) + " 服务正在退出");
+    queue_.clear();
+    changed_.notify_all();
+}
+
+void SolverDaemon::work() {
+    for (;;) {
+        Job job;
+        {
+            unique_lock<mutex> g(lock_);
+            // 按到达顺序取第一个会话空闲的请求；它的线程不够时等待（不让后面的请求越过）
+            auto pick = [&]() {
+                for (size_t i = 0; i < queue_.size(); ++i) {
+                    if (running_.count(queue_[i].session)) continue;
+                    return queue_[i].threads <= free_ ? static_cast<long>(i) : -1L;
+                }
+                return -1L;
+            };
+            long i = -1;
+            changed_.wait(g, [&]() { return stop_ || (i = pick()) >= 0; });
+            if (stop_) return;
+            job = queue_[i];
+            queue_.erase(queue_.begin() + i);
+            running_.insert(job.session);
+            free_ -= job.threads;
+        }
+        run(job);
+        {
+            lock_guard<mutex> g(lock_);
+            running_.erase(job.session);
+            free_ += job.threads;
+            changed_.notify_all();
+        }
+    }
+}
+
+bool SolverDaemon::loadParams(const string& input, ModelParams& params) {
+    {
+        lock_guard<mutex> g(lock_);
+        auto it = instances_.find(input);
+        if (it != instances_.end()) {
+            params = it->second;
+            return true;
+        }
+    }
+    if (!loadParamsAuto(input, params)) return false;
+    lock_guard<mutex> g(lock_);
+    if (instances_.insert(make_pair(input, params)).second) instanceOrder_.push_back(input);
+    while (instances_.size() > maxSessions_) {
+        instances_.erase(instanceOrder_.front());
+        instanceOrder_.pop_front();
+    }
+    return true;
+}
+
+shared_ptr<Session> SolverDaemon::session(const string& name) {
+    lock_guard<mutex> g(lock_);
+    auto it = sessions_.find(name);
+    if (it == sessions_.end()) return shared_ptr<Session>();
+    it->second->lastUsed = ++clock_;
+    return it->second;
+}
+
+// 会话数超过上限时释放最久未用的空闲会话（与 drop 相同，正在执行或还有排队请求的会话不释放）
+void SolverDaemon::evict() {
+    lock_guard<mutex> g(lock_);
+    set<string> queued;
+    for (size_t i = 0; i < queue_.size(); ++i) queued.insert(queue_[i].session);
+    while (sessions_.size() > maxSessions_) {
+        auto oldest = sessions_.end();
+        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+            if (running_.count(it->first) || queued.count(it->first)) continue;
+            if (oldest == sessions_.end() || it->second->lastUsed < oldest->second->lastUsed) oldest = it;
+        }
+        if (oldest == sessions_.end()) return;
+        sessions_.erase(oldest);
+    }
+}
+
+void SolverDaemon::flushLog(Session& s, const Job& job) {
+    istringstream in(s.log.str());
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty()) job.conn->send("log " + to_string(job.id) + " " + line);
+    }
+    s.log.str("");
+}
+
+void SolverDaemon::run(Job& job) {
+    const auto start = chrono::steady_clock::now();
+    const double waited = chrono::duration<double>(start - job.queued).count();
+    Connection& conn = *job.conn;
+    const string id = to_string(job.id);
+    ostringstream started;
+    started << "started " << id << " threads=" << job.threads << " waited=" << waited;
+    conn.send(started.str());
+
+    shared_ptr<Session> s;
+    if (job.kind == JobSolve) {
+        ModelParams params;
+        if (!loadParams(job.input, params)) {
+            conn.send("error " + id + " 无法读入算例 " + job.input);
+            return;
+        }
+        s = make_shared<Session>();
+        s->rescheduler.reset(new Rescheduler(params, job.opts, s->log));
+        {
+            lock_guard<mutex> g(lock_);
+            s->lastUsed = ++clock_;
+            sessions_[job.session] = s;
+        }
+        evict();
+    } else {
+        s = session(job.session);
+        if (!s) {
+            conn.send("error " + id + " 没有会话 " + job.session);
+            return;
+        }
+        Rescheduler& r = *s->rescheduler;
+        for (size_t i = 0; i < job.events.size(); ++i) {
+            const bool ok = r.apply(job.events[i]);
+            conn.send("event " + id + " " + scheduleEventText(job.events[i]) + (ok ? " ok" : " rejected"));
+        }
+    }
+    Rescheduler& r = *s->rescheduler;
+    r.setThreads(job.threads);
+    flushLog(*s, job);
+
+    PortSolution sol;
+    RescheduleReport rep;
+    ProgressStream progress(conn, job.id, defaults_.progressInterval);
+    const bool ok = r.resolve(job.opts.timeLimit, sol, &rep, &progress, IloCplex::Callback::Context::Id::GlobalProgress);
+    flushLog(*s, job);
+
+    char buf[512];
+    snprintf(buf, sizeof(buf), "sync %s ms=%.1f rows_added=%ld rows_removed=%ld cols_added=%ld cols_removed=%ld bounds_changed=%ld",
+             id.c_str(), rep.syncMs, rep.rowsAdded, rep.rowsRemoved, rep.colsAdded, rep.colsRemoved, rep.boundsChanged);
+    conn.send(buf);
+    if (ok) {
+        const ModelParams& params = r.params();
+        for (int i = 0; i < params.numShips; ++i) {
+            ostringstream ship;
+            ship << "ship " << id << " id=" << r.shipIds()[i] << " berth=" << sol.berth[i] << " start=" << sol.e[i] << " holds=";
+            for (int k = 0; k < params.numShipK; ++k) {
+                ship << (k ? "," : "");
+                if (sol.slots[i][k].empty()) ship << "-";
+                else ship << sol.row[i][k] << ":" << sol.slots[i][k].front() << "-" << sol.slots[i][k].back();
+            }
+            conn.send(ship.str());
+        }
+        if (!job.output.empty() && !writeSolutionCSV(params, sol, job.output)) {
+            conn.send("error " + id + " 写输出文件时出错: " + job.output);
+        }
+    }
+    snprintf(buf, sizeof(buf), "done %s status=%s objective=%.10g bound=%.10g gap=%.6g solve_s=%.3f seconds=%.3f", id.c_str(),
+             rep.status.c_str(), ok ? rep.objective : 0.0, ok ? rep.bound : 0.0, ok ? rep.gap : 0.0, rep.solveSeconds,
+             chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    conn.send(buf);
+}
+
+// 读一个连接上的请求行，直到客户端关闭
+static void serveConnection(SolverDaemon& daemon, shared_ptr<Connection> conn) {
+    string buffer;
+    char chunk[4096];
+    for (;;) {
+        const ssize_t n = recv(conn->fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) break;
+        buffer.append(chunk, static_cast<size_t>(n));
+        size_t eol;
+        while ((eol = buffer.find('\n')) != string::npos) {
+            string line = buffer.substr(0, eol);
+            buffer.erase(0, eol + 1);
+            if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+            daemon.handle(line, conn);
+        }
+    }
+    if (!buffer.empty()) daemon.handle(buffer, conn);
+    conn->closed = true;
+}
+
+// 连接的读取线程：main 跟踪全部连接，退出前关闭套接字并等待线程结束，再销毁 SolverDaemon
+struct ConnectionThread {
+    shared_ptr<Connection> conn;
+    thread reader;
+};
+
+int main(int argc, char** argv) {
+    ModelOptions opts;
+    opts.transshipment = TransSlot;
+    opts.timeLimit = 60;
+    opts.progressInterval = 5;
+    string socketPath = "/tmp/port_daemon.sock";
+    int threads = static_cast<int>(thread::hardware_concurrency()), jobThreads = 0, maxSessions = 8;
+    if (threads < 1) threads = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 9, "--socket=") == 0) {
+            socketPath = arg.substr(9);
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            threads = atoi(arg.c_str() + 10);
+            if (threads <= 0) { cerr << "无效的线程数: " << arg << endl; return 1; }
+        } else if (arg.compare(0, 14, "--job-threads=") == 0) {
+            jobThreads = atoi(arg.c_str() + 14);
+            if (jobThreads <= 0) { cerr << "无效的线程数: " << arg << endl; return 1; }
+        } else if (arg.compare(0, 15, "--max-sessions=") == 0) {
+            maxSessions = atoi(arg.c_str() + 15);
+            if (maxSessions <= 0) { cerr << "无效的会话数: " << arg << endl; return 1; }
+        } else if (!parseModelOption(arg, opts)) {
+            return 1;
+        }
+    }
+    if (jobThreads <= 0 || jobThreads > threads) jobThreads = threads;
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        cerr << "套接字路径过长: " << socketPath << endl;
+        return 1;
+    }
+    strcpy(addr.sun_path, socketPath.c_str());
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 16) != 0) {
+        cerr << "无法监听 " << socketPath << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    cout << "监听 " << socketPath << " | CPLEX 线程 " << threads << "（每个请求默认 " << jobThreads << "）| 会话上限 " << maxSessions
+         << " | 转运成本 " << transshipmentFormName(opts.transshipment) << " | 先后关系 " << sequencingFormName(opts.sequencing)
+         << " | 堆场 " << yardFormName(opts.yard) << " | 默认时间限制 " << opts.timeLimit << " 秒" << endl;
+
+    SolverDaemon daemon(opts, threads, jobThreads, maxSessions);
+    // 每个请求至少一个线程，同时执行的请求不超过线程预算
+    vector<thread> workers;
+    for (int i = 0; i < threads; ++i) workers.push_back(thread([&daemon]() { daemon.work(); }));
+
+    list<ConnectionThread> connections;
+    while (!daemon.stopping()) {
+        // 回收客户端已关闭的连接线程
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (!it->conn->closed) { ++it; continue; }
+            it->reader.join();
+            it = connections.erase(it);
+        }
+        pollfd p;
+        p.fd = listener;
+        p.events = POLLIN;
+        if (poll(&p, 1, 200) <= 0) continue;
+        const int fd = accept(listener, 0, 0);
+        if (fd < 0) continue;
+        // 连接线程在客户端关闭前一直读取
+        connections.push_back(ConnectionThread());
+        connections.back().conn = make_shared<Connection>(fd);
+        connections.back().reader = thread(serveConnection, ref(daemon), connections.back().conn);
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+    // 请求都已结束；关闭仍打开的连接使 recv 返回，等待读取线程退出后 daemon 才能析构
+    for (auto it = connections.begin(); it != connections.end(); ++it) {
+        shutdown(it->conn->fd, SHUT_RDWR);
+        it->reader.join();
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+    cout << "已退出" << endl;
+    return 0;
+}
@@ -0,0 +1,816 @@
+#include "port_ir.h"
+#include "yard_pool.h"
+#include "phase_timer.h"
+#include "model_bounds.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+
+using namespace std;
+
+// 每单位槽位的货物重量 w_sk = gamma_s / (n_sk * K)
+static double slotWeight(const ModelParams& params, int s, int k) {
+    return params.cargoWeight[s] / (params.requiredSlots[s][k] * params.numShipK);
+}
+
+int PortIndex::placeStarts(const ModelParams& params, int s, int k) const {
+    const int n = params.requiredSlots[s][k];
+    return n > 0 ? max(V - n + 1, 0) : 0;
+}
+
+// 追加 n 个列，把下标依次写入 cols
+static void addFamily(SparseModel& m, vector<int>& cols, size_t n, double lb, double ub, ColumnType type) {
+    int first = m.addColumns(static_cast<int>(n), lb, ub, type);
+    cols.resize(n);
+    for (size_t i = 0; i < n; i++) cols[i] = first + static_cast<int>(i);
+}
+
+// 线性化转运成本（按槽）：每个 (s,k,r,v) 一个连续变量 u_skrv >= 0
+//   u_skrv >= w_sk * (sum_b d_brv z_sb - dmax_rv * (1 - x_skrv))
+//   u_skrv >= w_sk * dmin_rv * x_skrv
+// x=1 时第一式在所选泊位处取等，恰为 d_brv * w_sk；x=0 时右端 <= 0（sum_b z_sb = 1）。
+// 第二式是有效不等式，用于收紧 LP 松弛。最小化下与 x·z 乘积形式最优值相同。
+static void addSlotTransshipmentCost(const ModelParams& params, SparseModel& m, PortIndex& idx) {
+    const int S = idx.S, K = idx.K, B = idx.B, R = idx.R, V = idx.V;
+    vector<double> dmax(R * V, 0.0), dmin(R * V, 0.0);
+    for (int r = 0; r < R; r++) {
+        for (int v = 0; v < V; v++) {
+            double lo = 0.0, hi = 0.0;
+            for (int b = 0; b < B; b++) {
+                double d = params.transshipmentCost(b,r,v);
+                if (b == 0 || d < lo) lo = d;
+                if (b == 0 || d > hi) hi = d;
+            }
+            dmin[r * V + v] = lo;
+            dmax[r * V + v] = hi;
+        }
+    }
+
+    addFamily(m, idx.transSlot, static_cast<size_t>(S) * K * R * V, 0, SPARSE_INF, ColContinuous);
+    m.beginRowFamily("trans_slot");
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            double w = slotWeight(params, s, k);
+            for (int r = 0; r < R; r++) {
+                for (int v = 0; v < V; v++) {
+                    const int u = idx.transSlotCol(s, k, r, v);
+                    m.addTerm(u, 1);
+                    for (int b = 0; b < B; b++) m.addTerm(idx.zCol(s, b), -w * params.transshipmentCost(b,r,v));
+                    m.addTerm(idx.xCol(s, k, r, v), -w * dmax[r * V + v]);
+                    m.addRow(-w * dmax[r * V + v], SPARSE_INF);
+                    m.addTerm(u, 1);
+                    m.addTerm(idx.xCol(s, k, r, v), -w * dmin[r * V + v]);
+                    m.addRow(0, SPARSE_INF);
+                    m.addObjective(u, params.alpha);
+                }
+            }
+        }
+    }
+}
+
+// 线性化转运成本（按泊位）：每个 (s,b) 一个连续变量 T_sb >= 0
+//   T_sb >= sum_k w_sk sum_rv d_brv x_skrv - M_sb * (1 - z_sb)
+// M_sb = sum_k w_sk * (泊位 b 上最大的 n_sk 个 d_brv 之和)，是左端和式的精确上界，
+// 因此 z_sb = 0 时约束不起作用，z_sb = 1 时 T_sb 恰为该船在泊位 b 的转运成本。
+static void addBerthTransshipmentCost(const ModelParams& params, SparseModel& m, PortIndex& idx) {
+    const int S = idx.S, K = idx.K, B = idx.B, R = idx.R, V = idx.V;
+    // topSum[b][n] = 泊位 b 上最大的 n 个转运成本之和
+    vector<vector<double>> topSum(B, vector<double>(R * V + 1, 0.0));
+    for (int b = 0; b < B; b++) {
+        vector<double> d(params.transshipmentCost.row(b, 0), params.transshipmentCost.row(b, 0) + R * V);
+        sort(d.begin(), d.end(), greater<double>());
+        for (int n = 0; n < R * V; n++) topSum[b][n + 1] = topSum[b][n] + d[n];
+    }
+
+    addFamily(m, idx.transBerth, static_cast<size_t>(S) * B, 0, SPARSE_INF, ColContinuous);
+    m.beginRowFamily("trans_berth");
+    for (int s = 0; s < S; s++) {
+        for (int b = 0; b < B; b++) {
+            const int T = idx.transBerthCol(s, b);
+            m.addTerm(T, 1);
+            double M = 0.0;
+            for (int k = 0; k < K; k++) {
+                double w = slotWeight(params, s, k);
+                int n = min(max(params.requiredSlots[s][k], 0), R * V);
+                M += w * topSum[b][n];
+                for (int r = 0; r < R; r++) {
+                    for (int v = 0; v < V; v++) m.addTerm(idx.xCol(s, k, r, v), -w * params.transshipmentCost(b,r,v));
+                }
+            }
+            m.addTerm(idx.zCol(s, b), -M);
+            m.addRow(-M, SPARSE_INF);
+            m.addObjective(T, params.alpha);
+        }
+    }
+}
+
+// 起点形式的堆场模型：货舱 (s,k) 的 n_sk 个槽必须是同一行内的连续一段，因此放置方案完全由
+// (行 r, 起点 j) 决定。每个可行 (s,k,r,j)（j = 0..V-n_sk）一个二元变量 place_skrj：
+//   sum_{r,j} place_skrj = 1                                     每个货舱恰好一个位置（替代 3.11, 3.13, 3.14, 12-14）
+//   sum_{s,k} sum_{j <= v < j+n_sk} place_skrj <= 1  (每个 r,v)   每个槽最多被一段覆盖（替代 3.12）
+// 块成本预先计算：在泊位 b 的转运成本 c_b = w_sk * sum_{v=j}^{j+n_sk-1} d_brv（前缀和），
+// 存储成本 n_sk * phi_skr。转运项按 opts.transshipment 在块级别建模：
+//   product: sum_b c_b * place * z_sb
+//   slot:    每块一个 u >= sum_b c_b z_sb - cmax (1 - place)，u >= cmin * place
+//   berth:   每个 (s,b) 一个 T_sb >= sum_{k,块} c_b place - M_sb (1 - z_sb)，M_sb = sum_k max 块成本
+// pool 非空时只创建列池中的放置（YardColumns），其余位置为 -1。
+static void addBlockYard(const ModelParams& params, const ModelOptions& opts, SparseModel& m, PortIndex& idx,
+                         const YardColumnPool* pool) {
+    const int S = idx.S, K = idx.K, B = idx.B, R = idx.R, V = idx.V;
+    const double alpha = params.alpha;
+    // prefix[(b*R + r)*(V+1) + v] = sum_{u<v} d_bru
+    vector<double> prefix(static_cast<size_t>(B) * R * (V + 1), 0.0);
+    for (int b = 0; b < B; b++) {
+        for (int r = 0; r < R; r++) {
+            double* p = &prefix[(static_cast<size_t>(b) * R + r) * (V + 1)];
+            const param_t* d = params.transshipmentCost.row(b, r);
+            for (int v = 0; v < V; v++) p[v + 1] = p[v] + d[v];
+        }
+    }
+
+    // 放置列：按 (s,k,r,j) 顺序连续编号
+    idx.place.assign(static_cast<size_t>(S) * K * R * V, -1);
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            const int starts = idx.placeStarts(params, s, k);
+            for (int r = 0; r < R; r++) {
+                for (int j = 0; j < starts; j++) {
+                    if (pool && !pool->contains(s, k, r, j)) continue;
+                    idx.place[idx.slotIndex(s, k, r, j)] = m.addColumns(1, 0, 1, ColBinary);
+                }
+            }
+        }
+    }
+    if (opts.transshipment == TransSlot) {
+        idx.transSlot.assign(idx.place.size(), -1);
+        for (size_t i = 0; i < idx.place.size(); i++) {
+            if (idx.place[i] >= 0) idx.transSlot[i] = m.addColumns(1, 0, SPARSE_INF, ColContinuous);
+        }
+    } else if (opts.transshipment == TransBerth) {
+        addFamily(m, idx.transBerth, static_cast<size_t>(S) * B, 0, SPARSE_INF, ColContinuous);
+    }
+
+    // 每槽的覆盖列表（CSR）：coverStart[i]..coverStart[i+1] 为覆盖槽 i = r*V+v 的放置列
+    vector<long> coverStart(static_cast<size_t>(R) * V + 1, 0);
+    vector<double> c(B);
+    vector<int> assign;
+    // 约束族：每块的转运线性化、每个货舱的分配、每船每泊位的转运成本、每槽的覆盖
+    const int linkRows = m.rowFamilyId("trans_slot"), assignRows = m.rowFamilyId("yard_assign");
+    const int berthRows = m.rowFamilyId("trans_berth"), coverRows = m.rowFamilyId("yard_cover");
+    for (int s = 0; s < S; s++) {
+        // TransBerth: berthPlaces / berthCosts[b] 为该船各放置及其在泊位 b 的块成本，M[b] = sum_k max 块成本
+        vector<int> berthPlaces;
+        vector<vector<double>> berthCosts(opts.transshipment == TransBerth ? B : 0);
+        vector<double> M(B, 0.0);
+
+        for (int k = 0; k < K; k++) {
+            const int n = params.requiredSlots[s][k];
+            const int starts = idx.placeStarts(params, s, k);
+            const double w = n > 0 ? slotWeight(params, s, k) : 0.0;
+            vector<double> blockMax(B, 0.0);
+            assign.clear();
+
+            for (int r = 0; r < R; r++) {
+                for (int j = 0; j < starts; j++) {
+                    const int p = idx.placeCol(s, k, r, j);
+                    if (p < 0) continue;
+                    assign.push_back(p);
+                    for (int v = j; v < j + n; v++) coverStart[r * V + v + 1]++;
+
+                    // 块成本
+                    double cmin = 0.0, cmax = 0.0;
+                    for (int b = 0; b < B; b++) {
+                        const double* pre = &prefix[(static_cast<size_t>(b) * R + r) * (V + 1)];
+                        c[b] = w * (pre[j + n] - pre[j]);
+                        if (b == 0 || c[b] < cmin) cmin = c[b];
+                        if (b == 0 || c[b] > cmax) cmax = c[b];
+                        blockMax[b] = max(blockMax[b], c[b]);
+                    }
+                    m.addObjective(p, alpha * params.storageCost(s,k,r) * n);
+
+                    if (opts.transshipment == TransProduct) {
+                        for (int b = 0; b < B; b++) m.addQuadObjective(p, idx.zCol(s, b), alpha * c[b]);
+                    } else if (opts.transshipment == TransSlot) {
+                        const int u = idx.transSlotCol(s, k, r, j);
+                        m.useRowFamily(linkRows);
+                        m.addTerm(u, 1);
+                        for (int b = 0; b < B; b++) m.addTerm(idx.zCol(s, b), -c[b]);
+                        m.addTerm(p, -cmax);
+                        m.addRow(-cmax, SPARSE_INF);
+                        m.addTerm(u, 1);
+                        m.addTerm(p, -cmin);
+                        m.addRow(0, SPARSE_INF);
+                        m.addObjective(u, alpha);
+                    } else {
+                        berthPlaces.push_back(p);
+                        for (int b = 0; b < B; b++) berthCosts[b].push_back(c[b]);
+                    }
+                }
+            }
+            // n_sk <= 0 的货舱不占用堆场；n_sk > V 时没有可行起点，模型不可行（与逐槽形式一致）
+            if (n > 0) {
+                if (starts == 0) cerr << "船舶 " << s << " 货舱 " << k << " 需要 " << n << " 个槽，超过每行槽数 " << V << endl;
+                m.useRowFamily(assignRows);
+                for (size_t i = 0; i < assign.size(); i++) m.addTerm(assign[i], 1);
+                m.addRow(1, 1);
+            }
+            for (int b = 0; b < B; b++) M[b] += blockMax[b];
+        }
+
+        if (opts.transshipment == TransBerth) {
+            m.useRowFamily(berthRows);
+            for (int b = 0; b < B; b++) {
+                const int T = idx.transBerthCol(s, b);
+                m.addTerm(T, 1);
+                for (size_t i = 0; i < berthPlaces.size(); i++) m.addTerm(berthPlaces[i], -berthCosts[b][i]);
+                m.addTerm(idx.zCol(s, b), -M[b]);
+                m.addRow(-M[b], SPARSE_INF);
+                m.addObjective(T, alpha);
+            }
+        }
+    }
+
+    // 覆盖行：按槽计数做前缀和，再把每个放置填入它覆盖的槽
+    for (int i = 0; i < R * V; i++) coverStart[i + 1] += coverStart[i];
+    vector<int> cover(coverStart[R * V]);
+    vector<long> fill(coverStart.begin(), coverStart.end() - 1);
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            const int n = params.requiredSlots[s][k];
+            for (int r = 0; r < R; r++) {
+                for (int j = 0; j < idx.placeStarts(params, s, k); j++) {
+                    const int p = idx.placeCol(s, k, r, j);
+                    if (p < 0) continue;
+                    for (int v = j; v < j + n; v++) cover[fill[r * V + v]++] = p;
+                }
+            }
+        }
+    }
+    m.useRowFamily(coverRows);
+    for (int i = 0; i < R * V; i++) {
+        if (coverStart[i] == coverStart[i + 1]) continue;
+        for (long t = coverStart[i]; t < coverStart[i + 1]; t++) m.addTerm(cover[t], 1);
+        m.addRow(-SPARSE_INF, 1);
+    }
+}
+
+// 按时间窗已消去先后变量的船对 (s < t) 在泊位 b 上的约束（relation 不是 PairConflict，见 PortBounds::pairRelation）：
+// 互斥时 z_sb + z_tb <= 1（写到 m），单向时一条同泊位才激活的不重叠约束（写到 overlap）
+//   e_s + p_sb - e_t <= M_st * (2 - z_sb - z_tb)
+static void addEliminatedPair(const PortBounds& bounds, PairRelation relation, int s, int t, int b,
+                              SparseModel& m, SparseModel& overlap, int excludeRows, int overlapRows, const PortIndex& idx) {
+    const int zs = idx.zCol(s, b), zt = idx.zCol(t, b);
+    if (relation == PairExcluded) {
+        m.useRowFamily(excludeRows);
+        m.addTerm(zs, 1); m.addTerm(zt, 1); m.addRow(-SPARSE_INF, 1);
+        return;
+    }
+    if (relation != PairFirstBefore && relation != PairSecondBefore) return;
+    const int first = relation == PairFirstBefore ? s : t, second = relation == PairFirstBefore ? t : s;
+    const double M = bounds.overlapM(first, second, b);
+    overlap.useRowFamily(overlapRows);
+    overlap.addTerm(idx.eCol(first), 1); overlap.addTerm(idx.eCol(second), -1);
+    overlap.addTerm(zs, M); overlap.addTerm(zt, M);
+    overlap.addRow(-SPARSE_INF, 2 * M - bounds.processing(first, b));
+}
+
+// 有序船对形式（原始模型）：每个有序对 (s,t) 一个 y_st，每个 (s,t,b) 一组 omega/lambda/mu
+// 及约束(24)-(33)，再加两条按 lambda/mu 激活的不重叠约束（写到 overlap，可以是 m 本身，M 见 PortBounds）。
+// y 只为需要先后变量的船对创建，omega/lambda/mu 只为关系为 PairConflict 的 (s,t,b) 创建，其余为 -1；
+// 其余 (s,t,b) 按 addEliminatedPair 处理。
+static void addOrderedPairSequencing(const PortBounds& bounds, SparseModel& m, SparseModel& overlap, PortIndex& idx) {
+    const int S = idx.S, B = idx.B;
+    // y_st: 与 mu 关联，y_st = 1 且同泊位时 t 在 s 之前；omega/lambda/mu 为 [s][t][b]（s == t 为 -1）
+    idx.y.assign(static_cast<size_t>(S) * S, -1);
+    idx.omega.assign(static_cast<size_t>(S) * S * B, -1);
+    idx.lambda.assign(idx.omega.size(), -1);
+    idx.mu.assign(idx.omega.size(), -1);
+    vector<PairRelation> relation(idx.omega.size(), PairOrdered);
+    for (int s = 0; s < S; s++) {
+        for (int t = 0; t < S; t++) {
+            if (s == t) continue;
+            for (int b = 0; b < B; b++) relation[(s * S + t) * B + b] = bounds.pairRelation(min(s, t), max(s, t), b);
+            if (bounds.pairNeedsOrder(s, t)) idx.y[s * S + t] = m.addColumns(1, 0, 1, ColBinary);
+        }
+    }
+    vector<int>* families[] = {&idx.omega, &idx.lambda, &idx.mu};
+    for (int f = 0; f < 3; f++) {
+        vector<int>& cols = *families[f];
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (relation[i] == PairConflict) cols[i] = m.addColumns(1, 0, 1, ColBinary);
+        }
+    }
+
+    const int omegaRows = m.rowFamilyId("seq_omega"), orderRows = m.rowFamilyId("seq_order");
+    const int excludeRows = m.rowFamilyId("seq_exclude");
+    for (int s = 0; s < S; s++) {
+        for (int t = 0; t < S; t++) {
+            if (s == t) continue;
+            const int yst = idx.yCol(s, t);
+            for (int b = 0; b < B; b++) {
+                if (relation[(s * S + t) * B + b] != PairConflict) continue;
+                const int om = idx.omegaCol(s, t, b), la = idx.lambdaCol(s, t, b), mu = idx.muCol(s, t, b);
+                const int zs = idx.zCol(s, b), zt = idx.zCol(t, b);
+                // 约束(24): lambda + mu - omega = 0
+                m.useRowFamily(omegaRows);
+                m.addTerm(la, 1); m.addTerm(mu, 1); m.addTerm(om, -1); m.addRow(0, 0);
+                // 约束(25-26): omega <= z_sb 和 omega <= z_tb
+                m.addTerm(om, 1); m.addTerm(zs, -1); m.addRow(-SPARSE_INF, 0);
+                m.addTerm(om, 1); m.addTerm(zt, -1); m.addRow(-SPARSE_INF, 0);
+                // 约束(27): omega >= z_sb + z_tb - 1
+                m.addTerm(om, 1); m.addTerm(zs, -1); m.addTerm(zt, -1); m.addRow(-1, SPARSE_INF);
+                // 约束(28-33): mu[s][t][b] = 1 表示 s 和 t 在同一泊位 b，且 s 在 t 之后
+                m.useRowFamily(orderRows);
+                m.addTerm(mu, 1); m.addTerm(om, -1); m.addRow(-SPARSE_INF, 0);
+                m.addTerm(mu, 1); m.addTerm(yst, -1); m.addRow(-SPARSE_INF, 0);
+                m.addTerm(mu, 1); m.addTerm(om, -1); m.addTerm(yst, -1); m.addRow(-1, SPARSE_INF);
+                // lambda[s][t][b] = 1 表示 s 和 t 在同一泊位 b，且 s 在 t 之前
+                m.addTerm(la, 1); m.addTerm(om, -1); m.addRow(-SPARSE_INF, 0);
+                m.addTerm(la, 1); m.addTerm(yst, 1); m.addRow(-SPARSE_INF, 1);
+                m.addTerm(la, 1); m.addTerm(om, -1); m.addTerm(yst, 1); m.addRow(0, SPARSE_INF);
+            }
+        }
+    }
+
+    // （原约束(39)-(45) 的 zeta/eta 线性化已注释掉并不再创建，见版本历史）
+
+    // 同一泊位上的不同船舶时间不重叠（基于 lambda/mu 的前后关系）
+    // 若 lambda[s][t][b] = 1（s 在 t 之前，且两者都在泊位 b），则 e[s] + proc_s_b <= e[t]
+    // 若 mu[s][t][b] = 1（t 在 s 之前，且两者都在泊位 b），则 e[t] + proc_t_b <= e[s]
+    const int overlapRows = overlap.rowFamilyId("seq_overlap");
+    for (int s = 0; s < S; ++s) {
+        for (int t = 0; t < S; ++t) {
+            if (s == t) continue;
+            for (int b = 0; b < B; ++b) {
+                const PairRelation rel = relation[(s * S + t) * B + b];
+                if (rel != PairConflict) {
+                    // 无序对只处理一次
+                    if (s < t) addEliminatedPair(bounds, rel, s, t, b, m, overlap, excludeRows, overlapRows, idx);
+                    continue;
+                }
+                double proc_s_b = bounds.processing(s, b);
+                double proc_t_b = bounds.processing(t, b);
+                double M_st = bounds.overlapM(s, t, b), M_ts = bounds.overlapM(t, s, b);
+                overlap.useRowFamily(overlapRows);
+                // e[s] + proc_s_b <= e[t] + M_st * (1 - lambda)
+                overlap.addTerm(idx.eCol(s), 1); overlap.addTerm(idx.eCol(t), -1); overlap.addTerm(idx.lambdaCol(s, t, b), M_st);
+                overlap.addRow(-SPARSE_INF, M_st - proc_s_b);
+                // e[t] + proc_t_b <= e[s] + M_ts * (1 - mu)
+                overlap.addTerm(idx.eCol(t), 1); overlap.addTerm(idx.eCol(s), -1); overlap.addTerm(idx.muCol(s, t, b), M_ts);
+                overlap.addRow(-SPARSE_INF, M_ts - proc_t_b);
+            }
+        }
+    }
+}
+
+// 无序船对形式：每个 s < t 只有一个先后变量 o_st（1 表示同泊位时 s 在 t 之前），
+// 对每个泊位 b 两条不重叠约束，仅当 z_sb = z_tb = 1 时起作用：
+//   e_s + p_sb - e_t <= M_st * (3 - o_st - z_sb - z_tb)
+//   e_t + p_tb - e_s <= M_ts * (2 + o_st - z_sb - z_tb)
+// 与有序形式相比去掉了 y 的对称副本和 omega/lambda/mu（它们只是 z 与 y 的乘积），
+// 可行解集合在 (z, e) 上相同。不重叠约束写到 overlap（可以是 m 本身）。
+// o_st 只为需要先后变量的船对创建（其余为 -1），非 PairConflict 的 (s,t,b) 按 addEliminatedPair 处理。
+static void addUnorderedPairSequencing(const PortBounds& bounds, SparseModel& m, SparseModel& overlap, PortIndex& idx) {
+    const int S = idx.S, B = idx.B;
+    idx.order.assign(static_cast<size_t>(S) * S, -1);
+    for (int s = 0; s < S; s++) {
+        for (int t = s + 1; t < S; t++) {
+            if (bounds.pairNeedsOrder(s, t)) idx.order[s * S + t] = m.addColumns(1, 0, 1, ColBinary);
+        }
+    }
+    const int overlapRows = overlap.rowFamilyId("seq_overlap"), excludeRows = m.rowFamilyId("seq_exclude");
+    for (int s = 0; s < S; s++) {
+        for (int t = s + 1; t < S; t++) {
+            const int o = idx.orderCol(s, t);
+            for (int b = 0; b < B; b++) {
+                const PairRelation rel = bounds.pairRelation(s, t, b);
+                if (rel != PairConflict) {
+                    addEliminatedPair(bounds, rel, s, t, b, m, overlap, excludeRows, overlapRows, idx);
+                    continue;
+                }
+                const int zs = idx.zCol(s, b), zt = idx.zCol(t, b);
+                const double M_st = bounds.overlapM(s, t, b), M_ts = bounds.overlapM(t, s, b);
+                overlap.useRowFamily(overlapRows);
+                overlap.addTerm(idx.eCol(s), 1); overlap.addTerm(idx.eCol(t), -1);
+                overlap.addTerm(o, M_st); overlap.addTerm(zs, M_st); overlap.addTerm(zt, M_st);
+                overlap.addRow(-SPARSE_INF, 3 * M_st - bounds.processing(s, b));
+                overlap.addTerm(idx.eCol(t), 1); overlap.addTerm(idx.eCol(s), -1);
+                overlap.addTerm(o, -M_ts); overlap.addTerm(zs, M_ts); overlap.addTerm(zt, M_ts);
+                overlap.addRow(-SPARSE_INF, 2 * M_ts - bounds.processing(t, b));
+            }
+        }
+    }
+}
+
+// 构建模型（原 verify.cpp main 中的第 3-6 步）：列按族连续追加，约束按族追加为 CSR 行
+void buildPortIR(const ModelParams& params, const ModelOptions& opts, SparseModel& m, PortIndex& idx,
+                 const YardColumnPool* pool, PhaseProfile* profile, SparseModel* lazyRows) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const int R = params.numRows, V = params.numSlotsPerRow;
+    // 各约束族的建模耗时（profile 为空时不计时）
+    PhaseTimer timer(profile, "build.");
+    timer.begin("variables");
+    idx = PortIndex();
+    idx.opts = opts;
+    idx.S = S; idx.K = K; idx.B = B; idx.R = R; idx.V = V;
+    // 逐行 big-M、e_s / e_sk 上界与船对关系（opts.tightenBounds / pairElimination / objectiveCutoff，见 model_bounds.h）
+    const PortBounds bounds(params, opts);
+
+    // 3. 定义决策变量
+    // z_sb: 船舶s是否分配到泊位b；q_skt: 船舶s的货舱k是否先于货舱t卸货
+    addFamily(m, idx.z, static_cast<size_t>(S) * B, 0, 1, ColBinary);
+    addFamily(m, idx.q, static_cast<size_t>(S) * K * K, 0, 1, ColBinary);
+    // e_s: 船舶s的卸载开始时间 [tau_s, PortBounds::latestStart]（不超过 H）；e_sk: 货舱k的卸货开始时间 [tau_s, PortBounds::eskUb]
+    addFamily(m, idx.e, S, 0, params.planningHorizon, ColContinuous);
+    addFamily(m, idx.e_sk, static_cast<size_t>(S) * K, 0, SPARSE_INF, ColContinuous);
+    for (int s = 0; s < S; s++) {
+        m.colLb[idx.eCol(s)] = params.arrivalTime[s];
+        m.colUb[idx.eCol(s)] = bounds.latestStart(s);
+        for (int k = 0; k < K; k++) {
+            m.colLb[idx.eskCol(s, k)] = params.arrivalTime[s];
+            m.colUb[idx.eskCol(s, k)] = bounds.eskUb(s, k);
+        }
+    }
+    // 逐槽堆场（仅 YardSlots）：x_skrv 是否分配到行r的槽v，h_skrv 是否结束于槽v，f_skr 是否分配到行r
+    if (opts.yard == YardSlots) {
+        addFamily(m, idx.x, static_cast<size_t>(S) * K * R * V, 0, 1, ColBinary);
+        addFamily(m, idx.h, static_cast<size_t>(S) * K * R * V, 0, 1, ColBinary);
+        addFamily(m, idx.f, static_cast<size_t>(S) * K * R, 0, 1, ColBinary);
+    }
+
+    // 4. 目标函数：最小化 alpha * (总转运成本 + 存储成本) + beta * 靠泊时间
+    timer.begin(opts.yard == YardSlots ? "objective-yard" : "yard-blocks");
+    if (opts.yard == YardNone) {
+        // 不含堆场部分（Benders 主问题），堆场成本由调用方补充
+    } else if (opts.yard != YardSlots) {
+        // 起点形式：转运/存储成本与堆场约束一并加入（见 addBlockYard）
+        addBlockYard(params, opts, m, idx, opts.yard == YardColumns ? pool : 0);
+    } else {
+        // 总转运成本（建模方式见 TransshipmentForm）
+        if (opts.transshipment == TransProduct) {
+            for (int s = 0; s < S; s++) {
+                for (int k = 0; k < K; k++) {
+                    const double w = slotWeight(params, s, k);
+                    for (int b = 0; b < B; b++) {
+                        for (int r = 0; r < R; r++) {
+                            for (int v = 0; v < V; v++) {
+                                m.addQuadObjective(idx.xCol(s, k, r, v), idx.zCol(s, b),
+                                                   params.alpha * params.transshipmentCost(b,r,v) * w);
+                            }
+                        }
+                    }
+                }
+            }
+        } else if (opts.transshipment == TransSlot) {
+            addSlotTransshipmentCost(params, m, idx);
+        } else {
+            addBerthTransshipmentCost(params, m, idx);
+        }
+
+        // 总存储成本
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                for (int r = 0; r < R; r++) {
+                    for (int v = 0; v < V; v++) m.addObjective(idx.xCol(s, k, r, v), params.alpha * params.storageCost(s,k,r));
+                }
+            }
+        }
+    }
+
+    timer.begin("objective-berth");
+    // 靠泊时间：e_s - tau_s 加上所分配泊位的卸载时间
+    for (int s = 0; s < S; s++) {
+        m.addObjective(idx.eCol(s), params.beta);
+        m.objConstant -= params.beta * params.arrivalTime[s];
+        for (int b = 0; b < B; b++) {
+            double unload = 0.0;
+            for (int k = 0; k < K; k++) {
+                double speed = params.unloadingSpeed(s,b,k);
+                if (speed <= 0) speed = 1.0; // 防除零
+                unload += params.cargoWeight[s] / (speed * K);
+            }
+            m.addObjective(idx.zCol(s, b), params.beta * unload);
+        }
+    }
+
+    // 5. 添加约束条件
+    //约束(3.8): 每艘船分配到一个泊位
+    timer.begin("assign-3.8");
+    m.beginRowFamily("berth_assign");
+    for (int s = 0; s < S; s++) {
+        for (int b = 0; b < B; b++) m.addTerm(idx.zCol(s, b), 1);
+        m.addRow(1, 1);
+    }
+
+    // 约束(3.11)-(14) 仅用于逐槽形式；起点形式的对应约束在 addBlockYard 中
+    if (opts.yard == YardSlots) {
+        timer.begin("yard-3.11-14");
+        // 约束(3.11): 每艘船的每个舱占用足够的槽数
+        m.beginRowFamily("yard_count");
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                for (int r = 0; r < R; r++) {
+                    for (int v = 0; v < V; v++) m.addTerm(idx.xCol(s, k, r, v), 1);
+                }
+                m.addRow(params.requiredSlots[s][k], params.requiredSlots[s][k]);
+            }
+        }
+
+        // 约束(3.12): 每个槽最多放一种货物（跨船舶 s 和货舱 k，总和 <= 1）
+        m.beginRowFamily("yard_cover");
+        for (int r = 0; r < R; r++) {
+            for (int v = 0; v < V; v++) {
+                for (int s = 0; s < S; s++) {
+                    for (int k = 0; k < K; k++) m.addTerm(idx.xCol(s, k, r, v), 1);
+                }
+                m.addRow(-SPARSE_INF, 1);
+            }
+        }
+
+        // 约束(3.13): 每艘船的货物存储在同一行
+        m.beginRowFamily("yard_row");
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                for (int r = 0; r < R; r++) m.addTerm(idx.fCol(s, k, r), 1);
+                m.addRow(1, 1);
+            }
+        }
+
+        // 约束(3.14) 与连续性约束(12)-(14) 同属 yard_contig 族
+        m.beginRowFamily("yard_contig");
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                for (int r = 0; r < R; r++) {
+                    // 约束(3.14): x_srv与f_sr的关联
+                    for (int v = 0; v < V; v++) m.addTerm(idx.xCol(s, k, r, v), 1);
+                    m.addTerm(idx.fCol(s, k, r), -V);
+                    m.addRow(-SPARSE_INF, 0);
+
+                    // 约束(12)-(14): 存储槽的连续性
+                    for (int v = 0; v < V; v++) m.addTerm(idx.hCol(s, k, r, v), 1);
+                    m.addTerm(idx.fCol(s, k, r), -1);
+                    m.addRow(0, 0);
+
+                    // 约束(13): 最后一个槽的h_srv约束
+                    m.addTerm(idx.xCol(s, k, r, V - 1), 1);
+                    m.addTerm(idx.hCol(s, k, r, V - 1), -1);
+                    m.addRow(-SPARSE_INF, 0);
+
+                    // 约束(14): 中间槽的连续性约束
+                    for (int v = 0; v < V - 1; v++) {
+                        m.addTerm(idx.xCol(s, k, r, v), 1);
+                        m.addTerm(idx.xCol(s, k, r, v + 1), -1);
+                        m.addTerm(idx.hCol(s, k, r, v), -1);
+                        m.addRow(-SPARSE_INF, 0);
+                    }
+                }
+            }
+        }
+    }
+
+    //约束船舱卸货顺序
+    timer.begin("compartment-order");
+    m.beginRowFamily("hold_start");
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            m.addTerm(idx.eCol(s), 1);
+            m.addTerm(idx.eskCol(s, k), -1);
+            m.addRow(-SPARSE_INF, 0);
+        }
+    }
+
+    const int pairRows = m.rowFamilyId("hold_pair"), orderRows = m.rowFamilyId("hold_order");
+    for (int s = 0; s < S; s++) {
+        for (int k = 0; k < K; k++) {
+            for (int t = 0; t < K; t++) {
+                if (t == k) continue;
+                m.useRowFamily(pairRows);
+                m.addTerm(idx.qCol(s, k, t), 1);
+                m.addTerm(idx.qCol(s, t, k), 1);
+                m.addRow(1, 1);
+                for (int b = 0; b < B; b++) {
+                    // Big-M constraint to enforce unloading order for compartments k and t on ship s
+                    // only when ship s is assigned to berth b (activate with z[s][b]).
+                    // If q[s][k][t] == 1 AND z[s][b] == 1 then:
+                    //   e_sk[s][k] + duration_kb <= e_sk[s][t]
+                    // Linearized as:
+                    //   e_sk[s][k] - e_sk[s][t] + M * q[s][k][t] + M * z[s][b] <= 2M - duration_kb
+                    // For the chosen berth (z=1) and q=1, it is binding. Otherwise RHS is large and non-binding
+                    // (M per row, see PortBounds::holdOrderM).
+                    double duration_kb = bounds.duration(s, b, k);
+                    double Mbig = bounds.holdOrderM(s, k, b);
+                    m.useRowFamily(orderRows);
+                    m.addTerm(idx.eskCol(s, k), 1);
+                    m.addTerm(idx.eskCol(s, t), -1);
+                    m.addTerm(idx.qCol(s, k, t), Mbig);
+                    m.addTerm(idx.zCol(s, b), Mbig);
+                    m.addRow(-SPARSE_INF, 2 * Mbig - duration_kb);
+                }
+            }
+        }
+    }
+
+    // 6. 同泊位船舶的先后关系与不重叠约束（建模方式见 SequencingForm）
+    timer.begin("sequencing");
+    SparseModel& overlap = opts.lazyOverlap && lazyRows ? *lazyRows : m;
+    if (opts.sequencing == SeqFull) {
+        addOrderedPairSequencing(bounds, m, overlap, idx);
+    } else {
+        addUnorderedPairSequencing(bounds, m, overlap, idx);
+    }
+    timer.end();
+}
+
+vector<string> portColumnNames(const PortIndex& idx, int numCols, const vector<int>* shipIds) {
+    const int S = idx.S, K = idx.K, B = idx.B, R = idx.R, V = idx.V;
+    vector<string> names(numCols);
+    char buf[64];
+    auto id = [&](int s) { return shipIds ? (*shipIds)[s] : s; };
+    auto name = [&](int col, const char* fmt, int a, int b, int c, int d) {
+        if (col < 0) return;
+        snprintf(buf, sizeof(buf), fmt, a, b, c, d);
+        names[col] = buf;
+    };
+    for (int s = 0; s < S; s++) {
+        name(idx.eCol(s), "e_%d", id(s), 0, 0, 0);
+        for (int b = 0; b < B; b++) {
+            name(idx.zCol(s, b), "z_%d_%d", id(s), b, 0, 0);
+            if (!idx.transBerth.empty()) name(idx.transBerthCol(s, b), "T_%d_%d", id(s), b, 0, 0);
+        }
+        for (int k = 0; k < K; k++) {
+            name(idx.eskCol(s, k), "e_%d_%d", id(s), k, 0, 0);
+            for (int t = 0; t < K; t++) name(idx.qCol(s, k, t), "q_%d_%d_%d", id(s), k, t, 0);
+            for (int r = 0; r < R; r++) {
+                if (!idx.f.empty()) name(idx.fCol(s, k, r), "f_%d_%d_%d", id(s), r, k, 0);
+                for (int v = 0; v < V; v++) {
+                    if (!idx.x.empty()) {
+                        name(idx.xCol(s, k, r, v), "x_%d_%d_%d_%d", id(s), k, r, v);
+                        name(idx.hCol(s, k, r, v), "h_%d_%d_%d_%d", id(s), k, r, v);
+                    }
+                    if (!idx.place.empty()) name(idx.placeCol(s, k, r, v), "p_%d_%d_%d_%d", id(s), k, r, v);
+                    if (!idx.transSlot.empty()) name(idx.transSlotCol(s, k, r, v), "u_%d_%d_%d_%d", id(s), k, r, v);
+                }
+            }
+        }
+        for (int t = 0; t < S; t++) {
+            if (!idx.order.empty()) name(idx.orderCol(s, t), "o_%d_%d", id(s), id(t), 0, 0);
+            if (idx.y.empty()) continue;
+            name(idx.yCol(s, t), "y_%d_%d", id(s), id(t), 0, 0);
+            for (int b = 0; b < B; b++) {
+                name(idx.omegaCol(s, t, b), "omega_%d_%d_%d", id(s), id(t), b, 0);
+                name(idx.lambdaCol(s, t, b), "lambda_%d_%d_%d", id(s), id(t), b, 0);
+                name(idx.muCol(s, t, b), "mu_%d_%d_%d", id(s), id(t), b, 0);
+            }
+        }
+    }
+    for (int i = 0; i < numCols; i++) {
+        if (names[i].empty()) names[i] = "C" + to_string(i);
+    }
+    return names;
+}
+
+void extractPortSolution(const ModelParams& params, const PortIndex& idx,
+                         const function<double(int)>& value, PortSolution& sol) {
+    initSolution(sol, params);
+    for (int s = 0; s < params.numShips; s++) {
+        for (int b = 0; b < params.numBerths; b++) {
+            if (value(idx.zCol(s, b)) > 0.5) { sol.berth[s] = b; break; }
+        }
+        sol.e[s] = value(idx.eCol(s));
+        for (int k = 0; k < params.numShipK; k++) {
+            sol.e_sk[s][k] = value(idx.eskCol(s, k));
+            if (idx.opts.yard == YardNone) {
+                continue;
+            } else if (idx.opts.yard != YardSlots) {
+                for (int r = 0; r < params.numRows && sol.row[s][k] < 0; r++) {
+                    for (int j = 0; j < idx.placeStarts(params, s, k); j++) {
+                        const int p = idx.placeCol(s, k, r, j);
+                        if (p < 0) continue;   // 不在列池中
+                        if (value(p) > 0.5) {
+                            placeBlock(sol, s, k, r, j, params.requiredSlots[s][k]);
+                            break;
+                        }
+                    }
+                }
+            } else {
+                // 逐槽形式：f 指定的行中 x = 1 的槽
+                for (int r = 0; r < params.numRows; r++) {
+                    if (value(idx.fCol(s, k, r)) > 0.5) { sol.row[s][k] = r; break; }
+                }
+                if (sol.row[s][k] < 0) continue;
+                for (int v = 0; v < params.numSlotsPerRow; v++) {
+                    if (value(idx.xCol(s, k, sol.row[s][k], v)) > 0.5) sol.slots[s][k].push_back(v);
+                }
+            }
+        }
+    }
+}
+
+// 同泊位时 s 是否先于 t：按卸载开始时间，相同时按编号
+static bool startsBefore(const PortSolution& sol, int s, int t) {
+    return sol.e[s] < sol.e[t] || (sol.e[s] == sol.e[t] && s < t);
+}
+
+void portMIPStart(const ModelParams& params, const PortIndex& idx, const PortSolution& sol,
+                  vector<pair<int,double>>& start) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const int R = params.numRows, V = params.numSlotsPerRow;
+    start.clear();
+    // 未创建的列（-1：列池外的放置、已消去的先后变量）跳过
+    auto set = [&](int col, double val) {
+        if (col >= 0) start.push_back(make_pair(col, val));
+    };
+
+    for (int s = 0; s < S; s++) {
+        const int bs = sol.berth[s];
+        for (int b = 0; b < B; b++) set(idx.zCol(s, b), b == bs ? 1.0 : 0.0);
+        set(idx.eCol(s), sol.e[s]);
+        for (int k = 0; k < K; k++) {
+            set(idx.eskCol(s, k), sol.e_sk[s][k]);
+            // q_skk 不出现在任何行和目标中，不给初始值
+            for (int t = 0; t < K; t++) {
+                if (t == k) continue;
+                bool first = sol.e_sk[s][k] < sol.e_sk[s][t] || (sol.e_sk[s][k] == sol.e_sk[s][t] && k < t);
+                set(idx.qCol(s, k, t), first ? 1.0 : 0.0);
+            }
+        }
+    }
+
+    // 堆场与转运成本辅助变量：取解中放置的位置在所选泊位下的成本，其余为 0
+    if (idx.opts.yard == YardSlots) {
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                const int row = sol.row[s][k];
+                const vector<int>& slots = sol.slots[s][k];
+                const int last = slots.empty() ? -1 : slots.back();
+                for (int r = 0; r < R; r++) {
+                    set(idx.fCol(s, k, r), r == row ? 1.0 : 0.0);
+                    for (int v = 0; v < V; v++) {
+                        bool used = r == row && find(slots.begin(), slots.end(), v) != slots.end();
+                        set(idx.xCol(s, k, r, v), used ? 1.0 : 0.0);
+                        set(idx.hCol(s, k, r, v), r == row && v == last ? 1.0 : 0.0);
+                        if (idx.opts.transshipment == TransSlot) {
+                            double u = used && sol.berth[s] >= 0
+                                ? slotWeight(params, s, k) * params.transshipmentCost(sol.berth[s], r, v) : 0.0;
+                            set(idx.transSlotCol(s, k, r, v), u);
+                        }
+                    }
+                }
+            }
+        }
+    } else if (idx.opts.yard != YardNone) {
+        for (int s = 0; s < S; s++) {
+            for (int k = 0; k < K; k++) {
+                const int row = sol.row[s][k];
+                const int first = sol.slots[s][k].empty() ? -1 : sol.slots[s][k].front();
+                const int n = params.requiredSlots[s][k];
+                for (int r = 0; r < R; r++) {
+                    for (int j = 0; j < idx.placeStarts(params, s, k); j++) {
+                        const int p = idx.placeCol(s, k, r, j);
+                        if (p < 0) continue;   // 不在列池中
+                        bool used = r == row && j == first;
+                        set(p, used ? 1.0 : 0.0);
+                        if (idx.opts.transshipment == TransSlot) {
+                            double u = 0.0;
+                            if (used && sol.berth[s] >= 0) {
+                                const param_t* d = params.transshipmentCost.row(sol.berth[s], r);
+                                for (int v = j; v < j + n; v++) u += d[v];
+                                u *= slotWeight(params, s, k);
+                            }
+                            set(idx.transSlotCol(s, k, r, j), u);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (idx.opts.transshipment == TransBerth && idx.opts.yard != YardNone) {
+        vector<ShipCost> costs = evaluateShipCosts(params, sol);
+        for (int s = 0; s < S; s++) {
+            for (int b = 0; b < B; b++) set(idx.transBerthCol(s, b), b == sol.berth[s] ? costs[s].transshipment : 0.0);
+        }
+    }
+
+    // 先后关系
+    if (idx.opts.sequencing == SeqFull) {
+        for (int s = 0; s < S; s++) {
+            for (int t = 0; t < S; t++) {
+                bool yst = s != t && startsBefore(sol, t, s);   // y_st = 1：t 在 s 之前
+                set(idx.yCol(s, t), yst ? 1.0 : 0.0);
+                for (int b = 0; b < B; b++) {
+                    bool same = s != t && sol.berth[s] == b && sol.berth[t] == b;
+                    set(idx.omegaCol(s, t, b), same ? 1.0 : 0.0);
+                    set(idx.muCol(s, t, b), same && yst ? 1.0 : 0.0);
+                    set(idx.lambdaCol(s, t, b), same && !yst ? 1.0 : 0.0);
+                }
+            }
+        }
+    } else {
+        for (int s = 0; s < S; s++) {
+            for (int t = s + 1; t < S; t++) set(idx.orderCol(s, t), startsBefore(sol, s, t) ? 1.0 : 0.0);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef PORT_IR_H
+#define PORT_IR_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "modelParam.h"
+#include "model_options.h"
+#include "port_solution.h"
+#include "sparse_model.h"
+
+struct YardColumnPool;
+class PhaseProfile;
+
+// 泊位-堆场联合模型的稀疏形式（不依赖 CPLEX）：buildPortIR 按 ModelOptions 把模型追加到
+// SparseModel，PortIndex 记录每个决策变量对应的列下标（不存在的变量为 -1）。
+// 各变量族的含义与 PortModel（port_model.h）相同，Concert 模型由它加载而来。
+struct PortIndex {
+    ModelOptions opts;
+    int S = 0, K = 0, B = 0, R = 0, V = 0;
+    std::vector<int> z;            // [s*B + b]
+    std::vector<int> q;            // [(s*K + k)*K + t]
+    std::vector<int> e;            // [s]
+    std::vector<int> e_sk;         // [s*K + k]
+    std::vector<int> x, h;         // YardSlots：[((s*K + k)*R + r)*V + v]
+    std::vector<int> f;            // YardSlots：[(s*K + k)*R + r]
+    std::vector<int> place;        // YardBlocks / YardColumns：[((s*K + k)*R + r)*V + j]，不可行或不在列池中为 -1
+    std::vector<int> transSlot;    // TransSlot：下标同 x（YardSlots）或 place
+    std::vector<int> transBerth;   // TransBerth：[s*B + b]
+    std::vector<int> y;            // SeqFull：[s*S + t]
+    std::vector<int> omega, lambda, mu;   // SeqFull：[(s*S + t)*B + b]
+    std::vector<int> order;        // SeqPairs：[s*S + t]（t > s）
+
+    int zCol(int s, int b) const { return z[s * B + b]; }
+    int qCol(int s, int k, int t) const { return q[(s * K + k) * K + t]; }
+    int eCol(int s) const { return e[s]; }
+    int eskCol(int s, int k) const { return e_sk[s * K + k]; }
+    long slotIndex(int s, int k, int r, int v) const { return ((static_cast<long>(s) * K + k) * R + r) * V + v; }
+    int xCol(int s, int k, int r, int v) const { return x[slotIndex(s, k, r, v)]; }
+    int hCol(int s, int k, int r, int v) const { return h[slotIndex(s, k, r, v)]; }
+    int fCol(int s, int k, int r) const { return f[(s * K + k) * R + r]; }
+    int placeCol(int s, int k, int r, int j) const { return place[slotIndex(s, k, r, j)]; }
+    int transSlotCol(int s, int k, int r, int v) const { return transSlot[slotIndex(s, k, r, v)]; }
+    int transBerthCol(int s, int b) const { return transBerth[s * B + b]; }
+    int yCol(int s, int t) const { return y[s * S + t]; }
+    int omegaCol(int s, int t, int b) const { return omega[(s * S + t) * B + b]; }
+    int lambdaCol(int s, int t, int b) const { return lambda[(s * S + t) * B + b]; }
+    int muCol(int s, int t, int b) const { return mu[(s * S + t) * B + b]; }
+    int orderCol(int s, int t) const { return order[s * S + t]; }
+    // 货舱 (s,k) 在每行的可行起点数 V - n_sk + 1（n_sk <= 0 时为 0）
+    int placeStarts(const ModelParams& params, int s, int k) const;
+};
+
+// 按 opts 把完整模型追加到 model（model 应为空）。YardColumns 下只包含 pool 中的放置
+// （pool 为空指针时与 YardBlocks 相同，列生成需 CPLEX，见 buildPortModel）。
+// profile 非空时按约束族记录耗时（阶段名 build.variables / build.sequencing 等，见 phase_timer.h）。
+// opts.lazyOverlap 且 lazyRows 非空时，同泊位不重叠约束（seq_overlap）不加入 model 而追加到 lazyRows
+// （只有行，列下标指向 model 的列），由求解器在整数候选解上按需加入（CPLEX 见 lazy_rows.h）
+void buildPortIR(const ModelParams& params, const ModelOptions& opts, SparseModel& model, PortIndex& index,
+                 const YardColumnPool* pool = 0, PhaseProfile* profile = 0, SparseModel* lazyRows = 0);
+
+// 前 numCols 列的名称（x_s_k_r_v、z_s_b、q_s_k_t 等），不属于任何变量族的列为 C<下标>。
+// shipIds 非空时名称中的船舶编号为 (*shipIds)[s]（增量重排中船舶增删后保持不变的编号，见 reschedule.h）
+std::vector<std::string> portColumnNames(const PortIndex& index, int numCols, const std::vector<int>* shipIds = 0);
+
+// 从列值读出解（value(col) 返回列 col 的值，只对解需要的列调用）
+void extractPortSolution(const ModelParams& params, const PortIndex& index,
+                         const std::function<double(int)>& value, PortSolution& sol);
+
+// 由 sol 推出完整的 MIP 初始解：(列, 值)。除 z/e/e_sk/堆场变量外，q、先后关系变量（按 e 的先后）
+// 和转运成本辅助变量也按 sol 推出；YardColumns 下不在列池中的放置无法表示
+void portMIPStart(const ModelParams& params, const PortIndex& index, const PortSolution& sol,
+                  std::vector<std::pair<int,double>>& start);
+
+#endif // PORT_IR_H
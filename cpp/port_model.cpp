@@ -0,0 +1,238 @@
+#include "port_model.h"
+#include "yard_colgen.h"
+#include "phase_timer.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <functional>
+
+using namespace std;
+
+// 约束行的批量构建：逐行登记 (变量, 系数)，每行直接生成 IloRange 并设置系数数组，
+// 不经过 IloExpr 运算符产生的临时表达式；flush 时整批加入模型（一次 model.add），调用方负责在用完前 flush。
+// 同一行内的变量不能重复（setLinearCoefs 是赋值而不是累加），系数为 0 的项不登记。
+class RowBatch {
+public:
+    static const IloInt FLUSH_ROWS = 1 << 16;   // 积累到这么多行时自动加入模型，限制句柄数组的大小
+
+    RowBatch(IloEnv env, IloModel model) : env_(env), model_(model), rows_(env), vars_(env), coefs_(env) {}
+    ~RowBatch() {
+        rows_.end();
+        vars_.end();
+        coefs_.end();
+    }
+    void term(const IloNumVar& v, IloNum c) {
+        if (c == 0) return;
+        vars_.add(v);
+        coefs_.add(c);
+    }
+    // 以已登记的项生成一行 lb <= sum <= ub
+    void row(IloNum lb, IloNum ub) {
+        IloRange r(env_, lb, ub);
+        r.setLinearCoefs(vars_, coefs_);
+        rows_.add(r);
+        vars_.clear();
+        coefs_.clear();
+        if (rows_.getSize() >= FLUSH_ROWS) flush();
+    }
+    void flush() {
+        if (rows_.getSize() == 0) return;
+        model_.add(rows_);
+        rows_.clear();
+    }
+
+private:
+    IloEnv env_;
+    IloModel model_;
+    IloRangeArray rows_;
+    IloNumVarArray vars_;
+    IloNumArray coefs_;
+};
+
+void loadSparseModel(IloEnv env, const SparseModel& sm, IloModel model, IloNumVarArray& cols, IloObjective& objective) {
+    // 列：相同类型的连续一段一次创建
+    cols = IloNumVarArray(env);
+    const int n = sm.numCols();
+    for (int c0 = 0; c0 < n;) {
+        int c1 = c0;
+        while (c1 < n && sm.colType[c1] == sm.colType[c0]) c1++;
+        IloNumArray lb(env, c1 - c0), ub(env, c1 - c0);
+        for (int c = c0; c < c1; c++) {
+            lb[c - c0] = sm.colLb[c];
+            ub[c - c0] = sm.colUb[c] >= SPARSE_INF ? IloInfinity : sm.colUb[c];
+        }
+        IloNumVarArray run(env, lb, ub, sm.colType[c0] == ColBinary ? IloNumVar::Bool : IloNumVar::Float);
+        cols.add(run);
+        run.end();
+        lb.end();
+        ub.end();
+        c0 = c1;
+    }
+    // 全部列都加入模型：只出现在延迟约束中的列（--lazy-overlap 下 pairs 的 o_st）与不出现在任何行中的列（q_skk）
+    // 也要被抽取，回调读取候选解 / incumbent 与 MIP 初始解才能引用它们
+    model.add(cols);
+
+    // 目标：线性项、二次项与常数项
+    IloExpr expr(env, sm.objConstant);
+    for (int c = 0; c < n; c++) {
+        if (sm.obj[c] != 0) expr += sm.obj[c] * cols[c];
+    }
+    for (size_t i = 0; i < sm.quad.size(); i++) expr += sm.quad[i].coef * cols[sm.quad[i].i] * cols[sm.quad[i].j];
+    objective = IloMinimize(env, expr);
+    model.add(objective);
+    expr.end();
+
+    // 约束行
+    RowBatch rows(env, model);
+    for (long i = 0; i < sm.numRows(); i++) {
+        for (long p = sm.rowStart[i]; p < sm.rowStart[i + 1]; p++) rows.term(cols[sm.rowIndex[p]], sm.rowValue[p]);
+        rows.row(sm.rowLb[i] <= -SPARSE_INF ? -IloInfinity : sm.rowLb[i], sm.rowUb[i] >= SPARSE_INF ? IloInfinity : sm.rowUb[i]);
+    }
+    rows.flush();
+}
+
+// 列 c 的句柄（c < 0 时为空句柄），Var 为 IloNumVar 或 IloBoolVar
+template <class Var>
+static Var column(const IloNumVarArray& cols, int c) {
+    return c >= 0 ? Var(cols[c].getImpl()) : Var();
+}
+
+// 把 PortIndex 中按行优先下标排列的列号组织成 PortModel 中的嵌套句柄数组
+template <class Var>
+static IloArray<Var> nest1(IloEnv env, const IloNumVarArray& cols, const vector<int>& idx, long offset, int n) {
+    IloArray<Var> a(env, n);
+    for (int i = 0; i < n; i++) a[i] = column<Var>(cols, idx[offset + i]);
+    return a;
+}
+
+template <class Var>
+static IloArray<IloArray<Var>> nest2(IloEnv env, const IloNumVarArray& cols, const vector<int>& idx, long offset, int n1, int n2) {
+    IloArray<IloArray<Var>> a(env, n1);
+    for (int i = 0; i < n1; i++) a[i] = nest1<Var>(env, cols, idx, offset + static_cast<long>(i) * n2, n2);
+    return a;
+}
+
+template <class Var>
+static IloArray<IloArray<IloArray<Var>>> nest3(IloEnv env, const IloNumVarArray& cols, const vector<int>& idx, long offset,
+                                               int n1, int n2, int n3) {
+    IloArray<IloArray<IloArray<Var>>> a(env, n1);
+    for (int i = 0; i < n1; i++) a[i] = nest2<Var>(env, cols, idx, offset + static_cast<long>(i) * n2 * n3, n2, n3);
+    return a;
+}
+
+template <class Var>
+static IloArray<IloArray<IloArray<IloArray<Var>>>> nest4(IloEnv env, const IloNumVarArray& cols, const vector<int>& idx,
+                                                         int n1, int n2, int n3, int n4) {
+    IloArray<IloArray<IloArray<IloArray<Var>>>> a(env, n1);
+    for (int i = 0; i < n1; i++) a[i] = nest3<Var>(env, cols, idx, static_cast<long>(i) * n2 * n3 * n4, n2, n3, n4);
+    return a;
+}
+
+// 起点形式的 [s][k][r][j]：每行只有 placeStarts 个起点
+template <class Var>
+static IloArray<IloArray<IloArray<IloArray<Var>>>> nestPlaces(IloEnv env, const ModelParams& params, const PortIndex& index,
+                                                              const IloNumVarArray& cols, const vector<int>& idx) {
+    IloArray<IloArray<IloArray<IloArray<Var>>>> a(env, index.S);
+    for (int s = 0; s < index.S; s++) {
+        a[s] = IloArray<IloArray<IloArray<Var>>>(env, index.K);
+        for (int k = 0; k < index.K; k++) {
+            a[s][k] = IloArray<IloArray<Var>>(env, index.R);
+            for (int r = 0; r < index.R; r++) {
+                a[s][k][r] = nest1<Var>(env, cols, idx, index.slotIndex(s, k, r, 0), index.placeStarts(params, s, k));
+            }
+        }
+    }
+    return a;
+}
+
+// 构建模型（原 verify.cpp main 中的第 3-6 步）：先由 buildPortIR 生成稀疏模型，再整体加载为 Concert 模型，
+// 最后按 PortIndex 把列组织成 PortModel 中的嵌套句柄数组。名称只在需要时添加（opts.names 或 nameModelVariables）。
+void buildPortModel(IloEnv env, const ModelParams& params, const ModelOptions& opts, PortModel& pm,
+                    const YardColumnPool* pool, PhaseProfile* profile) {
+    // 列生成需要 CPLEX，在建模之前完成
+    YardColumnPool generated;
+    if (opts.yard == YardColumns && !pool) {
+        PhaseTimer timer(profile, "build.");
+        timer.begin("colgen");
+        YardColGenOptions cg;
+        cg.threads = opts.threads;
+        generateYardColumns(env, params, defaultBerthScenarios(params), cg, generated);
+        pool = &generated;
+    }
+
+    SparseModel sm;
+    pm.lazyRows = SparseModel();
+    buildPortIR(params, opts, sm, pm.index, pool, profile, &pm.lazyRows);
+    // 各约束族的建模耗时已由 buildPortIR 记录，loadPortModel 只记录加载与命名
+    loadPortModel(env, params, opts, sm, pm, profile);
+}
+
+void loadPortModel(IloEnv env, const ModelParams& params, const ModelOptions& opts, const SparseModel& sm, PortModel& pm,
+                   PhaseProfile* profile) {
+    const int S = params.numShips, K = params.numShipK, B = params.numBerths;
+    const int R = params.numRows, V = params.numSlotsPerRow;
+    PhaseTimer timer(profile, "build.");
+    timer.begin("load");
+    pm.model = IloModel(env);
+    pm.opts = opts;
+    loadSparseModel(env, sm, pm.model, pm.columns, pm.objective);
+
+    const PortIndex& index = pm.index;
+    const IloNumVarArray& cols = pm.columns;
+    pm.z = nest2<IloBoolVar>(env, cols, index.z, 0, S, B);
+    pm.q = nest3<IloBoolVar>(env, cols, index.q, 0, S, K, K);
+    pm.e = nest1<IloNumVar>(env, cols, index.e, 0, S);
+    pm.e_sk = nest2<IloNumVar>(env, cols, index.e_sk, 0, S, K);
+    pm.x = IloArray<IloArray<IloArray<IloArray<IloBoolVar>>>>(env);
+    pm.h = IloArray<IloArray<IloArray<IloArray<IloBoolVar>>>>(env);
+    pm.f = IloArray<IloArray<IloArray<IloBoolVar>>>(env);
+    if (opts.yard == YardSlots) {
+        pm.x = nest4<IloBoolVar>(env, cols, index.x, S, K, R, V);
+        pm.h = nest4<IloBoolVar>(env, cols, index.h, S, K, R, V);
+        pm.f = nest3<IloBoolVar>(env, cols, index.f, 0, S, K, R);
+        if (!index.transSlot.empty()) pm.transSlot = nest4<IloNumVar>(env, cols, index.transSlot, S, K, R, V);
+    } else if (opts.yard != YardNone) {
+        pm.place = nestPlaces<IloBoolVar>(env, params, index, cols, index.place);
+        if (!index.transSlot.empty()) pm.transSlot = nestPlaces<IloNumVar>(env, params, index, cols, index.transSlot);
+    }
+    if (!index.transBerth.empty()) pm.transBerth = nest2<IloNumVar>(env, cols, index.transBerth, 0, S, B);
+    if (opts.sequencing == SeqFull) {
+        pm.y = nest2<IloBoolVar>(env, cols, index.y, 0, S, S);
+        pm.omega = nest3<IloBoolVar>(env, cols, index.omega, 0, S, S, B);
+        pm.lambda = nest3<IloBoolVar>(env, cols, index.lambda, 0, S, S, B);
+        pm.mu = nest3<IloBoolVar>(env, cols, index.mu, 0, S, S, B);
+    } else {
+        pm.order = nest2<IloBoolVar>(env, cols, index.order, 0, S, S);
+    }
+
+    if (opts.names) {
+        timer.begin("names");
+        nameModelVariables(params, pm);
+    }
+    timer.end();
+}
+
+void nameModelVariables(const ModelParams&, PortModel& pm) {
+    const vector<string> names = portColumnNames(pm.index, static_cast<int>(pm.columns.getSize()));
+    for (size_t c = 0; c < names.size(); c++) pm.columns[c].setName(names[c].c_str());
+}
+
+void extractSolution(const IloCplex& cplex, const ModelParams& params, const PortModel& pm, PortSolution& sol) {
+    extractPortSolution(params, pm.index, [&](int c) { return cplex.getValue(pm.columns[c]); }, sol);
+}
+
+void addMIPStartFromSolution(IloCplex& cplex, const ModelParams& params, const PortModel& pm,
+                             const PortSolution& sol, const char* name, IloCplex::MIPStartEffort effort) {
+    vector<pair<int,double>> start;
+    portMIPStart(params, pm.index, sol, start);
+    IloEnv env = cplex.getEnv();
+    IloNumVarArray vars(env);
+    IloNumArray vals(env);
+    for (size_t i = 0; i < start.size(); i++) {
+        vars.add(pm.columns[start[i].first]);
+        vals.add(start[i].second);
+    }
+    cplex.addMIPStart(vars, vals, effort, name);
+    vars.end();
+    vals.end();
+}
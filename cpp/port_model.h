@@ -0,0 +1,76 @@
+#ifndef PORT_MODEL_H
+#define PORT_MODEL_H
+
+#include <ilcplex/ilocplex.h>
+#include <string>
+#include <ostream>
+#include "modelParam.h"
+#include "port_solution.h"
+#include "model_options.h"
+#include "port_ir.h"
+
+// 完整的泊位-堆场联合模型：IloModel 及各决策变量句柄
+// 模型由 port_ir.h 的稀疏形式加载而来：columns 为全部列（下标同 SparseModel），
+// 下面的嵌套句柄与 columns 中的元素共享同一变量
+struct PortModel {
+    IloModel model;
+    IloObjective objective;
+    ModelOptions opts;   // 构建时使用的选项（决定下面哪些变量存在）
+    PortIndex index;     // 各变量族的列下标
+    IloNumVarArray columns;
+    SparseModel lazyRows;   // opts.lazyOverlap 时不在 model 中的不重叠约束，求解时须用 LazyRowCallback（lazy_rows.h）加入
+    // 以下 x/h/f 仅在 YardSlots 下创建
+    // x_skrv: 船舶s货舱k的货物是否分配到行r的槽v；h_skrv: 是否结束于行r的槽v
+    IloArray<IloArray<IloArray<IloArray<IloBoolVar>>>> x, h;
+    // f_skr: 船舶s货舱k的货物是否分配到行r
+    IloArray<IloArray<IloArray<IloBoolVar>>> f;
+    // place_skrj: 船舶s货舱k是否放在行r、起点为槽j（YardBlocks / YardColumns；j = 0..V-n_sk）
+    // YardColumns 下不在列池中的位置为空句柄（getImpl() == 0）
+    IloArray<IloArray<IloArray<IloArray<IloBoolVar>>>> place;
+    // z_sb: 船舶s是否分配到泊位b
+    IloArray<IloArray<IloBoolVar>> z;
+    // q_skt: 船舶s的货舱k是否先于货舱t卸货
+    IloArray<IloArray<IloArray<IloBoolVar>>> q;
+    // e_s: 船舶s的卸载开始时间；e_sk: 船舶s货舱k的卸货开始时间
+    IloArray<IloNumVar> e;
+    IloArray<IloArray<IloNumVar>> e_sk;
+    // 同泊位先后关系（仅 SeqFull 创建）：y_st 及线性化变量 omega/lambda/mu [s][t][b]
+    IloArray<IloArray<IloBoolVar>> y;
+    IloArray<IloArray<IloArray<IloBoolVar>>> omega, lambda, mu;
+    // 同泊位先后关系（仅 SeqPairs 创建）：order[s][t]（t > s）为 1 表示 s 在 t 之前
+    IloArray<IloArray<IloBoolVar>> order;
+    // 线性化转运成本的辅助变量（仅在对应 TransshipmentForm 下创建）
+    IloArray<IloArray<IloArray<IloArray<IloNumVar>>>> transSlot;  // [s][k][r][v]（YardBlocks 下为 [s][k][r][j]）
+    IloArray<IloArray<IloNumVar>> transBerth;                     // [s][b]
+};
+
+// 把稀疏模型加载到 model：按列创建变量并全部加入模型（cols 与 sm 的列一一对应），加入最小化目标 objective 和全部约束行
+void loadSparseModel(IloEnv env, const SparseModel& sm, IloModel model, IloNumVarArray& cols, IloObjective& objective);
+
+// 按 opts 在 env 中构建完整模型
+// YardColumns 下使用 pool 中的放置；pool 为空指针时先按默认泊位情景做列生成
+// profile 非空时按约束族记录建模耗时（阶段名 build.variables / build.sequencing 等，见 phase_timer.h），
+// 另有 build.colgen（需要列生成时）与 build.load（加载为 Concert 模型）
+// opts.lazyOverlap 时同泊位不重叠约束放在 pm.lazyRows 而不加入 pm.model
+void buildPortModel(IloEnv env, const ModelParams& params, const ModelOptions& opts, PortModel& pm,
+                    const YardColumnPool* pool = 0, PhaseProfile* profile = 0);
+// buildPortModel 的后半部分：把已生成的稀疏模型 sm 加载到 pm（调用前需设置与 sm 对应的 pm.index 与 pm.lazyRows，
+// 如从 instance_cache.h 的缓存读入），profile 记录 build.load
+void loadPortModel(IloEnv env, const ModelParams& params, const ModelOptions& opts, const SparseModel& sm, PortModel& pm,
+                   PhaseProfile* profile = 0);
+
+// 给 pm 中的变量按 x_s_k_r_v、z_s_b、q_s_k_t 等格式命名（导出 LP/MPS 文件或调试时使用）
+void nameModelVariables(const ModelParams& params, PortModel& pm);
+
+// 从求解后的 cplex 读出当前解（按 pm.opts 的堆场形式还原每个货舱的行与槽）
+void extractSolution(const IloCplex& cplex, const ModelParams& params, const PortModel& pm, PortSolution& sol);
+
+// 把 sol 作为完整的 MIP 初始解加入 cplex：除 z/e/e_sk/堆场变量外，
+// q、先后关系变量（按 e 的先后）和转运成本辅助变量也按 sol 推出，可行时 CPLEX 只需检查可行性。
+// sol 不可行（如开始时间超过规划期，见 greedySolution）时用 MIPStartRepair 让 CPLEX 尝试修复
+// YardColumns 下不在列池中的放置无法表示，调用方应先把 sol 的放置加入列池
+void addMIPStartFromSolution(IloCplex& cplex, const ModelParams& params, const PortModel& pm,
+                             const PortSolution& sol, const char* name = "greedy",
+                             IloCplex::MIPStartEffort effort = IloCplex::MIPStartAuto);
+
+#endif // PORT_MODEL_H
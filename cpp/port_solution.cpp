@@ -0,0 +1,306 @@
+#include "port_solution.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <utility>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+void initSolution(PortSolution& sol, const ModelParams& params) {
+    const int S = params.numShips, K = params.numShipK;
+    sol.berth.assign(S, -1);
+    sol.row.assign(S, vector<int>(K, -1));
+    sol.slots.assign(S, vector<vector<int>>(K));
+    sol.e.assign(params.arrivalTime.begin(), params.arrivalTime.end());
+    sol.e_sk.resize(S);
+    for (int s = 0; s < S; ++s) sol.e_sk[s].assign(K, params.arrivalTime[s]);
+}
+
+void placeBlock(PortSolution& sol, int s, int k, int r, int start, int len) {
+    sol.row[s][k] = r;
+    vector<int>& occ = sol.slots[s][k];
+    occ.resize(len > 0 ? len : 0);
+    for (int i = 0; i < len; ++i) occ[i] = start + i;
+}
+
+double compartmentDuration(const ModelParams& params, int s, int b, int k) {
+    double p = params.unloadingSpeed(s,b,k);
+    if (p <= 0) p = 1.0; // 防止除零
+    return params.cargoWeight[s] / (params.numShipK * p);
+}
+
+double berthProcessingTime(const ModelParams& params, int s, int b) {
+    double proc = 0.0;
+    for (int k = 0; k < params.numShipK; ++k) proc += compartmentDuration(params, s, b, k);
+    return proc;
+}
+
+vector<ShipCost> evaluateShipCosts(const ModelParams& params, const PortSolution& sol) {
+    vector<ShipCost> costs(params.numShips);
+    for (int s = 0; s < params.numShips; ++s) {
+        ShipCost& c = costs[s];
+        int b = sol.berth[s];
+        for (int k = 0; k < params.numShipK; ++k) {
+            int r = sol.row[s][k];
+            if (r < 0) continue;
+            const vector<int>& occ = sol.slots[s][k];
+            // 1) 转运成本：所选泊位到各占用槽的距离 × 每槽货物重量
+            int req = params.requiredSlots[s][k];
+            if (b >= 0 && req > 0) {
+                double perSlotWeight = params.cargoWeight[s] / (static_cast<double>(req) * params.numShipK);
+                for (size_t i = 0; i < occ.size(); ++i) {
+                    c.transshipment += params.transshipmentCost(b,r,occ[i]) * perSlotWeight;
+                }
+            }
+            // 2) 存储成本：按行计价，每个槽一份
+            c.storage += params.storageCost(s,k,r) * occ.size();
+        }
+        // 3) 靠泊时间：等待 + 按所选泊位速度的卸货时长
+        c.berthTime = sol.e[s] - params.arrivalTime[s];
+        if (b >= 0) c.berthTime += berthProcessingTime(params, s, b);
+    }
+    return costs;
+}
+
+double weightedObjective(const ModelParams& params, const vector<ShipCost>& costs) {
+    double total = 0.0;
+    for (size_t s = 0; s < costs.size(); ++s) {
+        total += params.alpha * (costs[s].transshipment + costs[s].storage) + params.beta * costs[s].berthTime;
+    }
+    return total;
+}
+
+bool mkdir_p(const string& dirPath) {
+    if (dirPath.empty()) return true;
+    string path;
+    for (size_t i = 0; i < dirPath.size(); ++i) {
+        char c = dirPath[i];
+        path.push_back(c);
+        if (c == '/' || i == dirPath.size() - 1) {
+            if (!path.empty() && path != "/" && path != "./") {
+                struct stat st;
+                if (stat(path.c_str(), &st) != 0) {
+                    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+                        cerr << "创建目录失败: " << path << ", 错误: " << strerror(errno) << endl;
+                        return false;
+                    }
+                } else if (!S_ISDIR(st.st_mode)) {
+                    cerr << "路径存在但不是目录: " << path << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 将升序槽号合并为连续区间 [first, second]
+static vector<pair<int,int>> mergeIntervals(const vector<int>& occ) {
+    vector<pair<int,int>> intervals;
+    if (occ.empty()) return intervals;
+    int start = occ[0], prev = occ[0];
+    for (size_t idx = 1; idx < occ.size(); ++idx) {
+        int cur = occ[idx];
+        if (cur == prev + 1) {
+            prev = cur;
+        } else {
+            intervals.emplace_back(start, prev);
+            start = cur; prev = cur;
+        }
+    }
+    intervals.emplace_back(start, prev);
+    return intervals;
+}
+
+void printSolution(ostream& os, const ModelParams& params, const PortSolution& sol) {
+    os << "\n泊位分配结果(z_sb):" << endl;
+    for (int s = 0; s < params.numShips; s++) {
+        if (sol.berth[s] >= 0) os << "船舶 " << s << " 分配到泊位 " << sol.berth[s] << endl;
+    }
+
+    os << "\n每个货舱占用槽位区间:" << endl;
+    for (int s = 0; s < params.numShips; ++s) {
+        for (int k = 0; k < params.numShipK; ++k) {
+            if (sol.row[s][k] < 0 || sol.slots[s][k].empty()) continue;
+            vector<pair<int,int>> intervals = mergeIntervals(sol.slots[s][k]);
+            os << "船舶 " << s << " 货舱 " << k << " 行 " << sol.row[s][k] << ": ";
+            for (size_t ii = 0; ii < intervals.size(); ++ii) {
+                const pair<int,int>& pr = intervals[ii];
+                if (pr.first == pr.second) os << "[" << pr.first << "]";
+                else os << "[" << pr.first << "-" << pr.second << "]";
+                if (ii + 1 < intervals.size()) os << ", ";
+            }
+            os << endl;
+        }
+    }
+
+    os << "\n卸载开始时间(e_s):" << endl;
+    for (int s = 0; s < params.numShips; s++) {
+        os << "船舶 " << s << ": " << sol.e[s] << " 小时" << endl;
+    }
+    os << "\n卸载开始时间(e_sk):" << endl;
+    for (int s = 0; s < params.numShips; s++) {
+        for (int k = 0; k < params.numShipK; k++) {
+            os << "船舶 " << s << " 货舱 " << k << ": " << sol.e_sk[s][k] << " 小时" << endl;
+        }
+    }
+
+    os << "\n每艘船的成本与时间分解:" << endl;
+    vector<ShipCost> costs = evaluateShipCosts(params, sol);
+    double totalTrans = 0.0, totalStore = 0.0, totalBerthTime = 0.0;
+    for (int s = 0; s < params.numShips; ++s) {
+        totalTrans += costs[s].transshipment;
+        totalStore += costs[s].storage;
+        totalBerthTime += costs[s].berthTime;
+        os << "船舶 " << s
+           << " | 转运成本: " << costs[s].transshipment
+           << " | 存储成本: " << costs[s].storage
+           << " | 靠泊时间: " << costs[s].berthTime << " 小时" << endl;
+    }
+    os << "\n合计 | 转运成本: " << totalTrans
+       << " | 存储成本: " << totalStore
+       << " | 靠泊时间: " << totalBerthTime << " 小时" << endl;
+}
+
+bool writeSolutionCSV(const ModelParams& params, const PortSolution& sol, const string& outDir) {
+    if (!mkdir_p(outDir)) {
+        cerr << "无法创建输出目录: " << outDir << endl;
+        return false;
+    }
+
+    // 每艘船的成本分解
+    {
+        vector<ShipCost> costs = evaluateShipCosts(params, sol);
+        ofstream ofs(outDir + "/objective_breakdown.csv");
+        ofs << "ship,transshipment_cost,storage_cost,berth_time,alpha,beta,weighted_contribution\n";
+        for (int s = 0; s < params.numShips; ++s) {
+            const ShipCost& c = costs[s];
+            double weighted = params.alpha * (c.transshipment + c.storage) + params.beta * c.berthTime;
+            ofs << s << "," << c.transshipment << "," << c.storage << "," << c.berthTime
+                << "," << params.alpha << "," << params.beta << "," << weighted << "\n";
+        }
+    }
+
+    // 泊位分配
+    {
+        ofstream ofs(outDir + "/berth_assignment.csv");
+        ofs << "ship,berth\n";
+        for (int s = 0; s < params.numShips; s++) {
+            if (sol.berth[s] >= 0) ofs << s << "," << sol.berth[s] << "\n";
+        }
+    }
+
+    // 每个槽的分配 (s,k,row,slot)
+    {
+        ofstream ofs(outDir + "/slot_allocations.csv");
+        ofs << "ship,k,row,slot\n";
+        for (int s = 0; s < params.numShips; ++s) {
+            for (int k = 0; k < params.numShipK; ++k) {
+                if (sol.row[s][k] < 0) continue;
+                const vector<int>& occ = sol.slots[s][k];
+                for (size_t i = 0; i < occ.size(); ++i) {
+                    ofs << s << "," << k << "," << sol.row[s][k] << "," << occ[i] << "\n";
+                }
+            }
+        }
+    }
+
+    // 每个货舱占用区间
+    {
+        ofstream ofs(outDir + "/intervals.csv");
+        ofs << "ship,k,row,intervals\n";
+        for (int s = 0; s < params.numShips; ++s) {
+            for (int k = 0; k < params.numShipK; ++k) {
+                if (sol.row[s][k] < 0 || sol.slots[s][k].empty()) continue;
+                vector<pair<int,int>> intervals = mergeIntervals(sol.slots[s][k]);
+                ostringstream oss;
+                for (size_t ii = 0; ii < intervals.size(); ++ii) {
+                    if (ii > 0) oss << ";";
+                    if (intervals[ii].first == intervals[ii].second) oss << intervals[ii].first;
+                    else oss << intervals[ii].first << "-" << intervals[ii].second;
+                }
+                ofs << s << "," << k << "," << sol.row[s][k] << "," << '"' << oss.str() << '"' << "\n";
+            }
+        }
+    }
+
+    // e_s
+    {
+        ofstream ofs(outDir + "/e_s.csv");
+        ofs << "ship,e_s\n";
+        for (int s = 0; s < params.numShips; ++s) ofs << s << "," << sol.e[s] << "\n";
+    }
+
+    // e_sk
+    {
+        ofstream ofs(outDir + "/e_sk.csv");
+        ofs << "ship,k,e_sk\n";
+        for (int s = 0; s < params.numShips; ++s) {
+            for (int k = 0; k < params.numShipK; ++k) {
+                ofs << s << "," << k << "," << sol.e_sk[s][k] << "\n";
+            }
+        }
+    }
+    return true;
+}
+
+// 逐行读取 CSV（跳过表头），每行按逗号切分后交给 fn；文件不存在时返回 false
+template <typename Fn>
+static bool forEachCsvRow(const string& path, Fn fn) {
+    ifstream in(path.c_str());
+    if (!in) {
+        cerr << "无法打开文件: " << path << endl;
+        return false;
+    }
+    string line;
+    getline(in, line);
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        vector<double> cols;
+        istringstream ss(line);
+        string cell;
+        while (getline(ss, cell, ',')) cols.push_back(atof(cell.c_str()));
+        fn(cols);
+    }
+    return true;
+}
+
+bool readSolutionCSV(const ModelParams& params, const string& outDir, PortSolution& sol) {
+    initSolution(sol, params);
+    const int S = params.numShips, K = params.numShipK;
+    int bad = 0;
+    bool ok = forEachCsvRow(outDir + "/berth_assignment.csv", [&](const vector<double>& c) {
+        int s = c.size() >= 2 ? static_cast<int>(c[0]) : -1;
+        if (s < 0 || s >= S) { ++bad; return; }
+        sol.berth[s] = static_cast<int>(c[1]);
+    });
+    ok = ok && forEachCsvRow(outDir + "/slot_allocations.csv", [&](const vector<double>& c) {
+        int s = c.size() >= 4 ? static_cast<int>(c[0]) : -1;
+        int k = c.size() >= 4 ? static_cast<int>(c[1]) : -1;
+        if (s < 0 || s >= S || k < 0 || k >= K) { ++bad; return; }
+        sol.row[s][k] = static_cast<int>(c[2]);
+        sol.slots[s][k].push_back(static_cast<int>(c[3]));
+    });
+    ok = ok && forEachCsvRow(outDir + "/e_s.csv", [&](const vector<double>& c) {
+        int s = c.size() >= 2 ? static_cast<int>(c[0]) : -1;
+        if (s < 0 || s >= S) { ++bad; return; }
+        sol.e[s] = c[1];
+    });
+    ok = ok && forEachCsvRow(outDir + "/e_sk.csv", [&](const vector<double>& c) {
+        int s = c.size() >= 3 ? static_cast<int>(c[0]) : -1;
+        int k = c.size() >= 3 ? static_cast<int>(c[1]) : -1;
+        if (s < 0 || s >= S || k < 0 || k >= K) { ++bad; return; }
+        sol.e_sk[s][k] = c[2];
+    });
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < K; ++k) sort(sol.slots[s][k].begin(), sol.slots[s][k].end());
+    }
+    if (bad) cerr << outDir << ": " << bad << " 行下标越界，已忽略" << endl;
+    return ok && bad == 0;
+}
@@ -0,0 +1,54 @@
+#ifndef PORT_SOLUTION_H
+#define PORT_SOLUTION_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "modelParam.h"
+
+// 与求解器无关的解：泊位分配、每个货舱的堆场行与槽、卸载开始时间
+// 由 extractSolution（port_model.h，CPLEX）或启发式直接填写，输出 CSV 与成本分解都只依赖它
+struct PortSolution {
+    std::vector<int> berth;                          // [s] 泊位，-1 表示未分配
+    std::vector<std::vector<int>> row;               // [s][k] 堆场行，-1 表示未分配
+    std::vector<std::vector<std::vector<int>>> slots; // [s][k] 在所分配行中占用的槽（升序）
+    std::vector<double> e;                           // [s] 船舶卸载开始时间
+    std::vector<std::vector<double>> e_sk;           // [s][k] 货舱卸货开始时间
+};
+
+// 每艘船的成本与时间分解（与 objective_breakdown.csv 的列对应）
+struct ShipCost {
+    double transshipment = 0.0;
+    double storage = 0.0;
+    double berthTime = 0.0;   // 等待 + 卸货时长（小时）
+};
+
+// 按 params 的维度分配空解（泊位、行为 -1，时间为到达时间）
+void initSolution(PortSolution& sol, const ModelParams& params);
+
+// 把货舱 (s,k) 放在行 r 的 [start, start+len) 槽
+void placeBlock(PortSolution& sol, int s, int k, int r, int start, int len);
+
+// 货舱 k 在泊位 b 的卸货时长 gamma_s / (K * p_sbk)（速度非正时按 1 处理）
+double compartmentDuration(const ModelParams& params, int s, int b, int k);
+// 船舶 s 在泊位 b 的总卸载时长：各舱串行卸货，sum_k compartmentDuration
+double berthProcessingTime(const ModelParams& params, int s, int b);
+
+// 按模型目标函数的定义计算每艘船的转运成本、存储成本与靠泊时间
+std::vector<ShipCost> evaluateShipCosts(const ModelParams& params, const PortSolution& sol);
+// alpha * (转运 + 存储) + beta * 靠泊时间 的总和
+double weightedObjective(const ModelParams& params, const std::vector<ShipCost>& costs);
+
+// 递归创建目录（等价于 mkdir -p）
+bool mkdir_p(const std::string& dirPath);
+
+// 控制台输出：泊位分配、槽位区间、卸载时间与成本分解
+void printSolution(std::ostream& os, const ModelParams& params, const PortSolution& sol);
+
+// 写入 outDir 下的 objective_breakdown / berth_assignment / slot_allocations / intervals / e_s / e_sk.csv
+bool writeSolutionCSV(const ModelParams& params, const PortSolution& sol, const std::string& outDir);
+
+// 从 writeSolutionCSV 写出的目录读回解（berth_assignment / slot_allocations / e_s / e_sk.csv）
+bool readSolutionCSV(const ModelParams& params, const std::string& outDir, PortSolution& sol);
+
+#endif // PORT_SOLUTION_H
@@ -0,0 +1,164 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "model_options.h"
+#include "port_ir.h"
+#include "port_solution.h"
+#include "heuristic.h"
+#include "phase_timer.h"
+#include "highs_backend.h"
+#include "model_writer.h"
+#include "model_bounds.h"
+#include "instance_cache.h"
+
+using namespace std;
+
+// 不依赖 CPLEX 的求解程序：由 port_ir 生成稀疏模型，交给开源求解器 HiGHS（构建时找到才可用）。
+// 模型与 verify 相同（按相同选项），但只支持整体 MIP；HiGHS 不支持二次目标，默认使用 --trans=slot。
+// 用法: ./port_solve [--input=算例前缀] [--output=输出目录] [--trans=slot|berth] [--seq=full|pairs] [--yard=blocks|slots] [--threads=N] [--time-limit=秒] [--mipstart=on|off] [--tighten=on|off] [--pair-elim=on|off] [--export=文件名] [--cache=目录] [--build-only]
+// --export 把模型写到输出目录下的该文件（.lp / .mps，可加 .gz，见 model_writer.h）
+// --cache 按算例指纹缓存参数、稀疏模型与最好解（与 verify 共用同一目录，见 instance_cache.h）
+// --build-only 只生成模型并输出规模与各约束族的建模耗时
+int main(int argc, char** argv) {
+    ModelOptions opts;
+    opts.transshipment = TransSlot;
+    string input = "data/example_L12/params_output", output = "output/output_L12";
+    bool buildOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 8, "--input=") == 0) input = arg.substr(8);
+        else if (arg.compare(0, 9, "--output=") == 0) output = arg.substr(9);
+        else if (arg == "--build-only") buildOnly = true;
+        else if (!parseModelOption(arg, opts)) return 1;
+    }
+    if (opts.method != MethodMonolithic) {
+        cerr << "port_solve 只支持 --method=mip（Benders 与滚动时域见 verify）" << endl;
+        return 1;
+    }
+    if (opts.yard == YardColumns) {
+        // 列生成的定价问题需要 CPLEX，这里直接用全部放置
+        cout << "列生成需要 CPLEX，改用 --yard=blocks" << endl;
+        opts.yard = YardBlocks;
+    }
+    if (opts.lazyOverlap) {
+        cout << "HiGHS 没有延迟约束回调，不重叠约束全部放入模型" << endl;
+        opts.lazyOverlap = false;
+    }
+
+    ModelParams params;
+    InstanceCache cache(opts.cacheDir);
+    uint64_t fingerprint = 0;
+    const bool cachedParams = cache.findParams(input, opts, params, fingerprint);
+    if (cachedParams) cout << "[缓存] 参数读自 " << opts.cacheDir << endl;
+    else if (!loadParamsAuto(input, params)) return 1;
+    if (cache.enabled()) {
+        const uint64_t current = instanceFingerprint(params, opts);
+        if (!cachedParams || current != fingerprint) cache.storeParams(input, opts, params, current);
+        fingerprint = current;
+    }
+
+    PortSolution start;
+    bool haveStart = false, startFeasible = false;
+    double greedyObjective = 0;
+    if (opts.mipStart) {
+        haveStart = greedySolution(params, start, &startFeasible);
+        if (haveStart) {
+            greedyObjective = weightedObjective(params, evaluateShipCosts(params, start));
+            cout << "贪心启发式: 目标函数值 " << greedyObjective << endl;
+            // 只有可行解的目标值才是上界，可作为截断（见 model_bounds.h）
+            if (startFeasible) opts.objectiveCutoff = greedyObjective;
+            else cout << "贪心解超过规划期，不作为目标值截断" << endl;
+        } else {
+            cout << "贪心启发式未找到可行解，不使用初始解" << endl;
+        }
+    }
+    CachedResult known;
+    if (cache.loadResult(fingerprint, params, known) && known.haveSolution && opts.mipStart &&
+        (!haveStart || !startFeasible || known.objective < greedyObjective - 1e-9)) {
+        cout << "[缓存] 使用已知最好的解作为初始解: 目标函数值 " << known.objective << endl;
+        start = known.solution;
+        haveStart = true;
+    }
+
+    PhaseProfile profile;
+    SparseModel model, lazyRows;
+    PortIndex index;
+    double cutoff = 0;
+    if (cache.loadModel(fingerprint, model, index, lazyRows, cutoff) && cutoff == opts.objectiveCutoff) {
+        index.opts = opts;
+        cout << "[缓存] 命中，跳过建模" << endl;
+    } else {
+        model = SparseModel();
+        index = PortIndex();
+        buildPortIR(params, opts, model, index, 0, &profile);
+        if (cache.enabled() && !cache.storeModel(fingerprint, model, index, SparseModel(), opts.objectiveCutoff)) {
+            cerr << "[缓存] 无法写入模型" << endl;
+        }
+    }
+    cout << "转运成本形式: " << transshipmentFormName(opts.transshipment)
+         << " | 先后关系形式: " << sequencingFormName(opts.sequencing)
+         << " | 堆场形式: " << yardFormName(opts.yard)
+         << " | 模型规模: 变量 " << model.numCols() << " 约束 " << model.numRows()
+         << " 非零元 " << model.numNonzeros() << " 二次项 " << model.quad.size()
+         << " | 内存 " << fixed << setprecision(1) << model.memoryMB() << " MB" << defaultfloat << setprecision(6) << endl;
+    printBoundReport(cout, params, opts);
+    cout << "建模各阶段实际开销:" << endl;
+    cout << "  " << left << setw(28) << "phase" << right << setw(12) << "wall_ms" << setw(12) << "cpu_ms" << endl;
+    for (size_t i = 0; i < profile.phases().size(); ++i) {
+        const PhaseRecord& r = profile.phases()[i];
+        cout << "  " << left << setw(28) << r.name << right << fixed << setprecision(1) << setw(12) << r.wallMs
+             << setw(12) << r.cpuMs << defaultfloat << setprecision(6) << endl;
+    }
+    if (!opts.exportFile.empty()) {
+        auto writeStart = chrono::steady_clock::now();
+        mkdir_p(output);
+        const string path = output + "/" + opts.exportFile;
+        if (!writeModelFile(model, portColumnNames(index, model.numCols()), path)) return 1;
+        cout << "模型已写入 " << path << "，耗时 "
+             << chrono::duration<double, milli>(chrono::steady_clock::now() - writeStart).count() << " ms" << endl;
+    }
+    if (buildOnly) return 0;
+
+    HighsSolveOptions hs;
+    hs.timeLimit = opts.timeLimit;
+    hs.threads = opts.threads;
+    vector<pair<int,double>> init;
+    if (haveStart) portMIPStart(params, index, start, init);
+    HighsSolveResult res;
+    if (!solveWithHighs(model, hs, haveStart ? &init : 0, res, cerr)) return 1;
+
+    cout << "求解状态: " << res.status << " | 求解时间 " << res.seconds << " 秒" << endl;
+    if (!res.hasSolution) return 1;
+    PortSolution sol;
+    extractPortSolution(params, index, [&](int c) { return res.values[c]; }, sol);
+    if (cache.enabled()) {
+        // 目标值按解重新计算，与 verify 写入的记录可比
+        CachedResult cr;
+        cr.haveSolution = true;
+        cr.solution = sol;
+        cr.objective = weightedObjective(params, evaluateShipCosts(params, sol));
+        cr.haveBound = fabs(res.bound) < SPARSE_INF;
+        cr.bound = res.bound;
+        if (!cache.storeResult(fingerprint, params, cr)) cerr << "[缓存] 无法写入解" << endl;
+        if (known.haveBound && known.bound > res.bound) {
+            res.bound = known.bound;
+            res.gap = fabs(res.objective - res.bound) / (1e-10 + fabs(res.objective));
+            cout << "[缓存] 缓存中的最佳界更好" << endl;
+        }
+    }
+    cout << "目标函数值: " << res.objective << endl;
+    cout << "最佳界(best bound): " << res.bound << endl;
+    cout << "与最优解差距(MIP gap): " << (res.gap * 100.0) << " %" << endl;
+
+    printSolution(cout, params, sol);
+    if (!writeSolutionCSV(params, sol, output)) {
+        cerr << "写输出文件时出错: " << output << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "model_options.h"
+#include "port_solution.h"
+#include "reschedule.h"
+#include "solve_telemetry.h"
+
+using namespace std;
+
+// 事件驱动的增量重排（见 reschedule.h）：先按 --time-limit 求解初始计划，再逐行读取事件文件，
+// 每行应用一个事件并以上一次的计划为初始解、按 --replan-limit 重新求解。空行与 # 之后的内容忽略；
+// 一行 "resolve" 立即重排此前尚未重排的事件（与 --batch 一起使用时把多个事件合为一次重排）。
+// 用法: ./replan [--input=算例前缀] [--output=输出目录] [--events=事件文件] [--replan-limit=秒] [--batch] [--trans=slot|berth] [--seq=full|pairs] [--yard=blocks|slots] [--threads=N] [--time-limit=秒] [--mipstart=on|off] [--tighten=on|off] [--pair-elim=on|off] [--progress=秒] [--snapshots=on|off]
+// --batch 只在遇到 "resolve" 行与文件末尾时重排
+// 每个计划写到 输出目录/replan_NNNN/（同 verify 的 CSV，另有 ships.csv 给出船舶下标与稳定编号），
+// 各次重排的统计追加到 输出目录/replan.csv
+int main(int argc, char** argv) {
+    ModelOptions opts;
+    opts.transshipment = TransSlot;
+    string input = "data/example_L12/params_output", output = "output/replan_L12", eventsFile;
+    double replanLimit = 60;
+    bool batch = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 8, "--input=") == 0) input = arg.substr(8);
+        else if (arg.compare(0, 9, "--output=") == 0) output = arg.substr(9);
+        else if (arg.compare(0, 9, "--events=") == 0) eventsFile = arg.substr(9);
+        else if (arg.compare(0, 15, "--replan-limit=") == 0) replanLimit = atof(arg.substr(15).c_str());
+        else if (arg == "--batch") batch = true;
+        else if (!parseModelOption(arg, opts)) return 1;
+    }
+
+    ModelParams params;
+    if (!loadParamsAuto(input, params)) return 1;
+    if (!mkdir_p(output)) {
+        cerr << "无法创建输出目录: " << output << endl;
+        return 1;
+    }
+    ifstream events;
+    if (!eventsFile.empty()) {
+        events.open(eventsFile.c_str());
+        if (!events) {
+            cerr << "无法打开事件文件: " << eventsFile << endl;
+            return 1;
+        }
+    }
+    ofstream summary((output + "/replan.csv").c_str());
+    summary << "version,events,ships,frozen,sync_ms,rows_added,rows_removed,rows_kept,cols_added,cols_removed,"
+               "bounds_changed,start_complete,start_objective,solve_s,status,objective,gap" << endl;
+
+    Rescheduler rescheduler(params, opts, cout);
+    int version = 0;
+    string pending = "initial";
+    // 求解一次并写出计划与统计，失败（无解）时返回 false
+    auto replan = [&](double limit) {
+        char dir[32];
+        snprintf(dir, sizeof(dir), "/replan_%04d", version);
+        const string outDir = output + dir;
+        mkdir_p(outDir);
+        PortSolution sol;
+        RescheduleReport rep;
+        SolveTelemetry telemetry(rescheduler.params(), rescheduler.model(), outDir, rescheduler.options().progressInterval,
+                                 rescheduler.options().snapshots);
+        telemetry.start();
+        const bool ok = rescheduler.resolve(limit, sol, &rep, &telemetry, IloCplex::Callback::Context::Id::GlobalProgress);
+        telemetry.finish();
+
+        cout << "[" << version << "] " << pending << " | 船舶 " << rep.ships << "（冻结 " << rep.frozen << "）"
+             << " | 同步 " << fixed << setprecision(1) << rep.syncMs << " ms: 行 +" << rep.rowsAdded << " -" << rep.rowsRemoved
+             << "（保留 " << rep.rowsKept << "），列 +" << rep.colsAdded << " -" << rep.colsRemoved << "，上下界 " << rep.boundsChanged
+             << defaultfloat << setprecision(6) << " | 初始解 " << (rep.startComplete ? "完整" : "不完整");
+        if (rep.startComplete) cout << " " << rep.startObjective;
+        cout << " | " << rep.status << " " << rep.solveSeconds << " 秒";
+        if (ok) cout << " | 目标函数值 " << rep.objective << " gap " << (rep.gap * 100.0) << " %";
+        cout << endl;
+        summary << version << ",\"" << pending << "\"," << rep.ships << "," << rep.frozen << "," << rep.syncMs << ","
+                << rep.rowsAdded << "," << rep.rowsRemoved << "," << rep.rowsKept << "," << rep.colsAdded << "," << rep.colsRemoved << ","
+                << rep.boundsChanged << "," << (rep.startComplete ? 1 : 0) << "," << rep.startObjective << "," << rep.solveSeconds << ","
+                << rep.status << "," << (ok ? rep.objective : 0.0) << "," << (ok ? rep.gap : 0.0) << endl;
+
+        if (ok) {
+            if (!writeSolutionCSV(rescheduler.params(), sol, outDir)) cerr << "写输出文件时出错: " << outDir << endl;
+            ofstream ships((outDir + "/ships.csv").c_str());
+            ships << "ship,id,arrival,frozen" << endl;
+            for (int s = 0; s < rescheduler.params().numShips; ++s) {
+                ships << s << "," << rescheduler.shipIds()[s] << "," << rescheduler.params().arrivalTime[s] << ","
+                      << (rescheduler.frozen(s) ? 1 : 0) << endl;
+            }
+        }
+        ++version;
+        pending.clear();
+        return ok;
+    };
+
+    if (!replan(opts.timeLimit)) {
+        cerr << "初始计划求解失败" << endl;
+        return 1;
+    }
+    string line;
+    int lineNo = 0;
+    while (events.is_open() && getline(events, line)) {
+        ++lineNo;
+        const size_t hash = line.find('#');
+        if (hash != string::npos) line.erase(hash);
+        istringstream check(line);
+        string word;
+        if (!(check >> word)) continue;
+        if (word == "resolve") {
+            if (!pending.empty()) replan(replanLimit);
+            continue;
+        }
+        ScheduleEvent event;
+        if (!parseScheduleEvent(line, event) || !rescheduler.apply(event)) {
+            cerr << eventsFile << ":" << lineNo << ": 跳过该事件" << endl;
+            continue;
+        }
+        pending += (pending.empty() ? "" : ";") + scheduleEventText(event);
+        if (!batch) replan(replanLimit);
+    }
+    if (!pending.empty()) replan(replanLimit);
+    return 0;
+}
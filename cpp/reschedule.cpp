@@ -0,0 +1,667 @@
+#include "reschedule.h"
+#include "port_ir.h"
+#include "heuristic.h"
+#include "rolling_horizon.h"
+#include "binary_instance.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+bool parseScheduleEvent(const string& line, ScheduleEvent& event) {
+    string text = line;
+    replace(text.begin(), text.end(), ',', ' ');
+    istringstream in(text);
+    vector<string> f;
+    string w;
+    while (in >> w) f.push_back(w);
+    event = ScheduleEvent();
+    // 数值字段：整段都须是数字
+    bool ok = true;
+    auto num = [&](size_t i) {
+        char* end = 0;
+        double v = i < f.size() ? strtod(f[i].c_str(), &end) : 0.0;
+        if (i >= f.size() || end == f[i].c_str() || *end != '\0') ok = false;
+        return v;
+    };
+    auto integer = [&](size_t i) {
+        double v = num(i);
+        if (v != static_cast<int>(v)) ok = false;
+        return static_cast<int>(v);
+    };
+    size_t fields = 0;
+    if (f.empty()) {
+        ok = false;
+    } else if (f[0] == "arrival") {
+        event.type = EventArrival;
+        event.ship = integer(1);
+        event.time = num(2);
+        fields = 3;
+    } else if (f[0] == "new") {
+        event.type = EventNewShip;
+        event.source = f.size() > 1 ? f[1] : "";
+        event.sourceShip = integer(2);
+        if (f.size() > 3) event.time = num(3);
+        fields = f.size() > 3 ? 4 : 3;
+    } else if (f[0] == "cancel") {
+        event.type = EventCancel;
+        event.ship = integer(1);
+        fields = 2;
+    } else if (f[0] == "berth-down") {
+        event.type = EventBerthDown;
+        event.berth = integer(1);
+        event.time = num(2);
+        event.until = num(3);
+        fields = 4;
+    } else if (f[0] == "now") {
+        event.type = EventClock;
+        event.time = num(1);
+        fields = 2;
+    } else {
+        ok = false;
+    }
+    if (!ok || f.size() != fields) {
+        cerr << "无效的事件: " << line
+             << "（可选 arrival,船,时间 | new,算例前缀,船[,到达时间] | cancel,船 | berth-down,泊位,开始,结束 | now,时间）" << endl;
+        return false;
+    }
+    return true;
+}
+
+string scheduleEventText(const ScheduleEvent& event) {
+    ostringstream os;
+    switch (event.type) {
+    case EventArrival:
+        os << "arrival," << event.ship << "," << event.time;
+        break;
+    case EventNewShip:
+        os << "new," << event.source << "," << event.sourceShip;
+        if (event.time >= 0) os << "," << event.time;
+        break;
+    case EventCancel:
+        os << "cancel," << event.ship;
+        break;
+    case EventBerthDown:
+        os << "berth-down," << event.berth << "," << event.time << "," << event.until;
+        break;
+    case EventClock:
+        os << "now," << event.time;
+        break;
+    }
+    return os.str();
+}
+
+// 把 src 的第 j 艘船追加到 params 末尾（泊位、货舱与堆场维度须相同）
+static void appendShip(ModelParams& params, const ModelParams& src, int j) {
+    const int S = params.numShips, B = params.numBerths, K = params.numShipK, R = params.numRows;
+    ParamTensor3 speed(S + 1, B, K), storage(S + 1, K, R);
+    for (int s = 0; s <= S; ++s) {
+        const ModelParams& from = s < S ? params : src;
+        const int i = s < S ? s : j;
+        for (int b = 0; b < B; ++b) copy(from.unloadingSpeed.row(i, b), from.unloadingSpeed.row(i, b) + K, speed.row(s, b));
+        for (int k = 0; k < K; ++k) copy(from.storageCost.row(i, k), from.storageCost.row(i, k) + R, storage.row(s, k));
+    }
+    params.unloadingSpeed = speed;
+    params.storageCost = storage;
+    params.arrivalTime.push_back(src.arrivalTime[j]);
+    params.cargoWeight.push_back(src.cargoWeight[j]);
+    params.requiredSlots.push_back(src.requiredSlots[j]);
+    if (static_cast<int>(params.cargoDensity.size()) == S && j < static_cast<int>(src.cargoDensity.size())) {
+        params.cargoDensity.push_back(src.cargoDensity[j]);
+    }
+    if (static_cast<int>(params.maxResponseAngle.size()) == S && j < static_cast<int>(src.maxResponseAngle.size())) {
+        params.maxResponseAngle.push_back(src.maxResponseAngle[j]);
+    }
+    params.numShips = S + 1;
+}
+
+// 各列所属的船舶：first 为船舶下标，先后关系变量另有 second（其余为 -1）
+static void columnOwners(const PortIndex& idx, int numCols, vector<int>& first, vector<int>& second) {
+    const int S = idx.S, K = idx.K, B = idx.B, R = idx.R, V = idx.V;
+    first.assign(numCols, -1);
+    second.assign(numCols, -1);
+    auto own = [&](int col, int s, int t) {
+        if (col < 0) return;
+        first[col] = s;
+        second[col] = t;
+    };
+    for (int s = 0; s < S; s++) {
+        own(idx.eCol(s), s, -1);
+        for (int b = 0; b < B; b++) {
+            own(idx.zCol(s, b), s, -1);
+            if (!idx.transBerth.empty()) own(idx.transBerthCol(s, b), s, -1);
+        }
+        for (int k = 0; k < K; k++) {
+            own(idx.eskCol(s, k), s, -1);
+            for (int t = 0; t < K; t++) own(idx.qCol(s, k, t), s, -1);
+            for (int r = 0; r < R; r++) {
+                if (!idx.f.empty()) own(idx.fCol(s, k, r), s, -1);
+                for (int v = 0; v < V; v++) {
+                    if (!idx.x.empty()) {
+                        own(idx.xCol(s, k, r, v), s, -1);
+                        own(idx.hCol(s, k, r, v), s, -1);
+                    }
+                    if (!idx.place.empty()) own(idx.placeCol(s, k, r, v), s, -1);
+                    if (!idx.transSlot.empty()) own(idx.transSlotCol(s, k, r, v), s, -1);
+                }
+            }
+        }
+        for (int t = 0; t < S; t++) {
+            if (!idx.order.empty()) own(idx.orderCol(s, t), s, t);
+            if (idx.y.empty()) continue;
+            own(idx.yCol(s, t), s, t);
+            for (int b = 0; b < B; b++) {
+                own(idx.omegaCol(s, t, b), s, t);
+                own(idx.lambdaCol(s, t, b), s, t);
+                own(idx.muCol(s, t, b), s, t);
+            }
+        }
+    }
+}
+
+static string numberText(double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+Rescheduler::Rescheduler(const ModelParams& params, const ModelOptions& opts, ostream& log)
+    : log_(log), opts_(opts), params_(params) {
+    if (opts_.transshipment == TransProduct) {
+        log_ << "增量重排: 二次的 product 转运成本改用 --trans=slot（目标只有线性项，可逐列修改）" << endl;
+        opts_.transshipment = TransSlot;
+    }
+    if (opts_.yard == YardColumns || opts_.yard == YardNone) {
+        log_ << "增量重排: 堆场改用 --yard=blocks（列池取决于泊位情景，不随事件更新）" << endl;
+        opts_.yard = YardBlocks;
+    }
+    if (opts_.lazyOverlap) {
+        log_ << "增量重排: 不使用 --lazy-overlap" << endl;
+        opts_.lazyOverlap = false;
+    }
+    if (opts_.method != MethodMonolithic) {
+        log_ << "增量重排: 只支持单一 MIP，忽略 --method=" << solveMethodName(opts_.method) << endl;
+        opts_.method = MethodMonolithic;
+    }
+    opts_.objectiveCutoff = 0;
+    for (int s = 0; s < params_.numShips; ++s) ids_.push_back(nextId_++);
+    initSolution(plan_, params_);
+    pm_.model = IloModel(env_);
+    pm_.objective = IloMinimize(env_);
+    pm_.model.add(pm_.objective);
+    pm_.opts = opts_;
+    pm_.columns = IloNumVarArray(env_);
+}
+
+Rescheduler::~Rescheduler() {
+    env_.end();
+}
+
+int Rescheduler::shipIndex(int id) const {
+    for (size_t s = 0; s < ids_.size(); ++s) {
+        if (ids_[s] == id) return static_cast<int>(s);
+    }
+    return -1;
+}
+
+bool Rescheduler::frozen(int s) const {
+    return plan_.berth[s] >= 0 && plan_.e[s] < now_;
+}
+
+bool Rescheduler::apply(const ScheduleEvent& event) {
+    const string text = scheduleEventText(event);
+    const int s = event.type == EventArrival || event.type == EventCancel ? shipIndex(event.ship) : -1;
+    if ((event.type == EventArrival || event.type == EventCancel) && s < 0) {
+        cerr << "[增量重排] " << text << ": 没有编号为 " << event.ship << " 的船舶" << endl;
+        return false;
+    }
+    if (s >= 0 && frozen(s)) {
+        cerr << "[增量重排] " << text << ": 船舶 " << event.ship << " 已于 " << plan_.e[s] << " 开始卸载，不能修改" << endl;
+        return false;
+    }
+
+    switch (event.type) {
+    case EventArrival:
+        if (event.time < 0) {
+            cerr << "[增量重排] " << text << ": 到达时间不能为负" << endl;
+            return false;
+        }
+        params_.arrivalTime[s] = event.time;
+        break;
+    case EventNewShip: {
+        auto it = sources_.find(event.source);
+        if (it == sources_.end()) {
+            ModelParams src;
+            if (!loadParamsAuto(event.source, src)) return false;
+            it = sources_.insert(make_pair(event.source, src)).first;
+        }
+        const ModelParams& src = it->second;
+        if (src.numBerths != params_.numBerths || src.numShipK != params_.numShipK || src.numRows != params_.numRows
+            || src.numSlotsPerRow != params_.numSlotsPerRow) {
+            cerr << "[增量重排] " << text << ": 算例的泊位/货舱/堆场维度与当前算例不同" << endl;
+            return false;
+        }
+        if (event.sourceShip < 0 || event.sourceShip >= src.numShips) {
+            cerr << "[增量重排] " << text << ": 算例中没有第 " << event.sourceShip << " 艘船" << endl;
+            return false;
+        }
+        appendShip(params_, src, event.sourceShip);
+        if (event.time >= 0) params_.arrivalTime.back() = event.time;
+        ids_.push_back(nextId_++);
+        plan_.berth.push_back(-1);
+        plan_.row.push_back(vector<int>(params_.numShipK, -1));
+        plan_.slots.push_back(vector<vector<int>>(params_.numShipK));
+        plan_.e.push_back(params_.arrivalTime.back());
+        plan_.e_sk.push_back(vector<double>(params_.numShipK, params_.arrivalTime.back()));
+        log_ << "[增量重排] 新增船舶 " << ids_.back() << "（" << event.source << " 第 " << event.sourceShip
+             << " 艘，到达 " << params_.arrivalTime.back() << "）" << endl;
+        break;
+    }
+    case EventCancel: {
+        vector<int> keep;
+        for (int t = 0; t < params_.numShips; ++t) {
+            if (t != s) keep.push_back(t);
+        }
+        params_ = selectShips(params_, keep);
+        ids_.erase(ids_.begin() + s);
+        plan_.berth.erase(plan_.berth.begin() + s);
+        plan_.row.erase(plan_.row.begin() + s);
+        plan_.slots.erase(plan_.slots.begin() + s);
+        plan_.e.erase(plan_.e.begin() + s);
+        plan_.e_sk.erase(plan_.e_sk.begin() + s);
+        break;
+    }
+    case EventBerthDown: {
+        if (event.berth < 0 || event.berth >= params_.numBerths || event.until <= event.time) {
+            cerr << "[增量重排] " << text << ": 泊位或时段无效" << endl;
+            return false;
+        }
+        Outage o;
+        o.berth = event.berth;
+        o.from = event.time;
+        o.until = event.until;
+        outages_.push_back(o);
+        for (int t = 0; t < params_.numShips; ++t) {
+            const int b = plan_.berth[t];
+            if (b == o.berth && frozen(t) && plan_.e[t] < o.until
+                && plan_.e[t] + berthProcessingTime(params_, t, b) > o.from) {
+                log_ << "[增量重排] 泊位 " << b << " 停用时段与已开始卸载的船舶 " << ids_[t] << " 重叠，该船不受影响" << endl;
+            }
+        }
+        break;
+    }
+    case EventClock:
+        if (event.time < now_) {
+            cerr << "[增量重排] " << text << ": 时刻不能倒退（当前 " << now_ << "）" << endl;
+            return false;
+        }
+        now_ = event.time;
+        break;
+    }
+    ++pendingEvents_;
+    return true;
+}
+
+// 在泊位 b 上不早于 start、处理时长 duration 且不与停用时段重叠的最早开始时间
+double Rescheduler::outageFreeStart(int b, double start, double duration) const {
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        for (size_t i = 0; i < outages_.size(); ++i) {
+            const Outage& o = outages_[i];
+            if (o.berth == b && start < o.until && start + duration > o.from) {
+                start = o.until;
+                moved = true;
+            }
+        }
+    }
+    return start;
+}
+
+void Rescheduler::repairPlan(PortSolution& start) const {
+    const int S = params_.numShips, B = params_.numBerths, V = params_.numSlotsPerRow;
+    start = plan_;
+    // 已安排的船：各泊位按原计划的先后顺序依次顺延（冻结的船保持不变，排在最前）
+    vector<double> berthFree(B, 0.0);
+    vector<vector<int>> onBerth(B);
+    for (int s = 0; s < S; ++s) {
+        if (start.berth[s] >= 0) onBerth[start.berth[s]].push_back(s);
+    }
+    for (int b = 0; b < B; ++b) {
+        vector<int>& seq = onBerth[b];
+        sort(seq.begin(), seq.end(), [&](int s, int t) { return start.e[s] < start.e[t] || (start.e[s] == start.e[t] && s < t); });
+        for (size_t i = 0; i < seq.size(); ++i) {
+            const int s = seq[i];
+            const double p = berthProcessingTime(params_, s, b);
+            if (!frozen(s)) {
+                start.e[s] = outageFreeStart(b, max(max(params_.arrivalTime[s], now_), berthFree[b]), p);
+                setSerialCompartmentTimes(params_, start, s);
+            }
+            berthFree[b] = max(berthFree[b], start.e[s] + p);
+        }
+    }
+
+    // 未安排的船（新增）：按到达时间排到完工最早的泊位末尾，货舱放到成本最低的空闲槽段
+    vector<char> occupied(static_cast<size_t>(params_.numRows) * V, 0);
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < params_.numShipK; ++k) {
+            for (size_t j = 0; j < start.slots[s][k].size(); ++j) occupied[start.row[s][k] * V + start.slots[s][k][j]] = 1;
+        }
+    }
+    vector<int> order = shipsByArrival(params_);
+    for (size_t i = 0; i < order.size(); ++i) {
+        const int s = order[i];
+        if (start.berth[s] >= 0) continue;
+        int bestB = -1;
+        double bestStart = 0.0, bestEnd = 0.0;
+        for (int b = 0; b < B; ++b) {
+            const double p = berthProcessingTime(params_, s, b);
+            const double st = outageFreeStart(b, max(max(params_.arrivalTime[s], now_), berthFree[b]), p);
+            // 与贪心启发式相同：优先不超过规划期，其次完工最早
+            const bool in = st <= params_.planningHorizon, bestIn = bestB >= 0 && bestStart <= params_.planningHorizon;
+            if (bestB < 0 || (in && !bestIn) || (in == bestIn && st + p < bestEnd)) {
+                bestB = b;
+                bestStart = st;
+                bestEnd = st + p;
+            }
+        }
+        if (bestB < 0) continue;
+        vector<int> rows(params_.numShipK, -1), firsts(params_.numShipK, -1);
+        bool placed = true;
+        vector<char> trial = occupied;
+        for (int k = 0; k < params_.numShipK && placed; ++k) {
+            const int n = params_.requiredSlots[s][k];
+            if (n <= 0) continue;
+            double cost = 0.0;
+            placed = cheapestFreeBlock(params_, trial, s, k, bestB, rows[k], firsts[k], cost);
+            if (placed) {
+                for (int v = firsts[k]; v < firsts[k] + n; ++v) trial[static_cast<size_t>(rows[k]) * V + v] = 1;
+            }
+        }
+        if (!placed) continue;   // 堆场放不下：留给 MIP（MIPStartRepair）
+        occupied.swap(trial);
+        start.berth[s] = bestB;
+        start.e[s] = bestStart;
+        berthFree[bestB] = bestEnd;
+        setSerialCompartmentTimes(params_, start, s);
+        for (int k = 0; k < params_.numShipK; ++k) {
+            if (rows[k] >= 0) placeBlock(start, s, k, rows[k], firsts[k], params_.requiredSlots[s][k]);
+        }
+    }
+}
+
+void Rescheduler::buildTarget(const PortSolution& start, SparseModel& sm, PortIndex& idx, vector<string>& names,
+                              vector<double>& startValue) {
+    const int S = params_.numShips, K = params_.numShipK;
+    const double H = params_.planningHorizon;
+    buildPortIR(params_, opts_, sm, idx);
+    names = portColumnNames(idx, sm.numCols(), &ids_);
+
+    startValue.assign(sm.numCols(), -1.0);
+    vector<char> have(sm.numCols(), 0);
+    vector<pair<int,double>> values;
+    portMIPStart(params_, idx, start, values);
+    for (size_t i = 0; i < values.size(); ++i) {
+        startValue[values[i].first] = values[i].second;
+        have[values[i].first] = 1;
+    }
+
+    // 冻结已开始卸载的船：二元决策与 e / e_sk 固定为计划值；其余船不早于 now 开始
+    vector<int> first, second;
+    columnOwners(idx, sm.numCols(), first, second);
+    for (int c = 0; c < sm.numCols(); ++c) {
+        const int s = first[c];
+        if (s < 0 || second[c] >= 0 || !frozen(s) || !have[c]) continue;
+        if (sm.colType[c] == ColBinary) sm.colLb[c] = sm.colUb[c] = startValue[c];
+    }
+    for (int s = 0; s < S; ++s) {
+        if (frozen(s)) {
+            sm.colLb[idx.eCol(s)] = sm.colUb[idx.eCol(s)] = start.e[s];
+            for (int k = 0; k < K; ++k) sm.colLb[idx.eskCol(s, k)] = sm.colUb[idx.eskCol(s, k)] = start.e_sk[s][k];
+        } else {
+            sm.colLb[idx.eCol(s)] = max(sm.colLb[idx.eCol(s)], now_);
+            for (int k = 0; k < K; ++k) sm.colLb[idx.eskCol(s, k)] = max(sm.colLb[idx.eskCol(s, k)], now_);
+        }
+    }
+
+    // 泊位停用：船 s 在泊位 b 上须在 from 前完工（w = 1）或在 until 后开始（w = 0）
+    sm.beginRowFamily("berth_outage");
+    char buf[64];
+    for (size_t o = 0; o < outages_.size(); ++o) {
+        const Outage& out = outages_[o];
+        const int b = out.berth;
+        for (int s = 0; s < S; ++s) {
+            if (frozen(s)) continue;
+            const double release = max(params_.arrivalTime[s], now_), p = berthProcessingTime(params_, s, b);
+            if (out.until <= release || H + p <= out.from) continue;   // 时段与可能的卸载区间不相交
+            const bool before = release + p <= out.from, after = out.until <= H;
+            const int e = idx.eCol(s), z = idx.zCol(s, b);
+            const double M1 = H + p - out.from, M2 = out.until - release;
+            if (!before && !after) {
+                sm.colUb[z] = 0;
+            } else if (!before) {
+                // e_s >= until * z_sb
+                sm.addTerm(e, 1); sm.addTerm(z, -out.until); sm.addRow(0, SPARSE_INF);
+            } else if (!after) {
+                // e_s + p_sb <= from + M1 (1 - z_sb)
+                sm.addTerm(e, 1); sm.addTerm(z, M1); sm.addRow(-SPARSE_INF, out.from - p + M1);
+            } else {
+                const int w = sm.addColumns(1, 0, 1, ColBinary);
+                snprintf(buf, sizeof(buf), "w_%d_%d", ids_[s], static_cast<int>(o));
+                names.push_back(buf);
+                startValue.push_back(start.berth[s] == b ? (start.e[s] + p <= out.from ? 1.0 : 0.0) : 0.0);
+                // e_s + p_sb <= from + M1 (2 - z_sb - w)；until <= e_s + M2 (1 - z_sb + w)
+                sm.addTerm(e, 1); sm.addTerm(z, M1); sm.addTerm(w, M1); sm.addRow(-SPARSE_INF, 2 * M1 + out.from - p);
+                sm.addTerm(e, -1); sm.addTerm(z, M2); sm.addTerm(w, -M2); sm.addRow(-SPARSE_INF, M2 - out.until);
+            }
+        }
+    }
+}
+
+void Rescheduler::sync(const SparseModel& sm, const vector<string>& names, RescheduleReport& rep) {
+    const int n = sm.numCols();
+    // 列：按名称对应，删除消失的列（同时从所在的行与目标中移除）
+    unordered_map<string, int> colIndex;
+    colIndex.reserve(n);
+    for (int c = 0; c < n; ++c) colIndex[names[c]] = c;
+
+    // 行：族名、上下界与按列名排序的 (列, 系数) 作为键，内容不变的行保留，其余删除后重新加入
+    const long m = sm.numRows();
+    vector<string> rowKeys(m);
+    unordered_map<string, long> rowIndex;
+    rowIndex.reserve(m);
+    vector<pair<const string*, double>> terms;
+    for (long i = 0; i < m; ++i) {
+        terms.clear();
+        for (long p = sm.rowStart[i]; p < sm.rowStart[i + 1]; ++p) {
+            if (sm.rowValue[p] != 0) terms.push_back(make_pair(&names[sm.rowIndex[p]], sm.rowValue[p]));
+        }
+        sort(terms.begin(), terms.end(), [](const pair<const string*, double>& a, const pair<const string*, double>& b) {
+            return *a.first < *b.first;
+        });
+        string key = sm.rowFamilyNames[sm.rowFamily[i]] + "|" + numberText(sm.rowLb[i]) + "|" + numberText(sm.rowUb[i]);
+        for (size_t t = 0; t < terms.size(); ++t) key += "|" + *terms[t].first + "*" + numberText(terms[t].second);
+        // 内容完全相同的行（如 SeqPairs 的两条不重叠约束在 M 相同时）按出现次序区分
+        string unique = key;
+        for (int dup = 1; rowIndex.count(unique); ++dup) unique = key + "#" + to_string(dup);
+        rowIndex[unique] = i;
+        rowKeys[i].swap(unique);
+    }
+
+    for (auto it = liveRows_.begin(); it != liveRows_.end();) {
+        if (rowIndex.count(it->first)) {
+            ++it;
+            continue;
+        }
+        it->second.end();
+        it = liveRows_.erase(it);
+        ++rep.rowsRemoved;
+    }
+    for (auto it = liveCols_.begin(); it != liveCols_.end();) {
+        if (colIndex.count(it->first)) {
+            ++it;
+            continue;
+        }
+        it->second.var.end();
+        it = liveCols_.erase(it);
+        ++rep.colsRemoved;
+    }
+
+    IloNumVarArray columns(env_);
+    IloNumVarArray newCols(env_);
+    for (int c = 0; c < n; ++c) {
+        const double lb = sm.colLb[c], ub = sm.colUb[c] >= SPARSE_INF ? IloInfinity : sm.colUb[c];
+        auto it = liveCols_.find(names[c]);
+        if (it == liveCols_.end()) {
+            LiveColumn col;
+            col.var = IloNumVar(env_, lb, ub, sm.colType[c] == ColBinary ? IloNumVar::Bool : IloNumVar::Float);
+            if (opts_.names) col.var.setName(names[c].c_str());
+            col.lb = lb;
+            col.ub = ub;
+            col.obj = sm.obj[c];
+            if (col.obj != 0) pm_.objective.setLinearCoef(col.var, col.obj);
+            it = liveCols_.insert(make_pair(names[c], col)).first;
+            newCols.add(col.var);
+            ++rep.colsAdded;
+        } else {
+            LiveColumn& col = it->second;
+            if (col.lb != lb || col.ub != ub) {
+                col.var.setBounds(lb, ub);
+                col.lb = lb;
+                col.ub = ub;
+                ++rep.boundsChanged;
+            }
+            if (col.obj != sm.obj[c]) {
+                pm_.objective.setLinearCoef(col.var, sm.obj[c]);
+                col.obj = sm.obj[c];
+                ++rep.objChanged;
+            }
+        }
+        columns.add(it->second.var);
+    }
+    pm_.objective.setConstant(sm.objConstant);
+    pm_.columns.end();
+    pm_.columns = columns;
+    // 新列直接加入模型：不出现在任何行中的列（q_skk）也要被抽取，MIP 初始解才能引用它们
+    if (newCols.getSize() > 0) pm_.model.add(newCols);
+    newCols.end();
+
+    IloRangeArray added(env_);
+    IloNumVarArray vars(env_);
+    IloNumArray coefs(env_);
+    for (long i = 0; i < m; ++i) {
+        if (liveRows_.count(rowKeys[i])) {
+            ++rep.rowsKept;
+            continue;
+        }
+        for (long p = sm.rowStart[i]; p < sm.rowStart[i + 1]; ++p) {
+            if (sm.rowValue[p] == 0) continue;
+            vars.add(columns[sm.rowIndex[p]]);
+            coefs.add(sm.rowValue[p]);
+        }
+        IloRange r(env_, sm.rowLb[i] <= -SPARSE_INF ? -IloInfinity : sm.rowLb[i], sm.rowUb[i] >= SPARSE_INF ? IloInfinity : sm.rowUb[i]);
+        r.setLinearCoefs(vars, coefs);
+        vars.clear();
+        coefs.clear();
+        added.add(r);
+        liveRows_[rowKeys[i]] = r;
+        ++rep.rowsAdded;
+    }
+    if (added.getSize() > 0) pm_.model.add(added);
+    added.end();
+    vars.end();
+    coefs.end();
+    rep.cols = n;
+    rep.rows = m;
+}
+
+bool Rescheduler::resolve(double timeLimit, PortSolution& sol, RescheduleReport* report,
+                          IloCplex::Callback::Function* callback, CPXLONG contextMask) {
+    RescheduleReport rep;
+    rep.ships = params_.numShips;
+    rep.events = pendingEvents_;
+    for (int s = 0; s < params_.numShips; ++s) rep.frozen += frozen(s) ? 1 : 0;
+    auto t0 = chrono::steady_clock::now();
+
+    PortSolution start;
+    repairPlan(start);
+    rep.startComplete = true;
+    for (int s = 0; s < params_.numShips; ++s) rep.startComplete = rep.startComplete && start.berth[s] >= 0;
+    if (rep.startComplete) rep.startObjective = weightedObjective(params_, evaluateShipCosts(params_, start));
+
+    SparseModel sm;
+    PortIndex idx;
+    vector<string> names;
+    vector<double> startValue;
+    bool solved = false;
+    try {
+        buildTarget(start, sm, idx, names, startValue);
+        sync(sm, names, rep);
+        pm_.index = idx;
+        pm_.opts = opts_;
+        rep.syncMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        pendingEvents_ = 0;
+
+        // 第一次求解时才创建 IloCplex（整体抽取），之后的修改由 Concert 逐项传给 CPLEX
+        if (!extracted_) {
+            cplex_ = IloCplex(pm_.model);
+            extracted_ = true;
+            cplex_.setOut(env_.getNullStream());
+            cplex_.setWarning(env_.getNullStream());
+        }
+        cplex_.setParam(IloCplex::TiLim, timeLimit);
+        cplex_.setParam(IloCplex::Threads, opts_.threads);
+
+        // 初始解：修复后的计划，去掉未安排的船涉及的列
+        if (cplex_.getNMIPStarts() > 0) cplex_.deleteMIPStarts(0, cplex_.getNMIPStarts());
+        if (opts_.mipStart) {
+            vector<int> first, second;
+            columnOwners(idx, static_cast<int>(startValue.size()), first, second);
+            IloNumVarArray vars(env_);
+            IloNumArray vals(env_);
+            for (size_t c = 0; c < startValue.size(); ++c) {
+                if (startValue[c] < 0) continue;
+                if ((first[c] >= 0 && start.berth[first[c]] < 0) || (second[c] >= 0 && start.berth[second[c]] < 0)) continue;
+                vars.add(pm_.columns[static_cast<IloInt>(c)]);
+                vals.add(startValue[c]);
+            }
+            if (vars.getSize() > 0) {
+                cplex_.addMIPStart(vars, vals, rep.startComplete ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair, "plan");
+            }
+            vars.end();
+            vals.end();
+        }
+        if (callback) cplex_.use(callback, contextMask);
+
+        double s0 = cplex_.getCplexTime();
+        solved = cplex_.solve();
+        rep.solveSeconds = cplex_.getCplexTime() - s0;
+        ostringstream st;
+        st << cplex_.getStatus();
+        rep.status = st.str();
+        if (solved) {
+            rep.objective = cplex_.getObjValue();
+            try {
+                rep.bound = cplex_.getBestObjValue();
+                rep.gap = cplex_.getMIPRelativeGap();
+            } catch (...) {
+                // 某些情况下（非MIP或无效调用）可能抛异常，忽略即可
+            }
+            extractSolution(cplex_, params_, pm_, sol);
+            plan_ = sol;
+        }
+        // 回调只用于本次求解
+        if (callback) cplex_.use(0, 0);
+    } catch (IloException& ex) {
+        cerr << "[增量重排] CPLEX 异常: " << ex << endl;
+        rep.status = "Exception";
+        solved = false;
+    }
+    if (!solved) sol = start;
+    if (report) *report = rep;
+    return solved;
+}
@@ -0,0 +1,144 @@
+#ifndef RESCHEDULE_H
+#define RESCHEDULE_H
+
+#include <ilcplex/ilocplex.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <ostream>
+#include "modelParam.h"
+#include "model_options.h"
+#include "port_model.h"
+#include "port_solution.h"
+#include "port_ir.h"
+
+// 事件驱动的增量重排：一个常驻的 Concert 模型随到达时间变化、新增/取消船舶、泊位停用而就地修改，
+// 以上一次的计划为 MIP 初始解重新求解，而不是每次重新建模、冷启动。
+//
+// 每次 resolve() 按当前算例重新生成稀疏模型（buildPortIR，L12 约 50 ms），再按列名与行内容
+// 与常驻模型逐项比较：只修改变化了的列上下界与目标系数，删除消失的列与行、加入新出现的列与行，
+// 其余的行与变量（通常是绝大部分）原样保留在 CPLEX 中。列名用 portColumnNames 的格式，
+// 其中的船舶编号为稳定编号（初始算例的船为 0..S-1，新增的船依次编号），船舶增删不改变其它船的列名。
+//
+// 已执行的决策：当前时刻 now（EventClock）之前已开始卸载的船舶（上一次计划中 e_s < now）冻结，
+// 其泊位、开始时间、货舱时间与堆场位置固定为计划值；其余船舶的 e_s, e_sk >= max(tau_s, now)。
+// 泊位停用 [from, until)：未冻结的船在该泊位上须在 from 前完工或在 until 后开始（按时间窗只加需要的行，
+// 两者都可能时每个 (船, 停用) 一个二元变量，行族 berth_outage）。
+//
+// 初始解：上一次的计划按新的到达时间、冻结决策与停用时段修复（各泊位保持原先后顺序，依次顺延），
+// 新增的船按完工最早的泊位排在末尾、货舱放到成本最低的空闲槽段；完整时以 MIPStartAuto 加入，
+// 有船无法安排时以 MIPStartRepair 加入已安排的部分。
+//
+// 与 buildPortModel 的差别：转运成本不用二次的 product 形式（改用 slot，目标只有线性项，可逐列修改），
+// 列生成堆场（colgen）改用 blocks，不使用 --lazy-overlap 与目标值截断；这些调整在构造时输出到 log。
+// 非线程安全：同一个 Rescheduler 只能由一个线程使用（其 IloEnv 也归它所有）。
+
+// 调度事件
+enum ScheduleEventType {
+    EventArrival,    // 船舶 ship 的到达时间改为 time
+    EventNewShip,    // 新增船舶：source 算例中的第 sourceShip 艘船（time >= 0 时到达时间改为 time）
+    EventCancel,     // 取消船舶 ship（不能是已冻结的船）
+    EventBerthDown,  // 泊位 berth 在 [time, until) 不可用
+    EventClock       // 当前时刻推进到 time：此前已开始卸载的船舶冻结
+};
+
+struct ScheduleEvent {
+    ScheduleEventType type = EventClock;
+    int ship = -1;           // 稳定编号（EventArrival / EventCancel）
+    int berth = -1;          // EventBerthDown
+    double time = -1.0;
+    double until = -1.0;     // EventBerthDown
+    std::string source;      // EventNewShip：算例前缀（同 --input，维度须与当前算例相同）
+    int sourceShip = -1;     // EventNewShip：source 中的船舶下标
+};
+
+// 解析一行事件文本（逗号或空白分隔），无法识别时在 cerr 报告并返回 false：
+//   arrival,<船>,<时间> | new,<算例前缀>,<船>[,<到达时间>] | cancel,<船> | berth-down,<泊位>,<开始>,<结束> | now,<时间>
+bool parseScheduleEvent(const std::string& line, ScheduleEvent& event);
+// 事件的单行描述（与 parseScheduleEvent 的格式相同）
+std::string scheduleEventText(const ScheduleEvent& event);
+
+// 一次 resolve 的统计
+struct RescheduleReport {
+    int ships = 0;
+    int frozen = 0;             // 冻结的船舶数
+    int events = 0;             // 自上一次 resolve 以来应用的事件数
+    long colsAdded = 0, colsRemoved = 0, boundsChanged = 0, objChanged = 0;
+    long rowsAdded = 0, rowsRemoved = 0, rowsKept = 0;
+    long cols = 0, rows = 0;
+    double syncMs = 0.0;        // 生成稀疏模型并同步到常驻模型的耗时
+    bool startComplete = false; // 初始解安排了全部船舶
+    double startObjective = 0.0;
+    double solveSeconds = 0.0;
+    std::string status;
+    double objective = 0.0, bound = 0.0, gap = 0.0;
+};
+
+class Rescheduler {
+public:
+    // opts 的调整见文件开头的说明；log 接收调整说明与事件错误以外的提示
+    Rescheduler(const ModelParams& params, const ModelOptions& opts, std::ostream& log);
+    ~Rescheduler();
+
+    // 应用一个事件（只修改算例与计划，模型在下一次 resolve 时同步），失败时在 cerr 报告并返回 false
+    bool apply(const ScheduleEvent& event);
+
+    // 同步模型并以修复后的计划为初始解求解（时间限制 timeLimit 秒）。
+    // callback 非空时以 contextMask 登记为通用回调（如 SolveTelemetry，其 PortModel 用 model()）。
+    // 有解时 sol 为新计划并返回 true；否则 sol 为修复后的计划（可能不完整），计划保持不变
+    bool resolve(double timeLimit, PortSolution& sol, RescheduleReport* report = 0,
+                 IloCplex::Callback::Function* callback = 0, CPXLONG contextMask = 0);
+
+    // 之后各次求解的 CPLEX 线程数（0 为 CPLEX 默认）
+    void setThreads(int threads) { opts_.threads = threads; }
+
+    const ModelParams& params() const { return params_; }
+    const ModelOptions& options() const { return opts_; }
+    const PortSolution& plan() const { return plan_; }
+    // 当前算例中第 s 艘船的稳定编号；stable 编号对应的下标（不存在时为 -1）
+    const std::vector<int>& shipIds() const { return ids_; }
+    int shipIndex(int id) const;
+    // 已冻结：上一次计划中已在 now 之前开始卸载
+    bool frozen(int s) const;
+    double now() const { return now_; }
+    // 常驻模型（columns / index 为最近一次同步的结果，求解回调可用它读出解）
+    const PortModel& model() const { return pm_; }
+
+private:
+    struct Outage {
+        int berth;
+        double from, until;
+    };
+    struct LiveColumn {
+        IloNumVar var;
+        double lb, ub, obj;
+    };
+
+    // 按当前算例、冻结决策与停用时段生成目标模型；startValue[c] 为 start 给出的列值（没有时为 -1）
+    void buildTarget(const PortSolution& start, SparseModel& sm, PortIndex& idx, std::vector<std::string>& names,
+                     std::vector<double>& startValue);
+    void sync(const SparseModel& sm, const std::vector<std::string>& names, RescheduleReport& rep);
+    void repairPlan(PortSolution& start) const;
+    double outageFreeStart(int b, double start, double duration) const;
+
+    IloEnv env_;
+    std::ostream& log_;
+    ModelOptions opts_;
+    ModelParams params_;
+    std::vector<int> ids_;
+    int nextId_ = 0;
+    PortSolution plan_;              // 与 params_ 对齐，未安排的船 berth 为 -1
+    double now_ = 0.0;
+    std::vector<Outage> outages_;
+    int pendingEvents_ = 0;
+    std::map<std::string, ModelParams> sources_;   // 新增船舶的来源算例（只读一次）
+
+    PortModel pm_;
+    IloCplex cplex_;
+    bool extracted_ = false;
+    std::unordered_map<std::string, LiveColumn> liveCols_;
+    std::unordered_map<std::string, IloRange> liveRows_;
+};
+
+#endif // RESCHEDULE_H
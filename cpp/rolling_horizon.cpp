@@ -0,0 +1,206 @@
+#include "rolling_horizon.h"
+#include "heuristic.h"
+#include "yard_colgen.h"
+#include <ilcplex/ilocplex.h>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+ModelParams selectShips(const ModelParams& params, const vector<int>& ships) {
+    const int n = static_cast<int>(ships.size());
+    const int B = params.numBerths, K = params.numShipK, R = params.numRows;
+    ModelParams sub;
+    sub.numBerths = params.numBerths;
+    sub.numRows = params.numRows;
+    sub.numSlotsPerRow = params.numSlotsPerRow;
+    sub.numShips = n;
+    sub.planningHorizon = params.planningHorizon;
+    sub.numShipK = params.numShipK;
+    sub.transshipmentCost = params.transshipmentCost;
+    sub.width = params.width;
+    sub.relativeHeight = params.relativeHeight;
+    sub.alpha = params.alpha;
+    sub.beta = params.beta;
+    sub.unloadingSpeed.assign(n, B, K);
+    sub.storageCost.assign(n, K, R);
+    for (int i = 0; i < n; ++i) {
+        const int s = ships[i];
+        for (int b = 0; b < B; ++b) copy(params.unloadingSpeed.row(s, b), params.unloadingSpeed.row(s, b) + K, sub.unloadingSpeed.row(i, b));
+        for (int k = 0; k < K; ++k) copy(params.storageCost.row(s, k), params.storageCost.row(s, k) + R, sub.storageCost.row(i, k));
+        sub.arrivalTime.push_back(params.arrivalTime[s]);
+        sub.cargoWeight.push_back(params.cargoWeight[s]);
+        sub.requiredSlots.push_back(params.requiredSlots[s]);
+        if (s < static_cast<int>(params.cargoDensity.size())) sub.cargoDensity.push_back(params.cargoDensity[s]);
+        if (s < static_cast<int>(params.maxResponseAngle.size())) sub.maxResponseAngle.push_back(params.maxResponseAngle[s]);
+    }
+    return sub;
+}
+
+// 已占用槽上的堆场变量上界置 0
+static void blockOccupiedSlots(const ModelParams& sub, const PortModel& pm, const vector<char>& occupied) {
+    const int R = sub.numRows, V = sub.numSlotsPerRow;
+    if (pm.opts.yard == YardSlots) {
+        for (int s = 0; s < sub.numShips; ++s) {
+            for (int k = 0; k < sub.numShipK; ++k) {
+                for (int r = 0; r < R; ++r) {
+                    for (int v = 0; v < V; ++v) {
+                        if (occupied[r * V + v]) pm.x[s][k][r][v].setUB(0);
+                    }
+                }
+            }
+        }
+    } else if (pm.opts.yard != YardNone) {
+        // busy[r*(V+1) + v] = 行 r 中槽 0..v-1 的已占用数，块 [j, j+n) 内有占用当且仅当差值 > 0
+        vector<int> busy(static_cast<size_t>(R) * (V + 1), 0);
+        for (int r = 0; r < R; ++r) {
+            for (int v = 0; v < V; ++v) busy[r * (V + 1) + v + 1] = busy[r * (V + 1) + v] + (occupied[r * V + v] ? 1 : 0);
+        }
+        for (int s = 0; s < sub.numShips; ++s) {
+            for (int k = 0; k < sub.numShipK; ++k) {
+                const int n = sub.requiredSlots[s][k];
+                for (int r = 0; r < R; ++r) {
+                    const int* row = &busy[r * (V + 1)];
+                    for (int j = 0; j < pm.place[s][k][r].getSize(); ++j) {
+                        if (pm.place[s][k][r][j].getImpl() == 0) continue;   // 不在列池中
+                        if (row[j + n] - row[j] > 0) pm.place[s][k][r][j].setUB(0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 求解一个窗口；berthFree / occupied 为已提交的决策
+static bool solveWindow(const ModelParams& sub, const ModelOptions& opts, const vector<double>& berthFree,
+                        const vector<char>& occupied, PortSolution& sol, RollingWindowReport& wr) {
+    auto t0 = chrono::steady_clock::now();
+    PortSolution start;
+    bool startInHorizon = false;
+    bool haveStart = greedySolution(sub, start, berthFree, occupied, &startInHorizon);
+    bool solved = false;
+
+    IloEnv env;
+    try {
+        YardColumnPool pool;
+        if (opts.yard == YardColumns) {
+            vector<vector<int>> scenarios = defaultBerthScenarios(sub);
+            if (haveStart) scenarios.push_back(start.berth);
+            YardColGenOptions cg;
+            cg.threads = opts.threads;
+            generateYardColumns(env, sub, scenarios, cg, pool);
+            if (haveStart) {
+                for (int s = 0; s < sub.numShips; ++s) {
+                    for (int k = 0; k < sub.numShipK; ++k) {
+                        if (!start.slots[s][k].empty()) pool.add(s, k, start.row[s][k], start.slots[s][k].front());
+                    }
+                }
+            }
+        }
+        PortModel pm;
+        buildPortModel(env, sub, opts, pm, opts.yard == YardColumns ? &pool : 0);
+        // 泊位 b 在 berthFree[b] 之前不可用
+        for (int s = 0; s < sub.numShips; ++s) {
+            IloExpr release(env);
+            for (int b = 0; b < sub.numBerths; ++b) {
+                if (berthFree[b] > 0) release += berthFree[b] * pm.z[s][b];
+            }
+            pm.model.add(pm.e[s] - release >= 0);
+            release.end();
+        }
+        blockOccupiedSlots(sub, pm, occupied);
+
+        IloCplex cplex(pm.model);
+        cplex.setOut(env.getNullStream());
+        cplex.setParam(IloCplex::TiLim, opts.timeLimit);
+        if (opts.threads > 0) cplex.setParam(IloCplex::Threads, opts.threads);
+        if (haveStart && opts.mipStart) {
+            addMIPStartFromSolution(cplex, sub, pm, start, "greedy",
+                                    startInHorizon ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair);
+        }
+        wr.rows = cplex.getNrows();
+        wr.cols = cplex.getNcols();
+        solved = cplex.solve();
+        ostringstream st;
+        st << cplex.getStatus();
+        wr.status = st.str();
+        if (solved) {
+            extractSolution(cplex, sub, pm, sol);
+            wr.objective = cplex.getObjValue();
+        }
+        cplex.end();
+    } catch (IloException& ex) {
+        cerr << "[滚动时域] CPLEX 异常: " << ex << endl;
+        wr.status = "Exception";
+        solved = false;
+    }
+    env.end();
+
+    // 超过规划期的贪心解不可行，不能提交
+    if (!solved && haveStart && startInHorizon) {
+        sol = start;
+        wr.fallback = true;
+        wr.objective = weightedObjective(sub, evaluateShipCosts(sub, sol));
+    }
+    wr.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    return solved || (haveStart && startInHorizon);
+}
+
+bool solveRollingHorizon(const ModelParams& params, const ModelOptions& opts, PortSolution& sol,
+                         RollingReport* report) {
+    auto t0 = chrono::steady_clock::now();
+    const int B = params.numBerths, V = params.numSlotsPerRow;
+    RollingReport rep;
+    initSolution(sol, params);
+    vector<int> order = shipsByArrival(params);
+    vector<double> berthFree(B, 0.0);
+    vector<char> occupied(static_cast<size_t>(params.numRows) * V, 0);
+    bool ok = true;
+
+    size_t next = 0;   // order 中第一艘未提交的船
+    while (next < order.size()) {
+        RollingWindowReport wr;
+        wr.from = params.arrivalTime[order[next]];
+        wr.to = wr.from + opts.rollingWindow;
+        const double commitTo = wr.from + opts.rollingStep;
+        vector<int> active;
+        for (size_t i = next; i < order.size() && params.arrivalTime[order[i]] < wr.to; ++i) active.push_back(order[i]);
+        const bool last = next + active.size() == order.size();
+        wr.ships = static_cast<int>(active.size());
+
+        ModelParams sub = selectShips(params, active);
+        PortSolution subSol;
+        if (!solveWindow(sub, opts, berthFree, occupied, subSol, wr)) {
+            cerr << "[滚动时域] 窗口 [" << wr.from << ", " << wr.to << ") 无可行解" << endl;
+            ok = false;
+            break;
+        }
+
+        // 提交：active 按到达时间排序，提交的是其前缀（至少包含到达时间为 from 的第一艘）
+        for (size_t i = 0; i < active.size(); ++i) {
+            if (!last && params.arrivalTime[active[i]] >= commitTo) break;
+            const int s = active[i], b = subSol.berth[i];
+            sol.berth[s] = b;
+            sol.e[s] = subSol.e[i];
+            sol.e_sk[s] = subSol.e_sk[i];
+            sol.row[s] = subSol.row[i];
+            sol.slots[s] = subSol.slots[i];
+            berthFree[b] = max(berthFree[b], sol.e[s] + berthProcessingTime(params, s, b));
+            for (int k = 0; k < params.numShipK; ++k) {
+                for (size_t j = 0; j < sol.slots[s][k].size(); ++j) occupied[sol.row[s][k] * V + sol.slots[s][k][j]] = 1;
+            }
+            ++wr.committed;
+        }
+        next += wr.committed;
+        rep.windows.push_back(wr);
+        cout << "[滚动时域] 窗口 [" << wr.from << ", " << wr.to << ") | 船舶 " << wr.ships << " 提交 " << wr.committed
+             << " | 行 " << wr.rows << " 列 " << wr.cols << " | " << wr.status << (wr.fallback ? "（使用贪心解）" : "")
+             << " 目标 " << wr.objective << " | " << wr.seconds << " s" << endl;
+    }
+
+    rep.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (report) *report = rep;
+    return ok;
+}
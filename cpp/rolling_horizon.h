@@ -0,0 +1,46 @@
+#ifndef ROLLING_HORIZON_H
+#define ROLLING_HORIZON_H
+
+#include <vector>
+#include <string>
+#include "modelParam.h"
+#include "port_model.h"
+#include "port_solution.h"
+
+// 滚动时域求解（--method=rolling --window=小时 --step=小时）
+//
+// 船舶按到达时间排序。每个窗口从第一艘未提交船舶的到达时间 t 开始，包含到达时间在
+// [t, t + window) 内的未提交船舶，用 buildPortModel 建立只含这些船的子模型并求解；
+// 之后提交到达时间早于 t + step 的船舶（最后一个窗口全部提交），其余船舶留到下一窗口重新决策。
+// 已提交的决策以界和可用性的形式带入后续窗口：
+//   泊位：泊位 b 在已提交船舶的最晚完工时间 F_b 之前不可用，e_s >= sum_b F_b z_sb
+//   堆场：已提交船舶占用的槽在模型中不可用（覆盖这些槽的 x / place 变量上界置 0）
+// 每个窗口使用独立的 IloEnv，求解后释放，内存与单窗口耗时只取决于窗口内的船舶数。
+// 窗口 MIP 没有可行解时退回该窗口的贪心解（heuristic.h，同样遵守冻结的决策）；
+// 贪心解有船超过规划期时不可行，该窗口失败。
+
+struct RollingWindowReport {
+    double from = 0.0, to = 0.0;   // 窗口的到达时间范围 [from, to)
+    int ships = 0;                 // 窗口内的船舶数
+    int committed = 0;             // 本窗口提交的船舶数
+    long rows = 0, cols = 0;
+    double seconds = 0.0;
+    double objective = 0.0;        // 窗口子问题的目标值
+    std::string status;
+    bool fallback = false;         // 使用了贪心解
+};
+
+struct RollingReport {
+    std::vector<RollingWindowReport> windows;
+    double seconds = 0.0;
+};
+
+// 只含 ships 中船舶（按给定顺序重新编号为 0..n-1）的算例，泊位与堆场参数不变
+ModelParams selectShips(const ModelParams& params, const std::vector<int>& ships);
+
+// 按 opts.rollingWindow / opts.rollingStep 滚动求解，每个窗口的时间限制为 opts.timeLimit
+// 某个窗口既无 MIP 解也无贪心解时返回 false
+bool solveRollingHorizon(const ModelParams& params, const ModelOptions& opts, PortSolution& sol,
+                         RollingReport* report = 0);
+
+#endif // ROLLING_HORIZON_H
@@ -1,8 +1,25 @@
-g++ -std=c++11 \
+g++ -std=c++11 -DPORT_HAVE_ZLIB \
 -I/Applications/CPLEX_Studio2211/cplex/include \
 -I/Applications/CPLEX_Studio2211/concert/include \
 -L/Applications/CPLEX_Studio2211/cplex/lib/arm64_osx/static_pic \
 -L/Applications/CPLEX_Studio2211/concert/lib/arm64_osx/static_pic \
-verify.cpp -o verify \
--lilocplex -lcplex -lconcert -lm -lpthread -ldl
-##
\ No newline at end of file
+verify.cpp solve_instance.cpp model_size.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp solve_progress.cpp solve_telemetry.cpp yard_colgen.cpp yard_pool.cpp benders.cpp rolling_horizon.cpp csv_loader.cpp binary_instance.cpp instance_cache.cpp -o verify \
+-lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+##
+##g++ -std=c++11 -O2 bench_tensor.cpp -o bench_tensor
+## 转运成本建模方式基准（product / slot / berth），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... bench_objective.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp yard_colgen.cpp yard_pool.cpp csv_loader.cpp binary_instance.cpp -o bench_objective -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+## 贪心初始解基准（冷启动 vs 带初始解），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... bench_mipstart.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp solve_progress.cpp yard_colgen.cpp yard_pool.cpp csv_loader.cpp binary_instance.cpp -o bench_mipstart -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+## ALNS 求解器（不依赖 CPLEX）:
+## g++ -std=c++11 -O2 alns_main.cpp alns.cpp heuristic.cpp berth_sequencing.cpp port_solution.cpp csv_loader.cpp binary_instance.cpp -o alns -lpthread
+## 批量并行求解 data/ 下所有算例（工作窃取线程池），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... batch_runner.cpp work_pool.cpp solve_instance.cpp model_size.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp solve_progress.cpp solve_telemetry.cpp yard_colgen.cpp yard_pool.cpp benders.cpp rolling_horizon.cpp csv_loader.cpp binary_instance.cpp instance_cache.cpp -o batch_runner -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+## 基准测试（分阶段计时 + 基线比较，配置见 bench_harness.cfg），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... bench_harness.cpp phase_timer.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp yard_colgen.cpp yard_pool.cpp csv_loader.cpp binary_instance.cpp -o bench_harness -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+## 不依赖 CPLEX 的求解程序（HiGHS 后端，需已安装 HiGHS；不加 -DPORT_HAVE_HIGHS 时只能 --build-only）:
+## g++ -std=c++11 -O2 -DPORT_HAVE_HIGHS -I<HiGHS 安装目录>/include/highs port_solve.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp yard_pool.cpp highs_backend.cpp model_writer.cpp heuristic.cpp berth_sequencing.cpp port_solution.cpp phase_timer.cpp csv_loader.cpp binary_instance.cpp instance_cache.cpp -o port_solve -L<HiGHS 安装目录>/lib -lhighs -lpthread （加 -DPORT_HAVE_ZLIB ... -lz 可导出 .gz）
+## 事件驱动的增量重排（事件文件格式见 reschedule.h / replan.cpp），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... replan.cpp reschedule.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp solve_progress.cpp solve_telemetry.cpp yard_colgen.cpp yard_pool.cpp rolling_horizon.cpp csv_loader.cpp binary_instance.cpp -o replan -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
+## 常驻求解服务（Unix 域套接字，协议见 port_daemon.cpp），链接方式同上:
+## g++ -std=c++11 ...同上 -I/-L... port_daemon.cpp reschedule.cpp port_model.cpp lazy_rows.cpp port_ir.cpp model_bounds.cpp sparse_model.cpp model_options.cpp model_writer.cpp phase_timer.cpp port_solution.cpp heuristic.cpp berth_sequencing.cpp yard_colgen.cpp yard_pool.cpp rolling_horizon.cpp csv_loader.cpp binary_instance.cpp -o port_daemon -lilocplex -lcplex -lconcert -lz -lm -lpthread -ldl
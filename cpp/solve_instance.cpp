@@ -0,0 +1,364 @@
+#include "solve_instance.h"
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include "modelParam.h"
+#include "binary_instance.h"
+#include "port_solution.h"
+#include "benders.h"
+#include "heuristic.h"
+#include "yard_colgen.h"
+#include "solve_progress.h"
+#include "solve_telemetry.h"
+#include "lazy_rows.h"
+#include "rolling_horizon.h"
+#include "model_size.h"
+#include "phase_timer.h"
+#include "model_bounds.h"
+#include "instance_cache.h"
+#include "model_writer.h"
+
+using namespace std;
+
+// 输出解并写 CSV，记录目标值
+static bool finishSolution(const ModelParams& params, const PortSolution& sol, const string& outDir,
+                           ostream& log, InstanceResult& res) {
+    res.objective = weightedObjective(params, evaluateShipCosts(params, sol));
+    printSolution(log, params, sol);
+    if (!writeSolutionCSV(params, sol, outDir)) {
+        log << "写输出文件时出错: " << outDir << endl;
+        return false;
+    }
+    return true;
+}
+
+// 把本次的解与最佳界并入缓存条目；缓存中已有更好的界时改用它报告 gap
+static void cacheResult(const InstanceCache& cache, uint64_t fingerprint, const ModelParams& params,
+                        const PortSolution* sol, bool haveBound, ostream& log, InstanceResult& res) {
+    CachedResult known;
+    if (cache.loadResult(fingerprint, params, known) && known.haveBound && (!haveBound || known.bound > res.bound)) {
+        res.bound = known.bound;
+        haveBound = true;
+        if (sol) {
+            res.gap = fabs(res.objective - res.bound) / (1e-10 + fabs(res.objective));
+            log << "缓存中的最佳界更好: " << res.bound << "，与最优解差距(MIP gap): " << (res.gap * 100.0) << " %" << endl;
+        }
+    }
+    CachedResult cr;
+    cr.haveSolution = sol != 0;
+    if (sol) cr.solution = *sol;
+    cr.objective = res.objective;
+    cr.haveBound = haveBound;
+    cr.bound = res.bound;
+    if (!cache.storeResult(fingerprint, params, cr)) log << "[缓存] 无法写入解" << endl;
+}
+
+bool solveInstance(const string& base, const string& outDir, const ModelOptions& requested,
+                   ostream& log, InstanceResult* result) {
+    ModelOptions opts = requested;   // 内存保护可能改写建模形式或求解方式
+    auto wallStart = chrono::steady_clock::now();
+    InstanceResult res;
+    res.instance = base;
+    res.outDir = outDir;
+    res.threads = opts.threads;
+
+    //初始化CPLEX环境
+    IloEnv env;
+    env.setOut(log);
+    env.setWarning(log);
+    try {
+        // 1. 读取模型参数：优先使用不早于 CSV 的二进制算例（data_init_runner --csv2bin 生成），
+        //    否则从 data/ 下的 CSV 文件读取（见 csv_loader.cpp）
+        //    --cache 时算例文件未变化则直接读入缓存条目中的参数（见 instance_cache.h）
+        ModelParams params;
+        auto loadStart = chrono::steady_clock::now();
+        bool loadedBinary = false;
+        InstanceCache cache(opts.cacheDir);
+        uint64_t cachedFingerprint = 0;
+        const bool cachedParams = cache.findParams(base, requested, params, cachedFingerprint);
+        if (!cachedParams && !loadParamsAuto(base, params, &loadedBinary)) {
+            log << "停止求解: " << base << endl;
+            res.status = "LoadError";
+            env.end();
+            if (result) *result = res;
+            return false;
+        }
+        res.ships = params.numShips;
+        double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - loadStart).count();
+        log << "[DEBUG] 参数加载(" << (cachedParams ? "缓存" : loadedBinary ? "二进制" : "CSV") << "): 耗时 " << loadMs << " ms" << endl;
+        // Diagnostic print: verify that params were loaded correctly
+        log << "[DEBUG] Loaded params: numBerths=" << params.numBerths
+            << " numRows=" << params.numRows
+            << " numSlotsPerRow=" << params.numSlotsPerRow
+            << " numShips=" << params.numShips
+            << " numShipK=" << params.numShipK
+            << " planningHorizon=" << params.planningHorizon << endl;
+        log << "[DEBUG] arrivalTime.size=" << params.arrivalTime.size()
+            << " cargoWeight.size=" << params.cargoWeight.size()
+            << " unloadingSpeed.size=" << params.unloadingSpeed.dim(0)
+            << " transshipmentCost.size=" << params.transshipmentCost.dim(0)
+            << " storageCost.size=" << params.storageCost.dim(0) << endl;
+
+        // 预计内存超过 --mem-limit 时拒绝或改用更省内存的形式（见 model_size.h）
+        if (!applyMemoryGuard(params, opts, log)) {
+            res.status = "MemoryLimit";
+            env.end();
+            if (result) *result = res;
+            return false;
+        }
+
+        // 延迟加入不重叠约束只用于单一 MIP，Benders 主问题与滚动时域的子问题仍包含全部约束
+        if (opts.lazyOverlap && opts.method != MethodMonolithic) {
+            log << "--lazy-overlap 只用于 --method=mip，忽略" << endl;
+            opts.lazyOverlap = false;
+        }
+
+        // Benders 分解：主问题与子问题都在 benders.cpp 中构建和求解
+        if (opts.method == MethodBenders) {
+            PortSolution sol;
+            BendersReport rep;
+            res.ok = solveBenders(env, params, opts, sol, &rep);
+            log << "Benders: 迭代 " << rep.iterations << " 次, 割 " << rep.cuts << " 条, 子问题 " << rep.subproblems
+                << " 个, 下界 " << rep.lowerBound << ", 上界 " << rep.upperBound
+                << ", 耗时 " << rep.seconds << " 秒" << endl;
+            res.status = res.ok ? "Benders" : "BendersFailed";
+            if (res.ok) {
+                log << "目标函数值: " << weightedObjective(params, evaluateShipCosts(params, sol)) << endl;
+                res.ok = finishSolution(params, sol, outDir, log, res);
+                res.bound = rep.lowerBound;
+                res.gap = fabs(res.objective - rep.lowerBound) / (1e-10 + fabs(res.objective));
+            }
+        // 滚动时域：每个窗口单独建模求解（见 rolling_horizon.cpp）
+        } else if (opts.method == MethodRolling) {
+            PortSolution sol;
+            RollingReport rep;
+            res.ok = solveRollingHorizon(params, opts, sol, &rep);
+            log << "滚动时域: 窗口 " << rep.windows.size() << " 个（窗口 " << opts.rollingWindow << " h, 步长 "
+                << opts.rollingStep << " h）, 耗时 " << rep.seconds << " 秒" << endl;
+            res.status = res.ok ? "Rolling" : "RollingFailed";
+            if (res.ok) {
+                log << "目标函数值: " << weightedObjective(params, evaluateShipCosts(params, sol)) << endl;
+                res.ok = finishSolution(params, sol, outDir, log, res);
+            }
+        } else {
+            // 2. 贪心启发式（见 heuristic.cpp），作为 MIP 初始解
+            PortSolution start;
+            bool haveStart = false, startFeasible = false;
+            double greedyObjective = 0;
+            if (opts.mipStart) {
+                auto heurStart = chrono::steady_clock::now();
+                haveStart = greedySolution(params, start, &startFeasible);
+                double heurMs = chrono::duration<double, milli>(chrono::steady_clock::now() - heurStart).count();
+                if (haveStart) {
+                    greedyObjective = weightedObjective(params, evaluateShipCosts(params, start));
+                    log << "贪心启发式: 目标函数值 " << greedyObjective << ", 耗时 " << heurMs << " ms" << endl;
+                    // 可行时目标值同时作为截断，收紧各船的最晚开始时间与船对关系（见 model_bounds.h）；
+                    // 超过规划期的解不是上界，只作为需要修复的初始解
+                    if (startFeasible) opts.objectiveCutoff = greedyObjective;
+                    else log << "贪心解超过规划期，不作为目标值截断，以 MIPStartRepair 加入" << endl;
+                } else {
+                    log << "贪心启发式未找到可行解，不使用初始解" << endl;
+                }
+            }
+
+            // 列生成：除默认情景外加入启发式的泊位分配，并把启发式的放置放入列池，使初始解可表示
+            YardColumnPool pool;
+            if (opts.yard == YardColumns) {
+                vector<vector<int>> scenarios = defaultBerthScenarios(params);
+                if (haveStart) scenarios.push_back(start.berth);
+                YardColGenOptions cg;
+                cg.threads = opts.threads;
+                generateYardColumns(env, params, scenarios, cg, pool);
+                if (haveStart) {
+                    for (int s = 0; s < params.numShips; ++s) {
+                        for (int k = 0; k < params.numShipK; ++k) {
+                            if (!start.slots[s][k].empty()) pool.add(s, k, start.row[s][k], start.slots[s][k].front());
+                        }
+                    }
+                }
+            }
+
+            // --cache：按指纹读入已建好的稀疏模型与已知最好的解；列池不缓存，YardColumns 不使用。
+            // 内存保护改写了建模形式时也不使用（来源记录按命令行选项登记）
+            const bool useCache = cache.enabled() && opts.yard != YardColumns && formulationKey(opts) == formulationKey(requested);
+            uint64_t fingerprint = 0;
+            if (useCache) {
+                fingerprint = instanceFingerprint(params, opts);
+                if (!cachedParams || cachedFingerprint != fingerprint) cache.storeParams(base, requested, params, fingerprint);
+                CachedResult known;
+                if (cache.loadResult(fingerprint, params, known) && known.haveSolution &&
+                    (!haveStart || !startFeasible || known.objective < greedyObjective - 1e-9)) {
+                    // 截断仍取贪心的目标值，与缓存的模型一致；更好的解满足由它推出的界
+                    log << "[缓存] 使用已知最好的解作为初始解: 目标函数值 " << known.objective << endl;
+                    start = known.solution;
+                    haveStart = opts.mipStart;
+                    startFeasible = true;
+                }
+            } else if (cache.enabled()) {
+                log << "[缓存] 当前建模形式不使用缓存（" << formulationKey(opts) << "）" << endl;
+            }
+
+            // 3-6. 定义决策变量、目标函数与约束（见 port_model.cpp），按约束族记录耗时与内存
+            ModelSize estimate = estimateModelSize(params, opts);
+            PhaseProfile buildProfile;
+            PortModel pm;
+            SparseModel sm;   // 加载到 CPLEX 的模型，--export 与不可行时的导出都直接写它
+            if (useCache) {
+                double cutoff = 0;
+                PhaseTimer cacheTimer(&buildProfile, "build.");
+                cacheTimer.begin("cache");
+                if (cache.loadModel(fingerprint, sm, pm.index, pm.lazyRows, cutoff) && cutoff == opts.objectiveCutoff) {
+                    cacheTimer.end();
+                    log << "[缓存] 命中 " << opts.cacheDir << "，跳过建模: 变量 " << sm.numCols() << " 约束 " << sm.numRows() << endl;
+                } else {
+                    cacheTimer.end();
+                    sm = SparseModel();
+                    pm.index = PortIndex();
+                    pm.lazyRows = SparseModel();
+                    buildPortIR(params, opts, sm, pm.index, 0, &buildProfile, &pm.lazyRows);
+                    if (!cache.storeModel(fingerprint, sm, pm.index, pm.lazyRows, opts.objectiveCutoff)) log << "[缓存] 无法写入模型" << endl;
+                }
+                pm.index.opts = opts;
+                loadPortModel(env, params, opts, sm, pm, &buildProfile);
+            } else {
+                // 列生成已在上面完成，这里与 buildPortModel 相同地建模并加载
+                buildPortIR(params, opts, sm, pm.index, opts.yard == YardColumns ? &pool : 0, &buildProfile, &pm.lazyRows);
+                loadPortModel(env, params, opts, sm, pm, &buildProfile);
+            }
+            IloModel model = pm.model;
+            // 导出的文件是完整模型：延迟约束行（--lazy-overlap）也并入 sm（CPLEX 中的模型已加载，不受影响）
+            if (pm.lazyRows.numRows() > 0) sm.appendRows(pm.lazyRows);
+            // --export：不经过 CPLEX 直接写出求解的稀疏模型（见 model_writer.h）
+            if (!opts.exportFile.empty()) {
+                PhaseTimer exportTimer(&buildProfile);
+                exportTimer.begin("export");
+                mkdir_p(outDir);
+                const string path = outDir + "/" + opts.exportFile;
+                if (writeModelFile(sm, portColumnNames(pm.index, sm.numCols()), path)) log << "模型已写入 " << path << endl;
+            }
+
+            // 7. 求解模型
+            PhaseTimer extractTimer(&buildProfile);
+            extractTimer.begin("extract");
+            IloCplex cplex(model);
+            extractTimer.end();
+            cplex.setOut(log);
+            cplex.setWarning(log);
+            log << "导出模型" << endl;
+            printSequencingSizeReport(log, params, opts.sequencing);
+            printBoundReport(log, params, opts);
+            printModelSizeReport(log, estimate, &buildProfile);
+            log << "实际内存: 当前 " << currentRssMB() << " MB, 峰值 " << peakRssMB() << " MB" << endl;
+            log << "转运成本形式: " << transshipmentFormName(opts.transshipment)
+                << " | 先后关系形式: " << sequencingFormName(opts.sequencing)
+                << " | 堆场形式: " << yardFormName(opts.yard)
+                << " | 模型规模: 变量 " << cplex.getNcols() << " 约束 " << cplex.getNrows()
+                << " 非零元 " << cplex.getNNZs() << endl;
+            cplex.setParam(IloCplex::TiLim, opts.timeLimit); // 默认时间限制为1小时
+            if (opts.threads > 0) cplex.setParam(IloCplex::Threads, opts.threads);
+            if (haveStart) {
+                addMIPStartFromSolution(cplex, params, pm, start, "greedy",
+                                        startFeasible ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair);
+            }
+            // 记录 incumbent / 最佳界的变化，用于报告首个可行解时间与早期 gap；
+            // 求解过程中同时写 progress.csv 与 incumbent 快照（--progress / --snapshots，见 solve_telemetry.h）
+            SolveProgress progress;
+            SolveTelemetry telemetry(params, pm, outDir, opts.progressInterval, opts.snapshots, &progress);
+            // --lazy-overlap：不重叠约束在整数候选解上按需加入（见 lazy_rows.h）
+            LazyRowCallback lazy(env, pm.lazyRows, pm.columns);
+            CallbackChain callbacks;
+            callbacks.add(&telemetry, IloCplex::Callback::Context::Id::GlobalProgress);
+            if (pm.lazyRows.numRows() > 0) callbacks.add(&lazy, IloCplex::Callback::Context::Id::Candidate);
+            cplex.use(&callbacks, callbacks.contextMask());
+
+            // 计时：使用 CPLEX 的计时（与当前 ClockType 一致：CPU/WallClock/Deterministic）
+            double t0 = cplex.getCplexTime();
+            telemetry.start();
+            bool solved = cplex.solve();
+            double solveSeconds = cplex.getCplexTime() - t0;
+            telemetry.finish();
+            if (pm.lazyRows.numRows() > 0) {
+                log << "延迟约束: 加入 " << lazy.rowsAdded() << " / " << lazy.poolRows() << " 行, 拒绝候选解 "
+                    << lazy.rejections() << " 次" << endl;
+            }
+            if (opts.snapshots) log << "incumbent 快照: " << telemetry.snapshotCount() << " 个（" << outDir << "/incumbents）" << endl;
+            if (progress.hasIncumbent()) {
+                log << "首个可行解: " << progress.firstIncumbentSeconds() << " 秒, 目标值 "
+                    << progress.firstIncumbentObjective() << " | gap@10s " << progress.gapAt(10) * 100.0
+                    << " % | gap@60s " << progress.gapAt(60) * 100.0 << " %" << endl;
+            }
+            ostringstream st;
+            st << cplex.getStatus();
+            res.status = st.str();
+
+            if (solved) {
+                log << "模型求解成功！" << endl;
+                log << "目标函数值: " << cplex.getObjValue() << endl;
+                log << "求解时间(按当前计时方式): " << solveSeconds << " 秒" << endl;
+                // 输出与最优解差距（MIP Gap）及最佳界
+                bool haveBound = false;
+                try {
+                    res.bound = cplex.getBestObjValue();
+                    res.gap = cplex.getMIPRelativeGap(); // 0 表示最优，>0 表示与最优的相对差距
+                    haveBound = true;
+                    log << "最佳界(best bound): " << res.bound << endl;
+                    log << "与最优解差距(MIP gap): " << (res.gap * 100.0) << " %" << endl;
+                } catch (...) {
+                    // 某些情况下（非MIP或无效调用）可能抛异常，忽略即可
+                }
+
+                // 读出与求解器无关的解，再统一输出到控制台与 CSV（见 port_solution.cpp）
+                PortSolution sol;
+                extractSolution(cplex, params, pm, sol);
+                res.ok = finishSolution(params, sol, outDir, log, res);
+                if (useCache) cacheResult(cache, fingerprint, params, &sol, haveBound, log, res);
+            } else {
+                log << "求解状态: " << cplex.getStatus() << endl;
+                log << "求解时间(按当前计时方式): " << solveSeconds << " 秒" << endl;
+                // 若有可用的界与gap，尽量输出用于诊断
+                bool haveBound = false;
+                try {
+                    res.bound = cplex.getBestObjValue();
+                    haveBound = true;
+                    log << "最佳界(best bound): " << res.bound << endl;
+                    res.gap = cplex.getMIPRelativeGap();
+                    log << "与最优解差距(MIP gap): " << (res.gap * 100.0) << " %" << endl;
+                } catch (...) {
+                    // 忽略
+                }
+                if (useCache && haveBound && fabs(res.bound) < SPARSE_INF) cacheResult(cache, fingerprint, params, 0, true, log, res);
+                log << "不可行解分析:" << endl;
+                // 导出到各自的输出目录，并行运行多个算例时互不覆盖
+                mkdir_p(outDir);
+                writeModelFile(sm, portColumnNames(pm.index, sm.numCols()), outDir + "/infeasible_model.lp");
+                // 尝试找到导致不可行的关键约束
+                IloNumVarArray vars(env);
+                IloRangeArray ranges(env);
+                // cplex.getInfeasible(vars, ranges);
+                log << "不可行变量数: " << vars.getSize() << endl;
+                log << "不可行约束数: " << ranges.getSize() << endl;
+            }
+
+            // 8. 释放资源
+            cplex.end();
+            model.end();
+        }
+    } catch (IloException& e) {
+        log << "CPLEX异常: " << e << endl;
+        res.status = "Exception";
+        res.ok = false;
+    } catch (...) {
+        log << "未知异常" << endl;
+        res.status = "Exception";
+        res.ok = false;
+    }
+    env.end();
+
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    if (result) *result = res;
+    return res.ok;
+}
@@ -0,0 +1,27 @@
+#ifndef SOLVE_INSTANCE_H
+#define SOLVE_INSTANCE_H
+
+#include <string>
+#include <ostream>
+#include "port_model.h"
+
+// 单个算例的完整求解流程（原 verify.cpp main）：读入参数 -> 按 opts.method 求解 -> 输出解与 CSV
+// verify 与 batch_runner 共用；所有日志（含 CPLEX 日志）写到 log，便于并行运行时每个算例单独记录
+struct InstanceResult {
+    std::string instance;      // 算例前缀
+    std::string outDir;
+    int ships = 0;
+    int threads = 0;           // 使用的 CPLEX 线程数（0 表示 CPLEX 默认）
+    bool ok = false;           // 得到可行解并写出 CSV
+    std::string status;
+    double objective = 0.0;    // weightedObjective(evaluateShipCosts(解))
+    double bound = 0.0;        // 最佳界（Benders 为下界；滚动时域没有全局界，为 0）
+    double gap = 0.0;
+    double seconds = 0.0;      // 含读入与建模的墙钟时间
+};
+
+// 求解 base（不带扩展名的算例前缀）并把结果写到 outDir
+bool solveInstance(const std::string& base, const std::string& outDir, const ModelOptions& opts,
+                   std::ostream& log, InstanceResult* result = 0);
+
+#endif // SOLVE_INSTANCE_H
@@ -0,0 +1,64 @@
+#include "solve_progress.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+static double relativeGap(double incumbent, double bound) {
+    if (std::isinf(incumbent)) return numeric_limits<double>::infinity();
+    return fabs(incumbent - bound) / (1e-10 + fabs(incumbent));
+}
+
+void SolveProgress::start() {
+    lock_guard<mutex> lock(mutex_);
+    trace_.clear();
+    t0_ = chrono::steady_clock::now();
+}
+
+void SolveProgress::invoke(const IloCplex::Callback::Context& context) {
+    if (!context.inGlobalProgress()) return;
+    Sample sample;
+    sample.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0_).count();
+    sample.incumbent = context.getIntInfo(IloCplex::Callback::Context::Info::Feasible)
+        ? context.getDoubleInfo(IloCplex::Callback::Context::Info::BestSolution)
+        : numeric_limits<double>::infinity();
+    sample.bound = context.getDoubleInfo(IloCplex::Callback::Context::Info::BestBound);
+    lock_guard<mutex> lock(mutex_);
+    // 只保留 incumbent 或界有变化的点
+    if (!trace_.empty() && trace_.back().incumbent == sample.incumbent && trace_.back().bound == sample.bound) return;
+    trace_.push_back(sample);
+}
+
+bool SolveProgress::hasIncumbent() const {
+    return !std::isinf(firstIncumbentSeconds());
+}
+
+double SolveProgress::firstIncumbentSeconds() const {
+    lock_guard<mutex> lock(mutex_);
+    for (size_t i = 0; i < trace_.size(); ++i) {
+        if (!std::isinf(trace_[i].incumbent)) return trace_[i].seconds;
+    }
+    return numeric_limits<double>::infinity();
+}
+
+double SolveProgress::firstIncumbentObjective() const {
+    lock_guard<mutex> lock(mutex_);
+    for (size_t i = 0; i < trace_.size(); ++i) {
+        if (!std::isinf(trace_[i].incumbent)) return trace_[i].incumbent;
+    }
+    return numeric_limits<double>::infinity();
+}
+
+double SolveProgress::gapAt(double seconds) const {
+    lock_guard<mutex> lock(mutex_);
+    double gap = numeric_limits<double>::infinity();
+    for (size_t i = 0; i < trace_.size() && trace_[i].seconds <= seconds; ++i) {
+        gap = relativeGap(trace_[i].incumbent, trace_[i].bound);
+    }
+    return gap;
+}
+
+vector<SolveProgress::Sample> SolveProgress::trace() const {
+    lock_guard<mutex> lock(mutex_);
+    return trace_;
+}
@@ -0,0 +1,37 @@
+#ifndef SOLVE_PROGRESS_H
+#define SOLVE_PROGRESS_H
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+// 记录 MIP 求解过程中 incumbent 与最佳界随时间的变化（GlobalProgress 回调）
+// 用法：cplex.use(&progress, IloCplex::Callback::Context::Id::GlobalProgress); progress.start(); cplex.solve();
+class SolveProgress : public IloCplex::Callback::Function {
+public:
+    struct Sample {
+        double seconds;      // 自 start() 起的墙钟时间
+        double incumbent;    // 无可行解时为 +inf
+        double bound;
+    };
+
+    // 清空记录并重新开始计时（在 solve() 之前调用）
+    void start();
+    void invoke(const IloCplex::Callback::Context& context);
+
+    bool hasIncumbent() const;
+    // 第一个可行解出现的时间与目标值（无可行解时为 +inf）
+    double firstIncumbentSeconds() const;
+    double firstIncumbentObjective() const;
+    // seconds 时刻的相对 gap |incumbent - bound| / (1e-10 + |incumbent|)，此前无可行解时为 +inf
+    double gapAt(double seconds) const;
+    std::vector<Sample> trace() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::chrono::steady_clock::time_point t0_ = std::chrono::steady_clock::now();
+    std::vector<Sample> trace_;
+};
+
+#endif // SOLVE_PROGRESS_H
@@ -0,0 +1,123 @@
+#include "solve_telemetry.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include "port_solution.h"
+#include "phase_timer.h"
+
+using namespace std;
+
+SolveTelemetry::SolveTelemetry(const ModelParams& params, const PortModel& pm, const string& outDir,
+                               double interval, bool snapshots, SolveProgress* trace)
+    : params_(params), pm_(pm), outDir_(outDir), interval_(interval), snapshots_(snapshots), trace_(trace) {}
+
+SolveTelemetry::~SolveTelemetry() {
+    if (progress_) fclose(progress_);
+    if (index_) fclose(index_);
+}
+
+bool SolveTelemetry::start() {
+    if (trace_) trace_->start();
+    lock_guard<mutex> lock(mutex_);
+    t0_ = chrono::steady_clock::now();
+    lastRowSeconds_ = 0;
+    lastNodes_ = 0;
+    lastFeasible_ = false;
+    haveIncumbent_ = false;
+    version_ = 0;
+    bool ok = true;
+    if (interval_ > 0) {
+        const string path = outDir_ + "/progress.csv";
+        if (mkdir_p(outDir_) && (progress_ = fopen(path.c_str(), "w")) != 0) {
+            fputs("seconds,nodes,incumbent,bound,gap,rss_mb\n", progress_);
+            fflush(progress_);
+        } else {
+            cerr << "无法创建进度文件: " << path << endl;
+            ok = false;
+        }
+    }
+    if (snapshots_) {
+        const string dir = outDir_ + "/incumbents";
+        const string path = dir + "/index.csv";
+        if (mkdir_p(dir) && (index_ = fopen(path.c_str(), "w")) != 0) {
+            fputs("version,seconds,nodes,objective\n", index_);
+            fflush(index_);
+        } else {
+            cerr << "无法创建 incumbent 快照目录: " << dir << endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void SolveTelemetry::invoke(const IloCplex::Callback::Context& context) {
+    if (trace_) trace_->invoke(context);
+    if (!context.inGlobalProgress()) return;
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0_).count();
+    const long long nodes = context.getLongInfo(IloCplex::Callback::Context::Info::NodeCount);
+    const bool feasible = context.getIntInfo(IloCplex::Callback::Context::Info::Feasible) != 0;
+    const double incumbent = feasible ? context.getDoubleInfo(IloCplex::Callback::Context::Info::BestSolution) : 0.0;
+    const double bound = context.getDoubleInfo(IloCplex::Callback::Context::Info::BestBound);
+
+    lock_guard<mutex> lock(mutex_);
+    // 只有改进超过相对 1e-9 才算新的 incumbent，避免同一个解重复写快照
+    const bool improved = feasible
+        && (!haveIncumbent_ || incumbent < bestIncumbent_ - 1e-9 * max(1.0, fabs(bestIncumbent_)));
+    if (improved) {
+        haveIncumbent_ = true;
+        bestIncumbent_ = incumbent;
+        if (index_) writeSnapshot(context, seconds, nodes, incumbent);
+    }
+    if (improved || (interval_ > 0 && seconds - lastRowSeconds_ >= interval_)) {
+        writeProgressRow(seconds, nodes, feasible, incumbent, bound);
+    }
+    lastNodes_ = nodes;
+    lastFeasible_ = feasible;
+    lastIncumbent_ = incumbent;
+    lastBound_ = bound;
+}
+
+void SolveTelemetry::finish() {
+    lock_guard<mutex> lock(mutex_);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0_).count();
+    writeProgressRow(seconds, lastNodes_, lastFeasible_, lastIncumbent_, lastBound_);
+    if (progress_) fclose(progress_);
+    if (index_) fclose(index_);
+    progress_ = index_ = 0;
+}
+
+int SolveTelemetry::snapshotCount() const {
+    lock_guard<mutex> lock(mutex_);
+    return version_;
+}
+
+void SolveTelemetry::writeProgressRow(double seconds, long long nodes, bool feasible, double incumbent, double bound) {
+    lastRowSeconds_ = seconds;
+    if (!progress_) return;
+    if (feasible) {
+        const double gap = fabs(incumbent - bound) / (1e-10 + fabs(incumbent));
+        fprintf(progress_, "%.3f,%lld,%.10g,%.10g,%.6g,%.1f\n", seconds, nodes, incumbent, bound, gap, currentRssMB());
+    } else {
+        fprintf(progress_, "%.3f,%lld,,%.10g,,%.1f\n", seconds, nodes, bound, currentRssMB());
+    }
+    fflush(progress_);   // 求解过程中可用 tail -f 查看
+}
+
+void SolveTelemetry::writeSnapshot(const IloCplex::Callback::Context& context, double seconds, long long nodes,
+                                   double objective) {
+    // loadSparseModel 把全部列加入了模型，pm_.columns 中的每个变量都已被抽取
+    IloNumArray vals(context.getEnv());
+    context.getIncumbentValues(vals, pm_.columns);
+    PortSolution sol;
+    extractPortSolution(params_, pm_.index, [&](int c) { return vals[c]; }, sol);
+    vals.end();
+
+    char name[16];
+    snprintf(name, sizeof(name), "%04d", version_ + 1);
+    const string dir = outDir_ + "/incumbents/" + name;
+    // 写入失败时不计入 index，下一个改进的 incumbent 再用同一个版本号
+    if (!writeSolutionCSV(params_, sol, dir)) return;
+    ++version_;
+    fprintf(index_, "%d,%.3f,%lld,%.10g\n", version_, seconds, nodes, objective);
+    fflush(index_);
+}
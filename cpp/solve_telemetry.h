@@ -0,0 +1,59 @@
+#ifndef SOLVE_TELEMETRY_H
+#define SOLVE_TELEMETRY_H
+
+#include <ilcplex/ilocplex.h>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include "port_model.h"
+#include "solve_progress.h"
+
+// 长时间 MIP 求解的实时记录（GlobalProgress 回调），求解过程中即可查看：
+//  - outDir/progress.csv：每隔 interval 秒及每次 incumbent 改进时追加一行
+//    seconds,nodes,incumbent,bound,gap,rss_mb（无可行解时 incumbent 与 gap 为空）
+//  - outDir/incumbents/NNNN/：每个改进的 incumbent 写出一套完整的结果 CSV（与最终输出相同，见 writeSolutionCSV），
+//    写完后才在 incumbents/index.csv 追加 version,seconds,nodes,objective 一行，因此 index 中列出的版本都是完整的
+// 每次 start() 重写 progress.csv 与 index.csv；以前运行留下的更大版本号目录不会删除，以 index.csv 为准。
+// 同一个 IloCplex 只能使用一个通用回调，需要 SolveProgress 的统计时把它作为 trace 传入，由本类转发。
+// 用法：cplex.use(&telemetry, IloCplex::Callback::Context::Id::GlobalProgress); telemetry.start(); cplex.solve(); telemetry.finish();
+class SolveTelemetry : public IloCplex::Callback::Function {
+public:
+    // interval <= 0 时不写 progress.csv；snapshots = false 时不写 incumbent 快照
+    SolveTelemetry(const ModelParams& params, const PortModel& pm, const std::string& outDir,
+                   double interval, bool snapshots, SolveProgress* trace = 0);
+    ~SolveTelemetry();
+
+    // 创建文件并开始计时（在 solve() 之前调用），无法创建时在 cerr 报告并返回 false（此时回调只转发给 trace）
+    bool start();
+    void invoke(const IloCplex::Callback::Context& context);
+    // 写最后一行进度并关闭文件（在 solve() 之后调用）
+    void finish();
+
+    int snapshotCount() const;
+
+private:
+    void writeProgressRow(double seconds, long long nodes, bool feasible, double incumbent, double bound);
+    void writeSnapshot(const IloCplex::Callback::Context& context, double seconds, long long nodes, double objective);
+
+    const ModelParams& params_;
+    const PortModel& pm_;
+    std::string outDir_;
+    double interval_;
+    bool snapshots_;
+    SolveProgress* trace_;
+
+    mutable std::mutex mutex_;
+    std::chrono::steady_clock::time_point t0_ = std::chrono::steady_clock::now();
+    FILE* progress_ = 0;
+    FILE* index_ = 0;
+    double lastRowSeconds_ = 0;
+    long long lastNodes_ = 0;
+    bool lastFeasible_ = false;
+    double lastIncumbent_ = 0, lastBound_ = 0;
+    bool haveIncumbent_ = false;
+    double bestIncumbent_ = 0;   // 已记录的最好 incumbent
+    int version_ = 0;
+};
+
+#endif // SOLVE_TELEMETRY_H
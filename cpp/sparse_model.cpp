@@ -0,0 +1,64 @@
+#include "sparse_model.h"
+#include <algorithm>
+
+using namespace std;
+
+int SparseModel::addColumns(int n, double lb, double ub, ColumnType type) {
+    const int first = numCols();
+    colLb.resize(first + n, lb);
+    colUb.resize(first + n, ub);
+    colType.resize(first + n, static_cast<char>(type));
+    obj.resize(first + n, 0.0);
+    return first;
+}
+
+void SparseModel::addQuadObjective(int i, int j, double coef) {
+    if (coef == 0) return;
+    QuadTerm t;
+    t.i = min(i, j);
+    t.j = max(i, j);
+    t.coef = coef;
+    quad.push_back(t);
+}
+
+void SparseModel::appendRows(const SparseModel& other) {
+    vector<int> family(other.rowFamilyNames.size());
+    for (size_t f = 0; f < family.size(); f++) family[f] = rowFamilyId(other.rowFamilyNames[f]);
+    const unsigned char saved = currentFamily_;
+    for (long i = 0; i < other.numRows(); i++) {
+        for (long p = other.rowStart[i]; p < other.rowStart[i + 1]; p++) addTerm(other.rowIndex[p], other.rowValue[p]);
+        useRowFamily(family[other.rowFamily[i]]);
+        addRow(other.rowLb[i], other.rowUb[i]);
+    }
+    currentFamily_ = saved;
+}
+
+int SparseModel::rowFamilyId(const string& name) {
+    for (size_t i = 0; i < rowFamilyNames.size(); i++) {
+        if (rowFamilyNames[i] == name) return static_cast<int>(i);
+    }
+    if (rowFamilyNames.size() >= 256) return 0;   // 超出时归入默认族 "c"
+    rowFamilyNames.push_back(name);
+    return static_cast<int>(rowFamilyNames.size()) - 1;
+}
+
+void SparseModel::reserve(int cols, long rows, long nonzeros) {
+    colLb.reserve(cols);
+    colUb.reserve(cols);
+    colType.reserve(cols);
+    obj.reserve(cols);
+    rowStart.reserve(rows + 1);
+    rowLb.reserve(rows);
+    rowUb.reserve(rows);
+    rowFamily.reserve(rows);
+    rowIndex.reserve(nonzeros);
+    rowValue.reserve(nonzeros);
+}
+
+double SparseModel::memoryMB() const {
+    double bytes = colLb.capacity() * sizeof(double) * 3 + colType.capacity()
+                 + rowStart.capacity() * sizeof(long) + (rowLb.capacity() + rowUb.capacity()) * sizeof(double) + rowFamily.capacity()
+                 + rowIndex.capacity() * sizeof(int) + rowValue.capacity() * sizeof(double)
+                 + quad.capacity() * sizeof(QuadTerm);
+    return bytes / (1024.0 * 1024.0);
+}
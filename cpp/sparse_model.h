@@ -0,0 +1,80 @@
+#ifndef SPARSE_MODEL_H
+#define SPARSE_MODEL_H
+
+#include <vector>
+#include <string>
+
+// 与求解器无关的稀疏 MIP 模型：列（上下界、类型、目标系数）、按行压缩（CSR）的约束矩阵、
+// 目标中的二次项与常数项。模型由 port_ir.h 一次性按列族/约束族顺序追加生成，
+// 再交给各求解器后端（Concert 见 port_model.h 的 loadSparseModel，HiGHS 见 highs_backend.h）。
+//
+// 约束行 i 为 rowLb[i] <= sum_{p in [rowStart[i], rowStart[i+1])} rowValue[p] * x[rowIndex[p]] <= rowUb[i]，
+// 同一行内列下标不重复；无穷大用 SPARSE_INF 表示（与 IloInfinity 相同）。
+// 每行属于一个约束族（rowFamily，族名在 rowFamilyNames 中），导出 LP/MPS 时行名为 <族名>_<族内序号>。
+const double SPARSE_INF = 1e20;
+
+enum ColumnType {
+    ColContinuous,
+    ColBinary
+};
+
+// 目标中的二次项 coef * x_i * x_j（i <= j）
+struct QuadTerm {
+    int i;
+    int j;
+    double coef;
+};
+
+struct SparseModel {
+    // 列
+    std::vector<double> colLb, colUb;
+    std::vector<char> colType;           // ColumnType
+    std::vector<double> obj;             // 线性目标系数（最小化）
+    // 行（CSR）
+    std::vector<long> rowStart = std::vector<long>(1, 0);
+    std::vector<int> rowIndex;
+    std::vector<double> rowValue;
+    std::vector<double> rowLb, rowUb;
+    std::vector<unsigned char> rowFamily;                          // 各行所属的约束族
+    std::vector<std::string> rowFamilyNames = std::vector<std::string>(1, "c");
+    // 目标中的二次项与常数项
+    std::vector<QuadTerm> quad;
+    double objConstant = 0.0;
+
+    int numCols() const { return static_cast<int>(colLb.size()); }
+    long numRows() const { return static_cast<long>(rowLb.size()); }
+    long numNonzeros() const { return static_cast<long>(rowIndex.size()); }
+
+    // 追加 n 个相同上下界与类型的列，返回第一个列的下标
+    int addColumns(int n, double lb, double ub, ColumnType type);
+    // 向当前行登记一项（系数为 0 时忽略）；addRow 以已登记的项结束当前行
+    void addTerm(int col, double coef) {
+        if (coef == 0) return;
+        rowIndex.push_back(col);
+        rowValue.push_back(coef);
+    }
+    void addRow(double lb, double ub) {
+        rowLb.push_back(lb);
+        rowUb.push_back(ub);
+        rowFamily.push_back(currentFamily_);
+        rowStart.push_back(static_cast<long>(rowIndex.size()));
+    }
+    // 约束族：rowFamilyId 返回族名对应的编号（没有时新建，最多 256 个），之后 addRow 的行都属于 useRowFamily 指定的族
+    int rowFamilyId(const std::string& name);
+    void useRowFamily(int id) { currentFamily_ = static_cast<unsigned char>(id); }
+    void beginRowFamily(const std::string& name) { useRowFamily(rowFamilyId(name)); }
+    void addObjective(int col, double coef) { obj[col] += coef; }
+    void addQuadObjective(int i, int j, double coef);
+    // 追加 other 的全部行（列下标指向本模型的列，other 可以没有列），约束族按族名合并
+    void appendRows(const SparseModel& other);
+
+    // 预留空间（按预计规模，可省略）
+    void reserve(int cols, long rows, long nonzeros);
+    // 内存占用估计（MB）
+    double memoryMB() const;
+
+private:
+    unsigned char currentFamily_ = 0;
+};
+
+#endif // SPARSE_MODEL_H
@@ -0,0 +1,129 @@
+#ifndef TENSOR_H
+#define TENSOR_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// 三维行主序（row-major）张量：一次分配连续内存，显式步长
+// 用于替代 vector<vector<vector<T>>>，访问 t(i,j,k) 只需一次乘加，不再逐层追指针
+// 下标 (i,j,k) 对应偏移 i*stride(0) + j*stride(1) + k，最内层维度连续
+//
+// 数据既可以由张量自己持有（assign），也可以是外部内存的视图（view，例如 mmap 的二进制算例），
+// 视图通过 keepAlive 保持底层映射存活；移动视图不复制数据。
+template <typename T>
+class Tensor3 {
+public:
+    typedef T value_type;
+
+    Tensor3() : ptr_(0), d0_(0), d1_(0), d2_(0), s0_(0), s1_(0) {}
+    Tensor3(int d0, int d1, int d2, T init = T()) : ptr_(0), d0_(0), d1_(0), d2_(0), s0_(0), s1_(0) {
+        assign(d0, d1, d2, init);
+    }
+    // 拷贝总是深拷贝为自有存储（值语义与数据来源无关，修改副本不会影响映射内存）
+    Tensor3(const Tensor3& o)
+        : data_(o.ptr_, o.ptr_ + o.size()), ptr_(data_.data()),
+          d0_(o.d0_), d1_(o.d1_), d2_(o.d2_), s0_(o.s0_), s1_(o.s1_) {}
+    Tensor3& operator=(const Tensor3& o) {
+        if (this != &o) {
+            data_.assign(o.ptr_, o.ptr_ + o.size());
+            keep_.reset();
+            ptr_ = data_.data();
+            d0_ = o.d0_; d1_ = o.d1_; d2_ = o.d2_; s0_ = o.s0_; s1_ = o.s1_;
+        }
+        return *this;
+    }
+    // 移动时 vector 的缓冲区随之转移，ptr_ 仍然有效
+    Tensor3(Tensor3&& o)
+        : data_(std::move(o.data_)), keep_(std::move(o.keep_)), ptr_(o.ptr_),
+          d0_(o.d0_), d1_(o.d1_), d2_(o.d2_), s0_(o.s0_), s1_(o.s1_) {
+        o.reset();
+    }
+    Tensor3& operator=(Tensor3&& o) {
+        if (this != &o) {
+            data_ = std::move(o.data_);
+            keep_ = std::move(o.keep_);
+            ptr_ = o.ptr_;
+            d0_ = o.d0_; d1_ = o.d1_; d2_ = o.d2_; s0_ = o.s0_; s1_ = o.s1_;
+            o.reset();
+        }
+        return *this;
+    }
+
+    // 重新设置形状并用 init 填充（会丢弃原有数据；视图会变为自有存储）
+    void assign(int d0, int d1, int d2, T init = T()) {
+        setShape(d0, d1, d2);
+        keep_.reset();
+        data_.assign(static_cast<size_t>(d0_) * s0_, init);
+        ptr_ = data_.data();
+    }
+
+    // 以外部连续内存 p 作为数据（不复制），keepAlive 负责保持该内存有效
+    static Tensor3 view(T* p, int d0, int d1, int d2, const std::shared_ptr<const void>& keepAlive) {
+        Tensor3 t;
+        t.setShape(d0, d1, d2);
+        t.ptr_ = p;
+        t.keep_ = keepAlive;
+        return t;
+    }
+
+    // 热循环中使用，不做越界检查（与 vector::operator[] 一致）
+    T& operator()(int i, int j, int k) { return ptr_[offset(i, j, k)]; }
+    const T& operator()(int i, int j, int k) const { return ptr_[offset(i, j, k)]; }
+
+    // 越界检查（CSV 读入等不可信下标时先调用）
+    bool inBounds(int i, int j, int k) const {
+        return i >= 0 && i < d0_ && j >= 0 && j < d1_ && k >= 0 && k < d2_;
+    }
+
+    size_t offset(int i, int j, int k) const {
+        return static_cast<size_t>(i) * s0_ + static_cast<size_t>(j) * s1_ + static_cast<size_t>(k);
+    }
+
+    // 最内层一段连续数据 t(i,j,0..dim(2)-1) 的首地址，便于内层循环直接走指针
+    T* row(int i, int j) { return ptr_ + offset(i, j, 0); }
+    const T* row(int i, int j) const { return ptr_ + offset(i, j, 0); }
+
+    int dim(int axis) const { return axis == 0 ? d0_ : (axis == 1 ? d1_ : d2_); }
+    size_t stride(int axis) const { return axis == 0 ? s0_ : (axis == 1 ? s1_ : 1); }
+    size_t size() const { return static_cast<size_t>(d0_) * s0_; }
+    bool empty() const { return size() == 0; }
+    bool isView() const { return static_cast<bool>(keep_); }
+
+    T* data() { return ptr_; }
+    const T* data() const { return ptr_; }
+
+private:
+    void reset() {
+        data_.clear();
+        keep_.reset();
+        ptr_ = 0;
+        d0_ = d1_ = d2_ = 0;
+        s0_ = s1_ = 0;
+    }
+
+    void setShape(int d0, int d1, int d2) {
+        d0_ = d0 < 0 ? 0 : d0;
+        d1_ = d1 < 0 ? 0 : d1;
+        d2_ = d2 < 0 ? 0 : d2;
+        s1_ = static_cast<size_t>(d2_);
+        s0_ = static_cast<size_t>(d1_) * s1_;
+    }
+
+    std::vector<T> data_;
+    std::shared_ptr<const void> keep_;
+    T* ptr_;
+    int d0_, d1_, d2_;
+    size_t s0_, s1_;
+};
+
+// 参数精度：默认 double；编译时定义 MODELPARAM_FLOAT 可改用 float 以减半内存和带宽
+#ifdef MODELPARAM_FLOAT
+typedef float param_t;
+#else
+typedef double param_t;
+#endif
+
+typedef Tensor3<param_t> ParamTensor3;
+
+#endif // TENSOR_H
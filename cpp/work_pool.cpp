@@ -0,0 +1,54 @@
+#include "work_pool.h"
+#include <thread>
+
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int workers) : steals_(0) {
+    if (workers < 1) workers = 1;
+    for (int i = 0; i < workers; ++i) queues_.push_back(unique_ptr<Queue>(new Queue()));
+}
+
+void WorkStealingPool::submit(const Task& task) {
+    Queue& q = *queues_[next_++ % queues_.size()];
+    lock_guard<mutex> g(q.lock);
+    q.tasks.push_back(task);
+}
+
+bool WorkStealingPool::popOwn(int worker, Task& task) {
+    Queue& q = *queues_[worker];
+    lock_guard<mutex> g(q.lock);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.front();
+    q.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(int worker, Task& task) {
+    const int n = workers();
+    for (int i = 1; i < n; ++i) {
+        Queue& q = *queues_[(worker + i) % n];
+        lock_guard<mutex> g(q.lock);
+        if (q.tasks.empty()) continue;
+        task = q.tasks.back();
+        q.tasks.pop_back();
+        ++steals_;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::work(int worker) {
+    // run() 期间不再有新任务，自己的队列和所有其它队列都为空时即可退出
+    Task task;
+    while (popOwn(worker, task) || steal(worker, task)) {
+        task(worker);
+        task = Task();
+    }
+}
+
+void WorkStealingPool::run() {
+    vector<thread> threads;
+    for (int w = 1; w < workers(); ++w) threads.push_back(thread(&WorkStealingPool::work, this, w));
+    work(0);
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+}
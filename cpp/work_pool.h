@@ -0,0 +1,43 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+
+// 工作窃取线程池（用于批量求解算例，任务粒度为整个算例）
+// 每个工作线程有自己的双端队列：从队首取自己的任务，自己的队列空了就从其它线程的队尾窃取。
+// 任务先全部 submit（按提交顺序轮流分到各队列），再调用 run() 直到全部完成；
+// 按耗时从大到小提交时，各线程先处理大任务，小任务在末尾被空闲线程窃取以平衡负载。
+class WorkStealingPool {
+public:
+    typedef std::function<void(int worker)> Task;
+
+    explicit WorkStealingPool(int workers);
+
+    void submit(const Task& task);
+    // 启动 workers 个线程（调用线程作为 0 号）执行所有已提交的任务，全部完成后返回
+    void run();
+
+    int workers() const { return static_cast<int>(queues_.size()); }
+    long steals() const { return steals_; }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    bool popOwn(int worker, Task& task);
+    bool steal(int worker, Task& task);
+    void work(int worker);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    size_t next_ = 0;
+    std::atomic<long> steals_;
+};
+
+#endif // WORK_POOL_H
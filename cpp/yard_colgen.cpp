@@ -0,0 +1,196 @@
+#include "yard_colgen.h"
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+using namespace std;
+
+double yardBlockCost(const ModelParams& params, int s, int k, int b, int r, int j) {
+    const int n = params.requiredSlots[s][k];
+    const double w = params.cargoWeight[s] / (static_cast<double>(n) * params.numShipK);
+    const param_t* d = params.transshipmentCost.row(b, r);
+    double trans = 0.0;
+    for (int v = j; v < j + n; ++v) trans += d[v];
+    return params.alpha * (w * trans + n * params.storageCost(s,k,r));
+}
+
+vector<PricedColumn> priceCompartment(const ModelParams& params, int s, int k, int b, double sigma,
+                                      const vector<double>& mu, int maxCols, double tol) {
+    vector<PricedColumn> best;
+    const int n = params.requiredSlots[s][k];
+    const int V = params.numSlotsPerRow;
+    if (n <= 0 || n > V) return best;
+    const double w = params.cargoWeight[s] / (static_cast<double>(n) * params.numShipK);
+    for (int r = 0; r < params.numRows; ++r) {
+        // 滑动窗口：sumD = sum_{v=j}^{j+n-1} d_brv，sumMu 同理
+        const param_t* d = params.transshipmentCost.row(b, r);
+        const double* m = &mu[static_cast<size_t>(r) * V];
+        double sumD = 0.0, sumMu = 0.0;
+        for (int v = 0; v < n; ++v) { sumD += d[v]; sumMu += m[v]; }
+        const double storage = n * params.storageCost(s,k,r);
+        PricedColumn rowBest = { r, -1, -tol };
+        for (int j = 0; ; ++j) {
+            double rc = params.alpha * (w * sumD + storage) - sigma - sumMu;
+            if (rc < rowBest.reducedCost) { rowBest.start = j; rowBest.reducedCost = rc; }
+            if (j + n >= V) break;
+            sumD += d[j + n] - d[j];
+            sumMu += m[j + n] - m[j];
+        }
+        if (rowBest.start >= 0) best.push_back(rowBest);
+    }
+    sort(best.begin(), best.end(), [](const PricedColumn& a, const PricedColumn& c) {
+        return a.reducedCost < c.reducedCost;
+    });
+    if (static_cast<int>(best.size()) > maxCols) best.resize(maxCols);
+    return best;
+}
+
+vector<vector<int>> defaultBerthScenarios(const ModelParams& params) {
+    vector<vector<int>> scenarios;
+    for (int b = 0; b < params.numBerths; ++b) scenarios.push_back(vector<int>(params.numShips, b));
+    return scenarios;
+}
+
+// 单个泊位情景的列生成，返回收敛时的 LP 目标值（失败返回 false）
+static bool runScenario(IloEnv env, const ModelParams& params, const vector<int>& berth,
+                        const YardColGenOptions& opts, int threads, YardColumnPool& pool,
+                        int& iterations, double& lpBound) {
+    const int S = params.numShips, K = params.numShipK, R = params.numRows, V = params.numSlotsPerRow;
+    IloModel master(env);
+    IloObjective obj = IloMinimize(env);
+    master.add(obj);
+    IloRangeArray assign(env);
+    IloRangeArray cover(env);
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < K; ++k) {
+            // n_sk <= 0 的货舱不占用堆场，对应行固定为 0
+            double rhs = params.requiredSlots[s][k] > 0 ? 1.0 : 0.0;
+            assign.add(IloRange(env, rhs, rhs));
+        }
+    }
+    for (int i = 0; i < R * V; ++i) cover.add(IloRange(env, -IloInfinity, 1.0));
+    master.add(assign);
+    master.add(cover);
+
+    // 人工变量保证限制主问题始终可行，bigM 大于任何实际列的成本
+    double maxCost = 0.0;
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < K; ++k) {
+            int n = params.requiredSlots[s][k];
+            if (n <= 0 || n > V) continue;
+            double w = params.cargoWeight[s] / (static_cast<double>(n) * params.numShipK);
+            for (int r = 0; r < R; ++r) {
+                const param_t* d = params.transshipmentCost.row(berth[s], r);
+                double dmax = *max_element(d, d + V);
+                maxCost = max(maxCost, params.alpha * n * (w * dmax + params.storageCost(s,k,r)));
+            }
+        }
+    }
+    const double bigM = 1e3 * (maxCost + 1.0);
+    for (int i = 0; i < S * K; ++i) {
+        IloNumColumn col = obj(bigM) + assign[i](1.0);
+        IloNumVar a(col, 0, IloInfinity);
+        col.end();
+    }
+
+    auto addColumn = [&](int s, int k, int r, int j) {
+        IloNumColumn col = obj(yardBlockCost(params, s, k, berth[s], r, j)) + assign[s * K + k](1.0);
+        for (int v = j; v < j + params.requiredSlots[s][k]; ++v) col += cover[r * V + v](1.0);
+        IloNumVar lambda(col, 0, IloInfinity);
+        col.end();
+    };
+
+    // 列池中已有的列（来自之前的情景）按当前情景的成本加入；没有列的货舱用零对偶定价出初始列
+    vector<double> zeroMu(static_cast<size_t>(R) * V, 0.0);
+    for (int s = 0; s < S; ++s) {
+        for (int k = 0; k < K; ++k) {
+            for (size_t c = 0; c < pool.cols[s][k].size(); ++c) addColumn(s, k, pool.cols[s][k][c].first, pool.cols[s][k][c].second);
+            vector<PricedColumn> init = priceCompartment(params, s, k, berth[s], 0.0, zeroMu,
+                                                         opts.columnsPerPricing, -numeric_limits<double>::infinity());
+            for (size_t c = 0; c < init.size(); ++c) {
+                if (pool.add(s, k, init[c].r, init[c].start)) addColumn(s, k, init[c].r, init[c].start);
+            }
+        }
+    }
+
+    IloCplex cplex(master);
+    cplex.setOut(env.getNullStream());
+    IloNumArray sigma(env), muArr(env);
+    vector<double> sigmaVec(S * K), mu(static_cast<size_t>(R) * V);
+    vector<vector<PricedColumn>> found(S * K);
+    bool ok = true;
+    for (int it = 0; it < opts.maxIterations; ++it) {
+        if (!cplex.solve()) {
+            cerr << "[CG] 限制主问题求解失败: " << cplex.getStatus() << endl;
+            ok = false;
+            break;
+        }
+        ++iterations;
+        lpBound = cplex.getObjValue();
+        cplex.getDuals(sigma, assign);
+        cplex.getDuals(muArr, cover);
+        for (int i = 0; i < S * K; ++i) sigmaVec[i] = sigma[i];
+        for (int i = 0; i < R * V; ++i) mu[i] = muArr[i];
+
+        // 按 (s,k) 并行定价：原子计数器动态分配货舱，结果写入各自的槽位，无需加锁
+        atomic<int> next(0);
+        auto worker = [&]() {
+            for (int i = next++; i < S * K; i = next++) {
+                found[i] = priceCompartment(params, i / K, i % K, berth[i / K], sigmaVec[i], mu,
+                                            opts.columnsPerPricing, opts.tolerance);
+            }
+        };
+        vector<thread> workers;
+        for (int t = 1; t < threads; ++t) workers.push_back(thread(worker));
+        worker();
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+        // Concert 对象不是线程安全的，新列在主线程中串行加入
+        int added = 0;
+        for (int i = 0; i < S * K; ++i) {
+            for (size_t c = 0; c < found[i].size(); ++c) {
+                int s = i / K, k = i % K;
+                if (pool.add(s, k, found[i][c].r, found[i][c].start)) {
+                    addColumn(s, k, found[i][c].r, found[i][c].start);
+                    ++added;
+                }
+            }
+        }
+        if (added == 0) break;
+    }
+    cplex.end();
+    master.end();
+    return ok;
+}
+
+bool generateYardColumns(IloEnv env, const ModelParams& params, const vector<vector<int>>& scenarios,
+                         const YardColGenOptions& opts, YardColumnPool& pool, YardColGenReport* report) {
+    auto t0 = chrono::steady_clock::now();
+    if (pool.cols.size() != static_cast<size_t>(params.numShips)) pool.init(params);
+    int threads = opts.threads > 0 ? opts.threads : static_cast<int>(thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+
+    YardColGenReport rep;
+    bool ok = true;
+    for (size_t i = 0; i < scenarios.size() && ok; ++i) {
+        double bound = 0.0;
+        ok = runScenario(env, params, scenarios[i], opts, threads, pool, rep.iterations, bound);
+        rep.lpBound.push_back(bound);
+        ++rep.scenarios;
+    }
+    rep.columns = pool.size();
+    for (int s = 0; s < params.numShips; ++s) {
+        for (int k = 0; k < params.numShipK; ++k) {
+            int n = params.requiredSlots[s][k];
+            if (n > 0 && n <= params.numSlotsPerRow) rep.fullColumns += static_cast<size_t>(params.numRows) * (params.numSlotsPerRow - n + 1);
+        }
+    }
+    rep.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "[CG] 情景 " << rep.scenarios << " 个, 迭代 " << rep.iterations << " 次, 列池 " << rep.columns
+         << " / 完整起点形式 " << rep.fullColumns << " 列, 耗时 " << rep.seconds << " s" << endl;
+    if (report) *report = rep;
+    return ok;
+}
@@ -0,0 +1,60 @@
+#ifndef YARD_COLGEN_H
+#define YARD_COLGEN_H
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "modelParam.h"
+#include "yard_pool.h"
+
+// 堆场分配的列生成：列 = 货舱 (s,k) 的一个放置 (行 r, 起点 j)，占用 [j, j+n_sk)
+//
+// 限制主问题（LP）：
+//   min  sum c_skrj * lambda_skrj + bigM * sum a_sk
+//   s.t. sum_{r,j} lambda_skrj + a_sk = 1                       (每个货舱，对偶 sigma_sk)
+//        sum_{s,k} sum_{j <= v < j+n_sk} lambda_skrj <= 1       (每个槽 (r,v)，对偶 mu_rv <= 0)
+// 定价：约化成本 c_skrj - sigma_sk - sum_{v=j}^{j+n_sk-1} mu_rv < 0 的放置加入列池，
+// 各货舱的定价相互独立，按 (s,k) 并行。块成本依赖泊位，因此对若干泊位情景分别做列生成，
+// 得到的列池再交给完整模型（YardColumns，见 port_model.h）在列池上求解 MIP（price-and-branch）。
+
+struct YardColGenOptions {
+    int threads = 0;            // 定价线程数，0 表示 hardware_concurrency
+    int maxIterations = 200;    // 每个泊位情景的最大迭代次数
+    int columnsPerPricing = 3;  // 每个货舱每轮最多加入的列数（取自不同的行）
+    double tolerance = 1e-6;    // 约化成本阈值
+};
+
+struct YardColGenReport {
+    int scenarios = 0;
+    int iterations = 0;
+    size_t columns = 0;         // 列池大小
+    size_t fullColumns = 0;     // 完整起点形式的放置变量数 sum_{s,k} R * (V - n_sk + 1)
+    double seconds = 0.0;
+    std::vector<double> lpBound;  // 每个情景收敛时的主问题 LP 目标值
+};
+
+struct PricedColumn {
+    int r;
+    int start;
+    double reducedCost;
+};
+
+// 船舶 s 停靠泊位 b 时放置 (s,k,r,j) 的目标系数：alpha * (w_sk * sum_{v=j}^{j+n_sk-1} d_brv + n_sk * phi_skr)
+double yardBlockCost(const ModelParams& params, int s, int k, int b, int r, int j);
+
+// 定价（不依赖 CPLEX，可并发调用）：泊位 b、对偶 sigma 与每槽对偶 mu[r*V+v] 下，
+// 返回约化成本 < -tol 的放置，每行至多一个，按约化成本升序，至多 maxCols 个
+// （tol 取 -inf、对偶取 0 时即每行成本最低的放置，用作初始列）
+std::vector<PricedColumn> priceCompartment(const ModelParams& params, int s, int k, int b, double sigma,
+                                           const std::vector<double>& mu, int maxCols, double tol);
+
+// 默认泊位情景：所有船都停靠泊位 b（b = 0..B-1），使列池覆盖每个泊位下的低成本放置
+std::vector<std::vector<int>> defaultBerthScenarios(const ModelParams& params);
+
+// 对每个泊位情景 scenarios[i][s] 做列生成，新列追加到 pool（pool 为空时先 init）
+// 主问题 LP 求解失败时返回 false
+bool generateYardColumns(IloEnv env, const ModelParams& params, const std::vector<std::vector<int>>& scenarios,
+                         const YardColGenOptions& opts, YardColumnPool& pool, YardColGenReport* report = 0);
+
+#endif // YARD_COLGEN_H
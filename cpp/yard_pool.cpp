@@ -0,0 +1,30 @@
+#include "yard_pool.h"
+
+using namespace std;
+
+void YardColumnPool::init(const ModelParams& params) {
+    const int S = params.numShips, K = params.numShipK, R = params.numRows, V = params.numSlotsPerRow;
+    numSlotsPerRow = V;
+    cols.assign(S, vector<vector<pair<int,int>>>(K));
+    has.assign(S, vector<vector<char>>(K, vector<char>(static_cast<size_t>(R) * V, 0)));
+}
+
+bool YardColumnPool::add(int s, int k, int r, int j) {
+    char& flag = has[s][k][static_cast<size_t>(r) * numSlotsPerRow + j];
+    if (flag) return false;
+    flag = 1;
+    cols[s][k].push_back(make_pair(r, j));
+    return true;
+}
+
+bool YardColumnPool::contains(int s, int k, int r, int j) const {
+    return has[s][k][static_cast<size_t>(r) * numSlotsPerRow + j] != 0;
+}
+
+size_t YardColumnPool::size() const {
+    size_t n = 0;
+    for (size_t s = 0; s < cols.size(); ++s) {
+        for (size_t k = 0; k < cols[s].size(); ++k) n += cols[s][k].size();
+    }
+    return n;
+}
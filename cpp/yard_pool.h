@@ -0,0 +1,23 @@
+#ifndef YARD_POOL_H
+#define YARD_POOL_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "modelParam.h"
+
+// 列池：每个货舱已生成的放置（列生成见 yard_colgen.h；不依赖 CPLEX，供 port_ir.h 的稀疏模型使用）
+struct YardColumnPool {
+    std::vector<std::vector<std::vector<std::pair<int,int>>>> cols;   // [s][k] -> (r, j)，按生成顺序
+    std::vector<std::vector<std::vector<char>>> has;                   // [s][k][r*V + j]，去重用
+
+    void init(const ModelParams& params);
+    bool add(int s, int k, int r, int j);          // 已存在时返回 false
+    bool contains(int s, int k, int r, int j) const;
+    size_t size() const;
+
+private:
+    int numSlotsPerRow = 0;
+};
+
+#endif // YARD_POOL_H